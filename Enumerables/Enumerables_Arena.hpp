@@ -0,0 +1,192 @@
+#ifndef ENUMERABLES_ARENA_HPP
+#define ENUMERABLES_ARENA_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the memory arena queries can attach by WithArena():						  *
+	 *		- Arena:			monotonic allocator of growing blocks, freed at once				  *
+	 *		- ArenaAllocator:	standard allocator over an Arena - or the heap without one			  *
+	 *																								  *
+	 *  Included by Enumerables_Enumerators.hpp - not to be used directly.							  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	using std::size_t;
+
+
+	/// Monotonic memory resource: hands out consecutive pieces of its blocks, deallocation is a no-op.
+	/// All memory is freed at once by Release() or destruction.
+	/// @remarks
+	///		Blocks start at ENUMERABLES_ARENA_BLOCK bytes (or after a buffer supplied by the owner) and double in size.
+	///		Not thread-safe: meant for the queries of a single thread, e.g. of one request.
+	class Arena {
+		struct Block {
+			Block*	previous;
+			size_t	size;			// including this header - keeps payload aligned as by operator new
+		};
+
+		Block*	blocks		= nullptr;
+		char*	cursor		= nullptr;
+		char*	end			= nullptr;
+		char*	buffer		= nullptr;		// owned by the client
+		size_t	bufferSize	= 0;
+		size_t	nextSize;
+
+
+		void	Grow(size_t bytes, size_t alignment)
+		{
+			const size_t required = sizeof(Block) + bytes + alignment;
+			while (nextSize < required)
+				nextSize *= 2;
+
+			Block* block = static_cast<Block*>(::operator new(nextSize));
+			block->previous = blocks;
+			block->size		= nextSize;
+			blocks			= block;
+
+			cursor	  = reinterpret_cast<char*>(block + 1);
+			end		  = reinterpret_cast<char*>(block) + nextSize;
+			nextSize *= 2;
+		}
+
+		static char*	AlignUp(char* p, size_t alignment)
+		{
+			const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+			return p + ((alignment - address % alignment) % alignment);
+		}
+
+	public:
+		explicit Arena(size_t firstBlock = ENUMERABLES_ARENA_BLOCK) : nextSize { firstBlock > 0 ? firstBlock : 1 }
+		{
+		}
+
+		/// Serve from @p buffer first, e.g. a stack array. It is not freed by the Arena.
+		Arena(void* buffer, size_t size, size_t nextBlock = ENUMERABLES_ARENA_BLOCK) :
+			cursor		{ static_cast<char*>(buffer) },
+			end			{ static_cast<char*>(buffer) + size },
+			buffer		{ static_cast<char*>(buffer) },
+			bufferSize	{ size },
+			nextSize	{ nextBlock > 0 ? nextBlock : 1 }
+		{
+		}
+
+		Arena(const Arena&)				= delete;
+		Arena& operator =(const Arena&)	= delete;
+
+		~Arena()
+		{
+			Release();
+		}
+
+
+		void*	Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+		{
+			char* first = AlignUp(cursor, alignment);
+			if (cursor == nullptr || bytes > static_cast<size_t>(end - cursor) || first > end - bytes) {
+				Grow(bytes, alignment);
+				first = AlignUp(cursor, alignment);
+			}
+			cursor = first + bytes;
+			return first;
+		}
+
+
+		/// Free all blocks at once - memory handed out so far must not be used anymore.
+		void	Release()
+		{
+			while (blocks != nullptr) {
+				Block* previous = blocks->previous;
+				::operator delete(blocks);
+				blocks = previous;
+			}
+			cursor = buffer;
+			end	   = buffer + bufferSize;
+		}
+
+
+		/// Number of blocks allocated from the heap since construction or Release().
+		size_t	BlockCount() const
+		{
+			size_t n = 0;
+			for (const Block* b = blocks; b != nullptr; b = b->previous)
+				++n;
+
+			return n;
+		}
+	};
+
+
+
+	/// Standard allocator serving from an Arena, or from the heap if constructed without one.
+	/// @remarks	Copies of containers get the Arena too - they must not outlive it either.
+	template <class T>
+	class ArenaAllocator {
+		template <class>	friend class ArenaAllocator;
+
+		Arena*	arena = nullptr;
+
+	public:
+		using value_type = T;
+
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap			 = std::true_type;
+
+
+		ArenaAllocator() noexcept = default;
+
+		explicit ArenaAllocator(Arena* arena) noexcept : arena { arena }
+		{
+		}
+
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U>& src) noexcept : arena { src.arena }
+		{
+		}
+
+
+		Arena*	GetArena() const	{ return arena; }
+
+
+		T*		allocate(size_t n)
+		{
+			if (arena == nullptr)
+				return std::allocator<T>().allocate(n);
+
+			return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void	deallocate(T* p, size_t n) noexcept
+		{
+			if (arena == nullptr)
+				std::allocator<T>().deallocate(p, n);
+		}
+
+
+		template <class U>
+		bool	operator ==(const ArenaAllocator<U>& rhs) const	noexcept	{ return arena == rhs.arena; }
+		template <class U>
+		bool	operator !=(const ArenaAllocator<U>& rhs) const	noexcept	{ return arena != rhs.arena; }
+	};
+
+
+}	// namespace Def
+
+
+using Def::Arena;
+using Def::ArenaAllocator;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_ARENA_HPP
@@ -38,6 +38,7 @@
 
 
 #include "Enumerables_TypeHelperBasics.hpp"
+#include "Enumerables_SmallVector.hpp"
 
 
 namespace Enumerables {
@@ -163,6 +164,77 @@ namespace Enumerables {
 #endif
 
 
+// Let terminal operations (like Sum) of contiguous arithmetic sources run vectorized kernels
+// - instruction set is chosen at runtime: AVX2 or SSE2 on x86, NEON on ARM64
+// - scalar loops are used when disabled, or on other architectures
+#ifndef ENUMERABLES_USE_SIMD
+#	define ENUMERABLES_USE_SIMD						true
+#endif
+
+
+// Number of rows Vectorized() queries pass through their stages at once
+// - selection vectors index rows by 16 bits, so at most 65536
+// - each Where stage keeps a selection, each computing Select a column of this length
+#ifndef ENUMERABLES_VECTORIZED_BLOCK
+#	define ENUMERABLES_VECTORIZED_BLOCK				1024
+#endif
+
+
+// Size in bytes of the first heap block an Arena allocates (each further one doubles)
+// - applies to caches of queries marked by WithArena(arena), such as the buffer of Order()
+// - an Arena constructed over a client buffer starts allocating from the heap only once that is exhausted
+#ifndef ENUMERABLES_ARENA_BLOCK
+#	define ENUMERABLES_ARENA_BLOCK					4096
+#endif
+
+
+// Number of elements up to which an AdaptiveMap keeps them sorted in an array, instead of hashing
+// - applies to dictionaries of FlatBinding::AutoDictionaryOperations, chosen by reserved capacity first
+// - binary search over a few cache lines usually beats hashing for small keys
+#ifndef ENUMERABLES_SORTED_DICTIONARY_MAX
+#	define ENUMERABLES_SORTED_DICTIONARY_MAX		128
+#endif
+
+
+// Size in bytes from which HugePageAllocator aligns blocks to 2 MB huge pages, smaller ones come from std::allocator
+// - large blocks get rounded up to whole huge pages: wasting less than 1/8 above the default
+#ifndef ENUMERABLES_HUGEPAGE_THRESHOLD
+#	define ENUMERABLES_HUGEPAGE_THRESHOLD			(size_t(16) << 20)
+#endif
+
+
+// Upper limit of threads evaluating a single AsParallel() query
+// - 0 means no limit
+// - by default queries use all threads of their executor, unless set by WithDegreeOfParallelism(n)
+// - also limits the background workers of DefaultExecutor(), sized by std::thread::hardware_concurrency() otherwise
+#ifndef ENUMERABLES_PARALLEL_MAX_WORKERS
+#	define ENUMERABLES_PARALLEL_MAX_WORKERS			0
+#endif
+
+
+// Minimal number of source elements worth a separate chunk (thus a task) in AsParallel() queries
+// - chunks get split recursively down to this size while the executor has idle workers
+// - shorter inputs are evaluated on the calling thread
+#ifndef ENUMERABLES_PARALLEL_MIN_CHUNK
+#	define ENUMERABLES_PARALLEL_MIN_CHUNK			2048
+#endif
+
+
+// Number of source elements summed sequentially by floating-point Sum/Avg of AsParallel() queries,
+// before merging the blocks in a fixed tree
+// - results are reproducible across machines only when built with the same value
+#ifndef ENUMERABLES_PARALLEL_SUM_BLOCK
+#	define ENUMERABLES_PARALLEL_SUM_BLOCK			1024
+#endif
+
+
+// Number of elements a task of FlattenParallel() enumerates from a nested sequence before yielding its thread
+// - a nested sequence gets paused once 4 times as many of its elements await the consumer
+#ifndef ENUMERABLES_PARALLEL_FLATTEN_BATCH
+#	define ENUMERABLES_PARALLEL_FLATTEN_BATCH		256
+#endif
+
+
 
 
 // ==== Behavioural settings ================================================================================
@@ -195,6 +267,33 @@ namespace Enumerables {
 
 
 
+// Enable ToSharedMemoryList() of AsParallel() queries, evaluating their shards in forked worker processes.
+// - POSIX only: pulls <sys/mman.h>, <sys/wait.h> and <unistd.h>
+#ifndef ENUMERABLES_USE_MULTIPROCESS
+#	define ENUMERABLES_USE_MULTIPROCESS				false
+#endif
+
+
+// Bind std::pmr containers by default: vector, unordered_set, unordered_map and SmallVector over polymorphic_allocator
+// - kinds having an explicit ENUMERABLES_..._BINDING keep that
+// - adds ToList/ToSet/ToDictionary overloads taking a std::pmr::memory_resource* - see PmrBinding::ResourceScope
+// - requires C++17 <memory_resource>
+#ifndef ENUMERABLES_USE_PMR
+#	define ENUMERABLES_USE_PMR						false
+#endif
+
+
+// Bind std::vector over HugePageAllocator by default: list caches above ENUMERABLES_HUGEPAGE_THRESHOLD
+// get backed by transparent huge pages - e.g. the buffer of Order() or the ToList() of huge sequences
+// - lowers TLB misses of sorting and scanning caches of gigabytes
+// - Linux only advises the kernel by madvise, elsewhere allocations just get aligned
+// - an explicit ENUMERABLES_LIST_BINDING, or ENUMERABLES_USE_PMR takes precedence
+#ifndef ENUMERABLES_USE_HUGEPAGES
+#	define ENUMERABLES_USE_HUGEPAGES				false
+#endif
+
+
+
 // When using braced-init syntax Enumerate({ "apple", "banana" }) with no explicit elem type,
 // without additional support, string literals decay to pointers - eventually interpreted as
 // char& elements, according to default Enumerate rules.
@@ -225,13 +324,78 @@ namespace Enumerables {
 #	define ENUMERATIONS_EXCEPTION_TYPE   std::logic_error
 #endif
 
+#if ENUMERABLES_USE_PMR
+#	include <memory_resource>
+#endif
+
+#include "Enumerables_FlatHash.hpp"
+#include "Enumerables_SortedFlatMap.hpp"
+#if ENUMERABLES_USE_HUGEPAGES
+#	include "Enumerables_HugePages.hpp"
+#endif
+
 
 
 namespace Enumerables {
 
 
+#if ENUMERABLES_USE_PMR
+
+	namespace PmrBinding {
+
+		inline std::pmr::memory_resource*&	ScopedResource()
+		{
+			thread_local std::pmr::memory_resource* resource = nullptr;
+			return resource;
+		}
+
+		/// Resource for containers created without an explicit allocator: the innermost ResourceScope's on this thread, or the default.
+		inline std::pmr::memory_resource*	CurrentResource()
+		{
+			std::pmr::memory_resource* scoped = ScopedResource();
+			return scoped != nullptr ? scoped : std::pmr::get_default_resource();
+		}
+
+		/// Containers created by the bindings on this thread (results and internal caches alike) allocate from @p resource
+		/// during the lifetime of this object - unless given an explicit allocator.
+		/// @remarks	Used by ToList(resource) and the like, which thus let caches (e.g. of Order) pass as results without copy.
+		class ResourceScope {
+			std::pmr::memory_resource* const	previous;
+
+		public:
+			explicit ResourceScope(std::pmr::memory_resource* resource) : previous { ScopedResource() }
+			{
+				ScopedResource() = resource;
+			}
+
+			~ResourceScope()
+			{
+				ScopedResource() = previous;
+			}
+
+			ResourceScope(const ResourceScope&)				= delete;
+			ResourceScope& operator =(const ResourceScope&)	= delete;
+		};
+
+
+		template <class TContainer, class A = typename TContainer::allocator_type>
+		std::enable_if_t< std::is_constructible<A, std::pmr::memory_resource*>::value, A>	ScopedAllocator()	{ return A { CurrentResource() }; }
+
+		template <class TContainer, class A = typename TContainer::allocator_type>
+		std::enable_if_t<!std::is_constructible<A, std::pmr::memory_resource*>::value, A>	ScopedAllocator()	{ return A {}; }
+	}
+
+#endif
+
+
 #ifndef ENUMERABLES_LIST_BINDING
-#define ENUMERABLES_LIST_BINDING  StlBinding::ListOperations
+#	if ENUMERABLES_USE_PMR
+#		define ENUMERABLES_LIST_BINDING  PmrBinding::ListOperations
+#	elif ENUMERABLES_USE_HUGEPAGES
+#		define ENUMERABLES_LIST_BINDING  HugePageBinding::ListOperations
+#	else
+#		define ENUMERABLES_LIST_BINDING  StlBinding::ListOperations
+#	endif
 
 	namespace StlBinding {
 
@@ -259,6 +423,10 @@ namespace Enumerables {
 			template <class V, class... Opts, class Vin>
 			static void		Add(Container<V, Opts...>& l, Vin&& val)	{ l.push_back(std::forward<Vin>(val)); }
 
+			/// Optional: append a range at once - e.g. survivors of vectorized filters.
+			template <class V, class... Opts, class It>
+			static void		AddRange(Container<V, Opts...>& l, It first, It last)	{ l.insert(l.end(), first, last); }
+
 			template <class V, class... Opts>
 			static void		Clear(Container<V, Opts...>& l)				{ l.clear();	/* keep capacity! */   }
 
@@ -307,6 +475,9 @@ namespace Enumerables {
 			template <class V, class... Opts, class Vin>
 			static void		Add(DeducibleContainer<V, Opts...>& l, Vin&& val)	{ l.push_back(std::forward<Vin>(val)); }
 
+			template <class V, class... Opts, class It>
+			static void		AddRange(DeducibleContainer<V, Opts...>& l, It first, It last)	{ l.insert(l.end(), first, last); }
+
 			template <class V, class... Opts>
 			static void		Clear(DeducibleContainer<V, Opts...>& l)			{ l.clear();	/* keep capacity! */   }
 
@@ -317,6 +488,50 @@ namespace Enumerables {
 
 	}	// namespace StlBinding
 
+#	if ENUMERABLES_USE_PMR
+	namespace PmrBinding {
+		struct ListOperations : StlBinding::ListOperations {
+
+			template <class V, class... Options>
+			struct BindHelper		{ using type = std::vector<V, Options...>; };
+			template <class V>
+			struct BindHelper<V>	{ using type = std::pmr::vector<V>; };
+
+			template <class V, class... Options>
+			using Container = typename BindHelper<V, Options...>::type;
+
+
+			/// Allocate from the scoped memory resource, unless an allocator is given.
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				return StlBinding::ListOperations::Init<TContainer>(capacity, options...);
+			}
+
+			template <class TContainer>
+			static TContainer	Init(size_t capacity)
+			{
+				return StlBinding::ListOperations::Init<TContainer>(capacity, ScopedAllocator<TContainer>());
+			}
+		};
+	}
+#	endif
+
+#	if ENUMERABLES_USE_HUGEPAGES
+	namespace HugePageBinding {
+		struct ListOperations : StlBinding::ListOperations {
+
+			template <class V, class... Options>
+			struct BindHelper		{ using type = std::vector<V, Options...>; };
+			template <class V>
+			struct BindHelper<V>	{ using type = std::vector<V, HugePageAllocator<V>>; };
+
+			template <class V, class... Options>
+			using Container = typename BindHelper<V, Options...>::type;
+		};
+	}
+#	endif
+
 	/// Size of a ListOperations::Container.
 	/// Each bound type is required to have an Enumerables::GetSize overload.
 	template <class... Args>
@@ -327,7 +542,11 @@ namespace Enumerables {
 
 
 #ifndef ENUMERABLES_SET_BINDING
-#define ENUMERABLES_SET_BINDING   StlBinding::SetOperations
+#	if ENUMERABLES_USE_PMR
+#		define ENUMERABLES_SET_BINDING   PmrBinding::SetOperations
+#	else
+#		define ENUMERABLES_SET_BINDING   StlBinding::SetOperations
+#	endif
 
 	namespace StlBinding {
 		struct SetOperations {
@@ -355,6 +574,39 @@ namespace Enumerables {
 		};
 	}
 
+#	if ENUMERABLES_USE_PMR
+	namespace PmrBinding {
+		struct SetOperations : StlBinding::SetOperations {
+
+			// pmr aliases fix the allocator, a given one (at AllocatorOptionIdx) replaces them
+			template <class V, class... Options>
+			struct BindHelper				{ using type = std::unordered_set<V, Options...>; };
+			template <class V>
+			struct BindHelper<V>			{ using type = std::pmr::unordered_set<V>; };
+			template <class V, class H>
+			struct BindHelper<V, H>			{ using type = std::pmr::unordered_set<V, H>; };
+			template <class V, class H, class E>
+			struct BindHelper<V, H, E>		{ using type = std::pmr::unordered_set<V, H, E>; };
+
+			template <class V, class... Options>
+			using Container = typename BindHelper<V, Options...>::type;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				return StlBinding::SetOperations::Init<TContainer>(capacity, options...);
+			}
+
+			template <class TContainer>
+			static TContainer	Init(size_t capacity)
+			{
+				return StlBinding::SetOperations::Init<TContainer>(capacity, ScopedAllocator<TContainer>());
+			}
+		};
+	}
+#	endif
+
 	template <class... Args>
 	size_t GetSize(const std::unordered_set<Args...>& s)  { return s.size(); }
 
@@ -363,7 +615,11 @@ namespace Enumerables {
 
 
 #ifndef ENUMERABLES_DICTIONARY_BINDING
-#define ENUMERABLES_DICTIONARY_BINDING	StlBinding::DictionaryOperations
+#	if ENUMERABLES_USE_PMR
+#		define ENUMERABLES_DICTIONARY_BINDING	PmrBinding::DictionaryOperations
+#	else
+#		define ENUMERABLES_DICTIONARY_BINDING	StlBinding::DictionaryOperations
+#	endif
 
 	namespace StlBinding {
 		struct DictionaryOperations {
@@ -397,8 +653,44 @@ namespace Enumerables {
 
 			template <class K, class V, class... Opts>
 			static V&		Access(Container<K, V, Opts...>& d, const K& key)			{ return d[key]; }
+
+			/// Const lookup of an existing entry - nullptr if not found.
+			template <class K, class V, class... Opts>
+			static const V*	Find(const Container<K, V, Opts...>& d, const K& key)		{ auto it = d.find(key); return it != d.end() ? &it->second : nullptr; }
+		};
+	}
+
+#	if ENUMERABLES_USE_PMR
+	namespace PmrBinding {
+		struct DictionaryOperations : StlBinding::DictionaryOperations {
+
+			template <class K, class V, class... Options>
+			struct BindHelper				{ using type = std::unordered_map<K, V, Options...>; };
+			template <class K, class V>
+			struct BindHelper<K, V>			{ using type = std::pmr::unordered_map<K, V>; };
+			template <class K, class V, class H>
+			struct BindHelper<K, V, H>		{ using type = std::pmr::unordered_map<K, V, H>; };
+			template <class K, class V, class H, class E>
+			struct BindHelper<K, V, H, E>	{ using type = std::pmr::unordered_map<K, V, H, E>; };
+
+			template <class K, class V, class... Options>
+			using Container = typename BindHelper<K, V, Options...>::type;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				return StlBinding::DictionaryOperations::Init<TContainer>(capacity, options...);
+			}
+
+			template <class TContainer>
+			static TContainer	Init(size_t capacity)
+			{
+				return StlBinding::DictionaryOperations::Init<TContainer>(capacity, ScopedAllocator<TContainer>());
+			}
 		};
 	}
+#	endif
 
 	template <class... Args>
 	size_t GetSize(const std::unordered_map<Args...>& d)  { return d.size(); }
@@ -407,6 +699,178 @@ namespace Enumerables {
 
 
 
+	// Open-addressing alternatives of the node-based STL containers - for set-filter or lookup heavy usage:
+	//	#define ENUMERABLES_SET_BINDING			Enumerables::FlatBinding::SetOperations
+	//	#define ENUMERABLES_DICTIONARY_BINDING	Enumerables::FlatBinding::DictionaryOperations
+	namespace FlatBinding {
+		struct SetOperations {
+
+			// NOTE: same clang workaround as of ListOperations - Options... would expand into non-pack params
+			template <class V, class... Options>
+			struct BindHelper  { using type = FlatHashSet<V, Options...>; };
+
+			template <class V, class... Options>
+			using Container = typename BindHelper<V, Options...>::type;
+
+			static constexpr unsigned AllocatorOptionIdx = 2;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				TContainer set (0u, options...);
+				set.reserve(capacity);
+				return set;
+			}
+
+
+			template <class V, class H, class E, class A>
+			static bool			Contains(const FlatHashSet<V, H, E, A>& s, const V& elem)	{ return s.contains(elem); }
+
+			/// Heterogeneous lookup, without converting to V - if H and E are transparent.
+			template <class V, class H, class E, class A, class K, class = decltype(std::declval<const FlatHashSet<V, H, E, A>&>().contains(std::declval<const K&>()))>
+			static bool			Contains(const FlatHashSet<V, H, E, A>& s, const K& key)	{ return s.contains(key); }
+
+			template <class V, class H, class E, class A, class Vin>
+			static void			Add(FlatHashSet<V, H, E, A>& s, Vin&& elem)				{ s.insert(std::forward<Vin>(elem)); }
+		};
+
+
+		struct DictionaryOperations {
+
+			template <class K, class V, class... Options>
+			struct BindHelper  { using type = FlatHashMap<K, V, Options...>; };
+
+			template <class K, class V, class... Options>
+			using Container = typename BindHelper<K, V, Options...>::type;
+
+			static constexpr unsigned AllocatorOptionIdx = 2;
+
+			template <class K, class V, class... Options>
+			using AllocatedValueT = std::pair<const K, V>;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				TContainer dict (0u, options...);
+				dict.reserve(capacity);
+				return dict;
+			}
+
+
+			template <class K, class V, class H, class E, class A>
+			static bool		Contains(const FlatHashMap<K, V, H, E, A>& d, const K& key)		{ return d.contains(key); }
+
+			template <class K, class V, class H, class E, class A, class Kin, class Vin>
+			static void		Add(FlatHashMap<K, V, H, E, A>& d, Kin&& key, Vin&& val)		{ d.try_emplace(std::forward<Kin>(key), std::forward<Vin>(val)); }
+
+			template <class K, class V, class H, class E, class A>
+			static V&		Access(FlatHashMap<K, V, H, E, A>& d, const K& key)				{ return d[key]; }
+
+			template <class K, class V, class H, class E, class A>
+			static const V*	Find(const FlatHashMap<K, V, H, E, A>& d, const K& key)			{ auto it = d.find(key); return it != d.end() ? &it->second : nullptr; }
+		};
+
+
+		// Contiguous sorted dictionaries for small, read-mostly results:
+		//	#define ENUMERABLES_DICTIONARY_BINDING	Enumerables::FlatBinding::SortedDictionaryOperations
+		// Options are [Less, Allocator]. Elements get appended, then sorted at once by Finalize.
+		struct SortedDictionaryOperations {
+
+			template <class K, class V, class... Options>
+			struct BindHelper  { using type = SortedFlatMap<K, V, Options...>; };
+
+			template <class K, class V, class... Options>
+			using Container = typename BindHelper<K, V, Options...>::type;
+
+			static constexpr unsigned AllocatorOptionIdx = 1;
+
+			template <class K, class V, class... Options>
+			using AllocatedValueT = std::pair<const K, V>;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				TContainer dict (options...);
+				dict.reserve(capacity);
+				return dict;
+			}
+
+
+			template <class K, class V, class L, class A>
+			static bool		Contains(const SortedFlatMap<K, V, L, A>& d, const K& key)		{ return d.contains(key); }
+
+			template <class K, class V, class L, class A, class Kin, class Vin>
+			static void		Add(SortedFlatMap<K, V, L, A>& d, Kin&& key, Vin&& val)			{ d.append_unsorted(std::forward<Kin>(key), std::forward<Vin>(val)); }
+
+			/// Optional for dictionary bindings: called once all elements got Added.
+			template <class K, class V, class L, class A>
+			static void		Finalize(SortedFlatMap<K, V, L, A>& d)							{ d.sort_appended(); }
+
+			template <class K, class V, class L, class A>
+			static V&		Access(SortedFlatMap<K, V, L, A>& d, const K& key)				{ return d[key]; }
+
+			template <class K, class V, class L, class A>
+			static const V*	Find(const SortedFlatMap<K, V, L, A>& d, const K& key)			{ auto it = d.find(key); return it != d.end() ? &it->second : nullptr; }
+		};
+
+
+		// Sorted array up to ENUMERABLES_SORTED_DICTIONARY_MAX elements, open-addressing hash beyond:
+		//	#define ENUMERABLES_DICTIONARY_BINDING	Enumerables::FlatBinding::AutoDictionaryOperations
+		struct AutoDictionaryOperations {
+
+			template <class K, class V, class... Options>
+			struct BindHelper  { using type = AdaptiveMap<K, V, Options...>; };
+
+			template <class K, class V, class... Options>
+			using Container = typename BindHelper<K, V, Options...>::type;
+
+			static constexpr unsigned AllocatorOptionIdx = 2;
+
+			template <class K, class V, class... Options>
+			using AllocatedValueT = std::pair<const K, V>;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				return TContainer (capacity, options...);
+			}
+
+
+			template <class K, class V, class H, class E, class A>
+			static bool		Contains(const AdaptiveMap<K, V, H, E, A>& d, const K& key)		{ return d.contains(key); }
+
+			template <class K, class V, class H, class E, class A, class Kin, class Vin>
+			static void		Add(AdaptiveMap<K, V, H, E, A>& d, Kin&& key, Vin&& val)		{ d.append_unsorted(std::forward<Kin>(key), std::forward<Vin>(val)); }
+
+			template <class K, class V, class H, class E, class A>
+			static void		Finalize(AdaptiveMap<K, V, H, E, A>& d)							{ d.sort_appended(); }
+
+			template <class K, class V, class H, class E, class A>
+			static V&		Access(AdaptiveMap<K, V, H, E, A>& d, const K& key)				{ return d[key]; }
+
+			template <class K, class V, class H, class E, class A>
+			static const V*	Find(const AdaptiveMap<K, V, H, E, A>& d, const K& key)			{ auto it = d.find(key); return it != d.end() ? &it->second : nullptr; }
+		};
+	}
+
+	template <class V, class H, class E, class A>
+	size_t GetSize(const FlatHashSet<V, H, E, A>& s)  { return s.size(); }
+
+	template <class K, class V, class H, class E, class A>
+	size_t GetSize(const FlatHashMap<K, V, H, E, A>& d)  { return d.size(); }
+
+	template <class K, class V, class L, class A>
+	size_t GetSize(const SortedFlatMap<K, V, L, A>& d)  { return d.size(); }
+
+	template <class K, class V, class H, class E, class A>
+	size_t GetSize(const AdaptiveMap<K, V, H, E, A>& d)  { return d.size(); }
+
+
+
 #if defined(_MSC_VER) && defined(_OPTIONAL_) || defined(_GLIBCXX_OPTIONAL)
 
 	// Suggested way of using std::optional if OptResult is undesired.
@@ -443,14 +907,39 @@ namespace Enumerables {
 	namespace DefaultBinding {
 
 		// STL doesn't have a small_vector (one with an inline buffer for initial elements, but being able to dynamically expand if needed)
-		// - hence only a ListOperations fallback is provided, but it presents the way to utilize such a type from your favourite library.
-		struct FallbackSmallListOperations : ListOperations {
+		// - hence the library's own SmallVector is bound by default, but a type from your favourite library can be utilized the same way.
+		struct SmallVectorOperations {
 
+			// NOTE: same clang workaround as of ListOperations - Options... would expand into SmallVector's non-pack Alloc param
 			template <class V, size_t InlineCap, class... Options>
-			using Container = ListOperations::Container<V, Options...>;
+			struct BindHelper  { using type = SmallVector<V, InlineCap, Options...>; };
 
 			template <class V, size_t InlineCap, class... Options>
-			using AllocatedValueT = typename TypeHelpers::AsDependentT<ListOperations, V>::template AllocatedValueT<V, Options...>;
+			using Container = typename BindHelper<V, InlineCap, Options...>::type;
+
+			static constexpr unsigned AllocatorOptionIdx = 0;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				TContainer list (options...);
+				list.reserve(capacity);
+				return list;
+			}
+
+
+			template <class V, size_t N, class A, class Vin>
+			static void		Add(SmallVector<V, N, A>& l, Vin&& val)						{ l.push_back(std::forward<Vin>(val)); }
+
+			template <class V, size_t N, class A, class It>
+			static void		AddRange(SmallVector<V, N, A>& l, It first, It last)		{ l.insert(l.end(), first, last); }
+
+			template <class V, size_t N, class A>
+			static void		Clear(SmallVector<V, N, A>& l)								{ l.clear();	/* keep capacity! */   }
+
+			template <class V, size_t N, class A>
+			static V&		Access(SmallVector<V, N, A>& l, size_t i)					{ return l[i]; }
 		};
 
 
@@ -501,16 +990,48 @@ namespace Enumerables {
 	bool HasValue(const OptResult<T>& o)  { return o.HasValue(); }
 
 
+#if ENUMERABLES_USE_PMR
+	namespace PmrBinding {
+		struct SmallListOperations : DefaultBinding::SmallVectorOperations {
+
+			template <class V, size_t InlineCap, class... Options>
+			struct BindHelper					{ using type = SmallVector<V, InlineCap, Options...>; };
+			template <class V, size_t InlineCap>
+			struct BindHelper<V, InlineCap>		{ using type = SmallVector<V, InlineCap, std::pmr::polymorphic_allocator<V>>; };
+
+			template <class V, size_t InlineCap, class... Options>
+			using Container = typename BindHelper<V, InlineCap, Options...>::type;
+
+
+			template <class TContainer, class... Opts>
+			static TContainer	Init(size_t capacity, const Opts&... options)
+			{
+				return SmallVectorOperations::Init<TContainer>(capacity, options...);
+			}
+
+			template <class TContainer>
+			static TContainer	Init(size_t capacity)
+			{
+				return SmallVectorOperations::Init<TContainer>(capacity, ScopedAllocator<TContainer>());
+			}
+		};
+	}
+#endif
+
+
 
 #ifdef ENUMERABLES_SMALLLIST_BINDING
 	using SmallListOperations = ENUMERABLES_SMALLLIST_BINDING;
+#elif ENUMERABLES_USE_PMR
+	using SmallListOperations = PmrBinding::SmallListOperations;
 
-#	define ENUMERABLES_WARN_FOR_SMALLLIST	
+	template <class V, size_t N, class A>
+	size_t GetSize(const SmallVector<V, N, A>& l)  { return l.size(); }
 #else
-	using SmallListOperations = DefaultBinding::FallbackSmallListOperations;
+	using SmallListOperations = DefaultBinding::SmallVectorOperations;
 
-	// Fallback is needed internally, but warn for usage on interface.
-#	define ENUMERABLES_WARN_FOR_SMALLLIST	[[deprecated("No SmallList type defined, will use standard List type! Use ENUMERABLES_SMALLLIST_BINDING")]]
+	template <class V, size_t N, class A>
+	size_t GetSize(const SmallVector<V, N, A>& l)  { return l.size(); }
 #endif
 
 
@@ -8,6 +8,8 @@
 	 *  for usage with range-based for loops (thus making Enumerable an iterable).			  */
 
 
+#include "Enumerables_Arena.hpp"
+#include "Enumerables_ChainTool.hpp"
 #include "Enumerables_InterfaceTypes.hpp"
 #include "Enumerables_TypeHelpers.hpp"
 #include <algorithm>
@@ -504,6 +506,16 @@ namespace Def {
 
 
 
+	/// Vectorized alternative to enumerating Source into a container - for recognized stages.
+	/// Specializations are provided by Enumerables_Simd.hpp.
+	template <class Source, class = void>
+	struct CollectKernel {
+		template <class ContainerOps, class R, class Cont>
+		static bool	TryCollect(Source&, Cont&)	{ return false; }
+	};
+
+
+
 	/// Obtain results in the desired container type - by the least copy/conversion possible, expecting a potential CachingEnumerator as Source.
 	/// @param  hint:			for manual hints (e.g. .ToList(n))
 	/// @tparam ReqContainer:	bound container type to create or obtain
@@ -543,6 +555,9 @@ namespace Def {
 		SizeInfo si  = etor.Measure();
 		size_t   cap = (si.IsExact() && hint < si) ? si.value : hint;
 		ReqContainer res = ContainerOps::template Init<ReqContainer>(cap, args...);
+		if (CollectKernel<Source>::template TryCollect<ContainerOps, R>(etor, res))
+			return res;
+
 		while (etor.FetchNext())
 			ContainerOps::Add(res, etor.Current());
 
@@ -586,6 +601,144 @@ namespace Def {
 
 	#pragma endregion
 
+
+
+	#pragma region Arena of caches
+
+	/// Passes the elements of Source through - marks the chain whose caches allocate from an Arena (see WithArena).
+	template <class Source>
+	class ArenaEnumerator final : public IEnumerator<EnumeratedT<Source>> {
+		Source	source;
+
+	public:
+		using typename ArenaEnumerator::IEnumerator::TElem;
+
+		const Source&		Inner()			  const		{ return source; }
+
+		bool				FetchNext()		  override	{ return source.FetchNext(); }
+		TElem				Current()		  override	{ return source.Current(); }
+		SizeInfo			Measure()	const override	{ return source.Measure(); }
+		IEnumerator<TElem>*	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
+
+		template <class Factory>
+		ArenaEnumerator(Factory&& getSource, Arena*) : source { getSource() }
+		{
+		}
+
+		ArenaEnumerator(ArenaEnumerator&&) = default;
+	};
+
+
+	/// Etor is chained over an ArenaEnumerator - through the first source of each Enumerator.
+	template <class Etor>
+	struct IsArenaChain : std::false_type {};
+
+	template <class Source>
+	struct IsArenaChain<ArenaEnumerator<Source>> : std::true_type {};
+
+	template <template <class...> class Et, class Source, class... Args>
+	struct IsArenaChain<Et<Source, Args...>> : IsArenaChain<Source> {};
+
+
+	/// Arena attached by WithArena() to the chain of factories producing Etor's source - nullptr if none is found.
+	template <class Factory>
+	struct AttachedArena {
+		static Arena*	Get(const Factory&)		{ return nullptr; }
+	};
+
+	template <class SourceFactory, class TArgs, class SteadyArgs>
+	struct AttachedArena<ChainedFactory<ArenaEnumerator, SourceFactory, TArgs, SteadyArgs>> {
+		static Arena*	Get(const ChainedFactory<ArenaEnumerator, SourceFactory, TArgs, SteadyArgs>& f)	{ return std::get<0>(f.steadyCtorArgs.tuple); }
+	};
+
+	template <template <class...> class Et, class SourceFactory, class TArgs, class SteadyArgs, class... PureTypeArgs>
+	struct AttachedArena<ChainedFactory<Et, SourceFactory, TArgs, SteadyArgs, PureTypeArgs...>> {
+		static Arena*	Get(const ChainedFactory<Et, SourceFactory, TArgs, SteadyArgs, PureTypeArgs...>& f)
+		{
+			return AttachedArena<decay_t<SourceFactory>>::Get(f.sourceFactory);
+		}
+	};
+
+	template <template <class...> class Et, class SourceFactories, class TArgs, class SteadyArgs, class... PureTypeArgs>
+	struct AttachedArena<JoinerChainedFactory<Et, SourceFactories, TArgs, SteadyArgs, PureTypeArgs...>> {
+		static Arena*	Get(const JoinerChainedFactory<Et, SourceFactories, TArgs, SteadyArgs, PureTypeArgs...>& f)
+		{
+			return AttachedArena<decay_t<std::tuple_element_t<0, SourceFactories>>>::Get(std::get<0>(f.sourceFactories));
+		}
+	};
+
+
+	/// Containers for the internal caches of Enumerators over Source: bound as usual, unless Source is an ArenaEnumerator chain.
+	/// @remarks	Explicit Options are left intact, so are any allocators of the client.
+	template <class Source, bool = IsArenaChain<Source>::value>
+	class CacheArena {
+	public:
+		template <class V, class... Options>	using ListT		 = AdjustedList<V, Options...>;
+		template <class V, class... Options>	using SetT		 = AdjustedSet<V, Options...>;
+		template <class V, size_t N>			using SmallListT = SmallListType<V, N>;
+
+		template <class Factory>
+		explicit CacheArena(const Factory&)
+		{
+		}
+
+		template <class Ops, class Cont>
+		Cont	Init(size_t capacity) const			{ return Ops::template Init<Cont>(capacity); }
+
+		template <class Ops, class R, class Cont, class Etor, class... Options>
+		Cont	Obtain(Etor& etor, const Options&... opts) const
+		{
+			return ObtainCachedResults<Ops, R, Cont>(etor, 0, opts...);
+		}
+	};
+
+
+	template <class Source>
+	class CacheArena<Source, true> {
+		Arena*	arena;
+
+		template <class Cont>
+		typename Cont::allocator_type	Allocator() const	{ return typename Cont::allocator_type { arena }; }
+
+		template <class Ops, class Cont, class Alloc>
+		using WithAllocator = OverriddenNthArgT<Cont, Ops::AllocatorOptionIdx + 1, Alloc>;
+
+	public:
+		template <class V, class... Options>
+		using ListT		 = conditional_t<sizeof...(Options) == 0,
+										 WithAllocator<ListOperations, ListOperations::Container<V>, ArenaAllocator<V>>,
+										 AdjustedList<V, Options...>>;
+		template <class V, class... Options>
+		using SetT		 = conditional_t<sizeof...(Options) == 0,
+										 WithAllocator<SetOperations, SetOperations::Container<V>, ArenaAllocator<V>>,
+										 AdjustedSet<V, Options...>>;
+		template <class V, size_t N>
+		using SmallListT = SmallListType<V, N, ArenaAllocator<V>>;		// allocator is the first Option as of SmallVector
+
+
+		template <class Factory>
+		explicit CacheArena(const Factory& getSource) : arena { AttachedArena<decay_t<Factory>>::Get(getSource) }
+		{
+		}
+
+		template <class Ops, class Cont>
+		Cont	Init(size_t capacity) const			{ return Ops::template Init<Cont>(capacity, Allocator<Cont>()); }
+
+		template <class Ops, class R, class Cont, class Etor>
+		Cont	Obtain(Etor& etor) const
+		{
+			return ObtainCachedResults<Ops, R, Cont>(etor, 0, Allocator<Cont>());
+		}
+
+		template <class Ops, class R, class Cont, class Etor, class Option, class... Options>
+		Cont	Obtain(Etor& etor, const Option& opt, const Options&... opts) const
+		{
+			return ObtainCachedResults<Ops, R, Cont>(etor, 0, opt, opts...);
+		}
+	};
+
+	#pragma endregion
+
 #pragma endregion
 
 
@@ -716,6 +869,12 @@ namespace Def {
 		SizeInfo			Measure()   const override	{ return TryGetIterDistance(curr, end); }
 		IEnumerator<TElem>*	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
 
+		/// Bounds of the remaining range - e.g. to partition it for parallel evaluation.
+		const TIter&		Position()	const			{ return curr; }
+		const TIter&		End()		const			{ return end;  }
+
+		/// Step over the next n elements without fetching them. Requires random access.
+		void				Skip(size_t n)				{ curr += static_cast<typename std::iterator_traits<TIter>::difference_type>(n); }
 
 		IteratorEnumerator(const TIter& beg, const TIter& end) : curr { beg },	end { end }  {}
 		IteratorEnumerator(IteratorEnumerator&&) = default;
@@ -823,6 +982,10 @@ namespace Def {
 		SizeInfo			Measure()   const override	{ return source.Measure().Filtered(); }
 		IEnumerator<TElem>*	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
 
+		/// Parts of the stage - e.g. to recognize simple predicates over contiguous sources.
+		const Source&		Inner()		const			{ return source; }
+		const TPred&		Condition()	const			{ return pred; }
+
 		template <class Factory>
 		FilterEnumerator(Factory&& getSource, const TPred& pred) : source { getSource() }, pred { pred }  {}
 		FilterEnumerator(FilterEnumerator&&) = default;
@@ -929,17 +1092,17 @@ namespace Def {
 					   "Converting elements for comparison could lose data. If the conversion is desired, use .As<T> explicitly!");
 
 		using S	   = StorableT<CompBase>;
-		using TSet = AdjustedSet<S, SetOptions...>;
+		using TSet = typename CacheArena<Source>::template SetT<S, SetOptions...>;
 
 		Source		source;
 		TSet		operand;
 		const bool	intersect;	// == !subtract
 
 
-		static TSet   CreateOperand(OpSource&& etor, const SetOptions&... opts)
+		static TSet   CreateOperand(OpSource&& etor, const CacheArena<Source>& arena, const SetOptions&... opts)
 		{
 			// NOTE: S won't always match CalcResults' type, but getting a Set CachingEnumerator here would be quite lucky anyway
-			return ObtainCachedResults<SetOperations, S, TSet>(etor, 0, opts...);
+			return arena.template Obtain<SetOperations, S, TSet>(etor, opts...);
 		}
 
 		// NOTE: Avoids MSVC 2015 bug: expanding SetOptions... within ctor initializer-block results in C2226.
@@ -976,7 +1139,7 @@ namespace Def {
 		SetFilterEnumerator(SrcFactory&& getSource, OpFactory&& getOpSource, const SetOptions&... opts, bool intersect) :
 			source    { getSource() },
 			intersect { intersect },
-			operand   { CreateOperand(getOpSource(), opts...) }
+			operand   { CreateOperand(getOpSource(), CacheArena<Source> { getSource }, opts...) }
 		{
 		}
 
@@ -1176,6 +1339,11 @@ namespace Def {
 		SizeInfo			Measure()   const override	{ return source.Measure(); }
 		IEnumerator<TElem>*	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
 
+		/// Parts of the stage - e.g. to recognize field projections of contiguous sources.
+		const Source&		Inner()		const			{ return source; }
+		Source&				Inner()						{ return source; }
+		const Mapper&		Mapping()	const			{ return map; }
+
 		template <class Factory>
 		MapperEnumerator(Factory&& getSource, const Mapper& map) : source { getSource() }, map { map }  {}
 		MapperEnumerator(MapperEnumerator&&) = default;
@@ -1252,6 +1420,10 @@ namespace Def {
 		SizeInfo			Measure()	const override	{ return source.Measure().Subtract(!prev.IsInitialized()); }
 		IEnumerator<TElem>*	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
 
+		/// Parts of the stage - e.g. to recognize arithmetic over contiguous sources.
+		const Source&		Inner()		const			{ return source; }
+		const Combiner&		Operation()	const			{ return binop; }
+
 		template <class Factory>
 		CombinerEnumerator(Factory&& getSource, const Combiner& binop) : source { getSource() }, binop { binop }  {}
 		CombinerEnumerator(CombinerEnumerator&&) = default;
@@ -1273,6 +1445,10 @@ namespace Def {
 		SizeInfo			Measure()   const override	{ return source1.Measure().Limit(source2.Measure()); }
 		IEnumerator<TElem>*	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
 
+		const Source1&		Inner1()	const			{ return source1; }
+		const Source2&		Inner2()	const			{ return source2; }
+		const Zipper&		Operation()	const			{ return zip; }
+
 		template <class Fact1, class Fact2>
 		ZipperEnumerator(Fact1&& getSource1, Fact2&& getSource2, const Zipper& zip) :
 			source1 { getSource1() },
@@ -1365,10 +1541,12 @@ namespace Def {
 		using typename ReplayEnumerator::IEnumerator::TElem;
 
 	private:
-		Source								source;
-		size_t								counter;
-		SmallListType<StorableT<TElem>, 1>	headElems;
-		bool								inReplay = false;
+		using THeadElems = typename CacheArena<Source>::template SmallListT<StorableT<TElem>, 1>;
+
+		Source		source;
+		size_t		counter;
+		THeadElems	headElems;
+		bool		inReplay = false;
 
 	public:
 		bool FetchNext() override
@@ -1421,7 +1599,7 @@ namespace Def {
 		ReplayEnumerator(Factory&& getSource, size_t n) :
 			source    { getSource() },
 			counter   { n },
-			headElems { SmallListOperations::Init<decltype(headElems)>(n) }
+			headElems { CacheArena<Source> { getSource }.template Init<SmallListOperations, THeadElems>(n) }
 		{
 		}
 
@@ -1598,9 +1776,10 @@ namespace Def {
 #pragma region Chainable Caching Operations
 
 	template <class Source, class Ordering>
-	class SorterEnumerator final : public CachingEnumerator<ListOperations::Container<StorableT<EnumeratedT<Source>>>> {
-		Source			 source;
-		const Ordering&	 ordering;
+	class SorterEnumerator final : public CachingEnumerator<typename CacheArena<Source>::template ListT<StorableT<EnumeratedT<Source>>>>,
+								   private CacheArena<Source> {		// empty unless chained WithArena
+		Source				source;
+		const Ordering&		ordering;
 
 	public:
 		using typename SorterEnumerator::CachingEnumerator::TCache;
@@ -1608,7 +1787,7 @@ namespace Def {
 
 		TCache	CalcResults() override
 		{
-			TCache cache = ObtainCachedResults<ListOperations, StorableT<TElem>>(source, 0);
+			TCache cache = this->template Obtain<ListOperations, StorableT<TElem>, TCache>(source);
 			std::sort(AdlBegin(cache), AdlEnd(cache), ordering);
 			return cache;
 		}
@@ -1618,25 +1797,44 @@ namespace Def {
 
 
 		template <class Factory>
-		SorterEnumerator(Factory&& getSource, const Ordering& ordering) : source { getSource() }, ordering { ordering }  {}
+		SorterEnumerator(Factory&& getSource, const Ordering& ordering) :
+			CacheArena<Source> { getSource },
+			source			   { getSource() },
+			ordering		   { ordering }
+		{
+		}
+
 		SorterEnumerator(SorterEnumerator&&) = default;
 	};
 
 
 
+	/// Vectorized alternative to the search of MinSeekEnumerator - for recognized sources and orderings.
+	/// Specializations are provided by Enumerables_Simd.hpp.
+	template <class Source, class Ordering, class = void>
+	struct MinimumsKernel {
+		template <class TCache>
+		static bool	TrySeek(Source&, const Ordering&, TCache&)	{ return false; }
+	};
+
+
+
 	template <class Source, class Ordering>
-	class MinSeekEnumerator final : public CachingEnumerator<ListOperations::Container<StorableT<EnumeratedT<Source>>>> {
-		Source			 source;
-		const Ordering&	 isLess;
+	class MinSeekEnumerator final : public CachingEnumerator<typename CacheArena<Source>::template ListT<StorableT<EnumeratedT<Source>>>>,
+									private CacheArena<Source> {		// empty unless chained WithArena
+		Source				source;
+		const Ordering&		isLess;
 
 	public:
 		using typename MinSeekEnumerator::CachingEnumerator::TCache;
 		using typename MinSeekEnumerator::CachingEnumerator::TElem;
 
-		// CONSIDER: Check perf of a separate alg for .MinimumsBy(field)
 		TCache CalcResults() override
 		{
-			TCache minimums;
+			TCache minimums = this->template Init<ListOperations, TCache>(0);
+			if (MinimumsKernel<Source, Ordering>::TrySeek(source, isLess, minimums))
+				return minimums;
+
 			if (!source.FetchNext())
 				return minimums;
 
@@ -1679,7 +1877,13 @@ namespace Def {
 
 
 		template <class Factory>
-		MinSeekEnumerator(Factory&& getSource, const Ordering& ordering) : source { getSource() }, isLess { ordering }  {}
+		MinSeekEnumerator(Factory&& getSource, const Ordering& ordering) :
+			CacheArena<Source> { getSource },
+			source			   { getSource() },
+			isLess			   { ordering }
+		{
+		}
+
 		MinSeekEnumerator(MinSeekEnumerator&&) = default;
 	};
 
@@ -0,0 +1,580 @@
+#ifndef ENUMERABLES_EXECUTORS_HPP
+#define ENUMERABLES_EXECUTORS_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the scheduling facilities of parallel queries:							  *
+	 *		- IExecutor:			interface to plug in the application's own scheduler			  *
+	 *		- WorkStealingExecutor:	the default, header-only thread pool							  *
+	 *		- ParallelFor:			adaptive, recursively splitting parallel loop over an IExecutor	  *
+	 *																								  *
+	 *  Included by Enumerables_Parallel.hpp - not to be used directly.								  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	using std::size_t;
+	using std::ptrdiff_t;
+
+
+#pragma region Executor interface
+
+	/// Unit of work scheduled on an IExecutor.
+	/// @remarks	Not owned by the executor: submitters keep their tasks alive until executed.
+	class ITask {
+	public:
+		virtual void Execute() = 0;
+
+	protected:
+		~ITask() = default;
+	};
+
+
+	/// Scheduler of parallel queries. Implement to run them on the application's own threads.
+	/// @remarks
+	///		Threads waiting for their submitted tasks call RunPendingTask repeatedly, so an
+	///		implementation without any threads of its own (executing on the waiters) is valid.
+	class IExecutor {
+	public:
+		virtual ~IExecutor() = default;
+
+		/// Number of threads which may execute tasks concurrently - including the waiting ones.
+		virtual size_t	Concurrency()	 const	= 0;
+
+		/// Schedule @p task for asynchronous execution.
+		virtual void	Submit(ITask& task)		= 0;
+
+		/// Execute a single pending task on the calling thread, if there's any.
+		/// @returns	false if found nothing to execute
+		virtual bool	RunPendingTask()		= 0;
+
+		/// Hint for adaptive splitting: whether further tasks submitted now would likely get picked up.
+		virtual bool	WantsMoreTasks() const	= 0;
+	};
+
+#pragma endregion
+
+
+
+#pragma region Work-stealing
+
+	/// Chase-Lev deque: the owner thread pushes/takes at the bottom, other threads steal from the top without locking.
+	/// [Lê, Pop, Cohen, Zappa Nardelli: Correct and Efficient Work-Stealing for Weak Memory Models, 2013]
+	template <class T>
+	class WorkStealingDeque {
+
+		struct Buffer {
+			const size_t						capacity;		// power of 2
+			std::unique_ptr<std::atomic<T*>[]>	slots;
+			std::unique_ptr<Buffer>				retired;		// thieves may still read replaced buffers -> freed along with the deque
+
+			T*		Get(ptrdiff_t i) const		{ return slots[static_cast<size_t>(i) & (capacity - 1)].load(std::memory_order_relaxed); }
+			void	Put(ptrdiff_t i, T* item)	{ slots[static_cast<size_t>(i) & (capacity - 1)].store(item, std::memory_order_relaxed); }
+
+			Buffer(size_t capacity, std::unique_ptr<Buffer>&& retired) :
+				capacity { capacity },
+				slots	 { new std::atomic<T*>[capacity] },
+				retired	 { move(retired) }
+			{
+			}
+		};
+
+		std::atomic<ptrdiff_t>	top		{ 0 };
+		std::atomic<ptrdiff_t>	bottom	{ 0 };
+		std::atomic<Buffer*>	buffer	{ nullptr };
+		std::unique_ptr<Buffer>	storage;
+
+
+		Buffer* Grow(Buffer* old, ptrdiff_t t, ptrdiff_t b)
+		{
+			storage = std::unique_ptr<Buffer> { new Buffer { old->capacity * 2, move(storage) } };
+			for (ptrdiff_t i = t; i < b; ++i)
+				storage->Put(i, old->Get(i));
+
+			buffer.store(storage.get(), std::memory_order_release);
+			return storage.get();
+		}
+
+	public:
+		/// [Owner only]
+		void	Push(T* item)
+		{
+			ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+			ptrdiff_t t = top.load(std::memory_order_acquire);
+			Buffer*	  a = buffer.load(std::memory_order_relaxed);
+
+			if (b - t > static_cast<ptrdiff_t>(a->capacity) - 1)
+				a = Grow(a, t, b);
+
+			a->Put(b, item);
+			bottom.store(b + 1, std::memory_order_release);
+		}
+
+
+		/// Pop the most recently pushed item. [Owner only]
+		/// @returns	nullptr if empty
+		T*		Take()
+		{
+			ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+			Buffer*	  a = buffer.load(std::memory_order_relaxed);
+			bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			ptrdiff_t t = top.load(std::memory_order_relaxed);
+
+			if (t > b) {
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = a->Get(b);
+			if (t == b) {
+				// last item: race against thieves
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+
+
+		/// Pop the least recently pushed item. [Any thread]
+		/// @returns	nullptr if empty or lost a race
+		T*		Steal()
+		{
+			ptrdiff_t t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			ptrdiff_t b = bottom.load(std::memory_order_acquire);
+
+			if (t >= b)
+				return nullptr;
+
+			Buffer* a	 = buffer.load(std::memory_order_acquire);
+			T*		item = a->Get(t);
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return item;
+		}
+
+
+		bool	IsEmpty() const
+		{
+			return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+		}
+
+
+		explicit WorkStealingDeque(size_t initialCapacity = 64) :
+			storage { new Buffer { initialCapacity, nullptr } }
+		{
+			ENUMERABLES_INTERNAL_ASSERT ((initialCapacity & (initialCapacity - 1)) == 0);
+			buffer.store(storage.get());
+		}
+
+		WorkStealingDeque(const WorkStealingDeque&)			   = delete;
+		WorkStealingDeque& operator =(const WorkStealingDeque&) = delete;
+	};
+
+
+
+	/// Thread pool with a work-stealing deque for each worker.
+	/// @remarks
+	///		Tasks submitted by a worker go to its own deque (executed LIFO by itself, stolen FIFO by others),
+	///		tasks from other threads go to a shared injection queue. Idle workers sleep until new submissions.
+	class WorkStealingExecutor final : public IExecutor {
+
+		struct Worker {
+			WorkStealingDeque<ITask>	deque;
+			std::thread					thread;
+		};
+
+		struct ThreadIdentity {
+			const WorkStealingExecutor*	owner = nullptr;
+			size_t						index = 0;
+		};
+
+		static ThreadIdentity&	CurrentThread()
+		{
+			static thread_local ThreadIdentity identity;
+			return identity;
+		}
+
+
+		const size_t						workerCount;
+		std::unique_ptr<Worker[]>			workers;
+
+		std::mutex							injectionLock;
+		std::vector<ITask*>					injected;
+		std::atomic<size_t>					injectedCount	{ 0 };
+
+		std::mutex							sleepLock;
+		std::condition_variable				wakeup;
+		std::atomic<size_t>					epoch			{ 0 };		// incremented on each submission
+		std::atomic<size_t>					sleepers		{ 0 };
+		std::atomic<size_t>					idleWorkers;
+		std::atomic<bool>					stopping		{ false };
+
+
+		Worker*	OwnWorker() const
+		{
+			const ThreadIdentity& me = CurrentThread();
+			return me.owner == this ? &workers[me.index] : nullptr;
+		}
+
+
+		ITask*	PopInjected()
+		{
+			if (injectedCount.load(std::memory_order_acquire) == 0)
+				return nullptr;
+
+			std::lock_guard<std::mutex> guard { injectionLock };
+			if (injected.empty())
+				return nullptr;
+
+			ITask* task = injected.back();
+			injected.pop_back();
+			injectedCount.fetch_sub(1, std::memory_order_release);
+			return task;
+		}
+
+
+		ITask*	FindTask()
+		{
+			Worker* own = OwnWorker();
+			if (own != nullptr) {
+				if (ITask* task = own->deque.Take())
+					return task;
+			}
+
+			if (ITask* task = PopInjected())
+				return task;
+
+			size_t start = (own != nullptr) ? CurrentThread().index + 1 : 0;
+			for (size_t i = 0; i < workerCount; ++i) {
+				Worker& victim = workers[(start + i) % workerCount];
+				if (&victim == own)
+					continue;
+
+				if (ITask* task = victim.deque.Steal())
+					return task;
+			}
+			return nullptr;
+		}
+
+
+		void	WorkerLoop(size_t index)
+		{
+			CurrentThread() = { this, index };
+
+			for (;;) {
+				size_t seen = epoch.load();
+				if (stopping.load())
+					return;
+
+				if (ITask* task = FindTask()) {
+					idleWorkers.fetch_sub(1);
+					task->Execute();
+					idleWorkers.fetch_add(1);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock { sleepLock };
+				sleepers.fetch_add(1);
+				wakeup.wait(lock, [&]() { return epoch.load() != seen || stopping.load(); });
+				sleepers.fetch_sub(1);
+			}
+		}
+
+	public:
+		size_t	Concurrency() const override
+		{
+			return workerCount + 1;
+		}
+
+
+		void	Submit(ITask& task) override
+		{
+			if (Worker* own = OwnWorker()) {
+				own->deque.Push(&task);
+			}
+			else {
+				std::lock_guard<std::mutex> guard { injectionLock };
+				injected.push_back(&task);
+				injectedCount.fetch_add(1, std::memory_order_release);
+			}
+
+			epoch.fetch_add(1);
+			if (sleepers.load() > 0) {
+				std::lock_guard<std::mutex> guard { sleepLock };
+				wakeup.notify_one();
+			}
+		}
+
+
+		bool	RunPendingTask() override
+		{
+			ITask* task = FindTask();
+			if (task != nullptr)
+				task->Execute();
+
+			return task != nullptr;
+		}
+
+
+		bool	WantsMoreTasks() const override
+		{
+			if (idleWorkers.load(std::memory_order_relaxed) == 0)
+				return false;
+
+			// Lazy splitting: previously submitted tasks should get picked up first.
+			Worker* own = OwnWorker();
+			return own != nullptr ? own->deque.IsEmpty()
+								  : injectedCount.load(std::memory_order_relaxed) == 0;
+		}
+
+
+		/// @param workerCount:	number of background threads - the threads waiting for results work too
+		explicit WorkStealingExecutor(size_t workerCount) :
+			workerCount { workerCount },
+			workers		{ new Worker[workerCount] },
+			idleWorkers { workerCount }
+		{
+			for (size_t i = 0; i < workerCount; ++i)
+				workers[i].thread = std::thread { [this, i]() { WorkerLoop(i); } };
+		}
+
+
+		~WorkStealingExecutor()
+		{
+			{
+				std::lock_guard<std::mutex> guard { sleepLock };
+				stopping.store(true);
+			}
+			wakeup.notify_all();
+
+			for (size_t i = 0; i < workerCount; ++i)
+				workers[i].thread.join();
+		}
+
+		WorkStealingExecutor(const WorkStealingExecutor&)			  = delete;
+		WorkStealingExecutor& operator =(const WorkStealingExecutor&) = delete;
+	};
+
+#pragma endregion
+
+
+
+#pragma region Fork-join
+
+	/// Tracks completion of the tasks submitted for a single parallel operation.
+	class TaskGroup {
+		IExecutor&					executor;
+		std::atomic<size_t>			pending	{ 0 };
+		std::atomic<bool>			failed	{ false };
+
+		std::mutex					errorLock;
+		size_t						errorPos = static_cast<size_t>(-1);
+		std::exception_ptr			error;
+
+	public:
+		IExecutor&	Executor()		const	{ return executor; }
+		size_t		PendingCount()	const	{ return pending.load(std::memory_order_relaxed); }
+		bool		IsFailed()		const	{ return failed.load(std::memory_order_relaxed); }
+
+
+		void	Submit(ITask& task)
+		{
+			pending.fetch_add(1);
+			executor.Submit(task);
+		}
+
+		/// Called by a submitted task, as its last access of shared state.
+		void	Complete()
+		{
+			pending.fetch_sub(1, std::memory_order_release);
+		}
+
+		/// Record an exception thrown while processing the work starting at @p pos.
+		void	Fail(size_t pos, std::exception_ptr ex)
+		{
+			std::lock_guard<std::mutex> guard { errorLock };
+			if (pos < errorPos) {
+				errorPos = pos;
+				error	 = move(ex);
+			}
+			failed.store(true);
+		}
+
+
+		/// Help executing pending tasks until all submitted ones complete.
+		/// @throws		the recorded exception of lowest position, if any
+		void	Wait()
+		{
+			while (pending.load(std::memory_order_acquire) > 0) {
+				if (!executor.RunPendingTask())
+					std::this_thread::yield();
+			}
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+
+		explicit TaskGroup(IExecutor& executor) : executor { executor }
+		{
+		}
+	};
+
+
+
+	/// A range of ParallelFor, which splits off its upper half as a new task on demand.
+	template <class Body>
+	class RangeTask final : public ITask {
+		TaskGroup&		group;
+		const Body&		body;
+		const size_t	grain;
+		const size_t	maxStep;
+		const size_t	maxTasks;
+		size_t			begin;
+		size_t			end;
+
+		std::vector<std::unique_ptr<RangeTask>>	forks;
+
+
+		bool	ShouldSplit() const
+		{
+			return end - begin >= 2 * grain
+				&& group.PendingCount() + 1 < maxTasks
+				&& group.Executor().WantsMoreTasks();
+		}
+
+		void	Split()
+		{
+			size_t mid = begin + (end - begin) / 2;
+
+			forks.emplace_back(new RangeTask { group, body, grain, maxStep, maxTasks, mid, end });
+			end = mid;
+			group.Submit(*forks.back());
+		}
+
+	public:
+		/// Process the range in growing steps, splitting before each if the executor has idle capacity.
+		void	Run()
+		{
+			size_t step = grain;
+			while (begin < end && !group.IsFailed()) {
+				if (ShouldSplit())
+					Split();
+
+				size_t stepEnd = (end - begin > step) ? begin + step : end;
+				try {
+					body(begin, stepEnd);
+				}
+				catch (...) {
+					group.Fail(begin, std::current_exception());
+					return;
+				}
+				begin = stepEnd;
+				step  = (2 * step < maxStep) ? 2 * step : maxStep;
+			}
+		}
+
+
+		void	Execute() override
+		{
+			Run();
+			group.Complete();
+		}
+
+
+		RangeTask(TaskGroup& group, const Body& body, size_t grain, size_t maxStep, size_t maxTasks, size_t begin, size_t end) :
+			group	 { group },
+			body	 { body },
+			grain	 { grain },
+			maxStep	 { maxStep },
+			maxTasks { maxTasks },
+			begin	 { begin },
+			end		 { end }
+		{
+		}
+	};
+
+
+	/// Parallel loop over [0, length): calls @p body(b, e) for disjoint, contiguous pieces covering the range.
+	/// Work is split recursively and lazily - only while the executor has idle capacity -, which balances skewed workloads.
+	/// @param grain:		minimal length of pieces worth a split
+	/// @param maxTasks:	limit of concurrently executed tasks (thus threads) for this loop
+	/// @throws				the exception of the lowest positioned piece which has failed, after all running pieces finished
+	template <class Body>
+	void ParallelFor(IExecutor& executor, size_t length, size_t grain, size_t maxTasks, const Body& body)
+	{
+		if (grain == 0)
+			grain = 1;
+
+		if (maxTasks < 2 || length < 2 * grain) {
+			body(size_t { 0 }, length);
+			return;
+		}
+
+		// steps grow to limit the number of pieces, yet keep checking for idle workers
+		size_t maxStep = length / (4 * maxTasks);
+		if (maxStep < grain)
+			maxStep = grain;
+
+		TaskGroup			group { executor };
+		RangeTask<Body>		root  { group, body, grain, maxStep, maxTasks, 0, length };
+
+		root.Run();
+		group.Wait();
+	}
+
+#pragma endregion
+
+
+
+	/// Number of threads to evaluate a parallel query on.
+	/// @param degree:	requested explicitly - 0 means the hardware's concurrency
+	inline size_t	ParallelWorkerCount(size_t degree)
+	{
+		size_t limit = ENUMERABLES_PARALLEL_MAX_WORKERS;
+		if (degree == 0)
+			degree = std::thread::hardware_concurrency();
+		if (degree == 0)
+			degree = 1;
+
+		return (limit == 0 || degree < limit) ? degree : limit;
+	}
+
+
+	/// Process-wide executor of parallel queries without WithExecutor() specified.
+	/// [Background workers: ENUMERABLES_PARALLEL_MAX_WORKERS or hardware concurrency - 1 for the waiting thread.]
+	inline IExecutor&	DefaultExecutor()
+	{
+		static WorkStealingExecutor executor { ParallelWorkerCount(0) - 1 };
+		return executor;
+	}
+
+
+}	// namespace Def
+
+
+using Def::IExecutor;
+using Def::ITask;
+using Def::WorkStealingExecutor;
+using Def::DefaultExecutor;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_EXECUTORS_HPP
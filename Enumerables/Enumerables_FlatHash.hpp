@@ -0,0 +1,921 @@
+#ifndef ENUMERABLES_FLATHASH_HPP
+#define ENUMERABLES_FLATHASH_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains open-addressing alternatives of the STL's node-based hash containers,	  *
+	 *  selectable by the FlatBinding of Enumerables_ConfigDefaults.hpp:							  *
+	 *		- FlatHashSet:	replacing std::unordered_set											  *
+	 *		- FlatHashMap:	replacing std::unordered_map											  *
+	 *																								  *
+	 *  Included by Enumerables_ConfigDefaults.hpp - not to be used directly.						  *
+	 *  --------------------------------------------------------------------------------------------  *
+	 *	Concept (of Swiss tables):																	  *
+	 *		Elements are stored in a single array of slots, each accompanied by a control byte:		  *
+	 *			- Empty, Deleted (tombstone of an erased element) or								  *
+	 *			- the 7 lowest bits of the element's hash, when full								  *
+	 *		Lookups probe a whole group of control bytes at once (16 by SSE2, 8 otherwise),			  *
+	 *		then compare the elements of matching bytes only. Probing stops at a group having an	  *
+	 *		Empty byte. Groups are visited by triangular steps, which cover the whole table.		  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if ENUMERABLES_USE_SIMD && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#	define ENUMERABLES_FLATHASH_SSE2	1
+#	include <emmintrin.h>
+#else
+#	define ENUMERABLES_FLATHASH_SSE2	0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#	include <intrin.h>
+#endif
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	using std::size_t;
+
+
+	namespace FlatHashDetails {
+
+		using Ctrl = signed char;
+
+		// Full slots store the low 7 bits of their hash:  0b0xxxxxxx
+		constexpr Ctrl	Empty	= -128;		// 0b10000000
+		constexpr Ctrl	Deleted = -2;		// 0b11111110
+
+		constexpr size_t NotFound = ~size_t(0);
+
+
+		/// Spread the bits of the client's hash (murmur3 finalizer) - e.g. std::hash of integers is identity for most libraries.
+		inline size_t	Mix(size_t hash)
+		{
+			std::uint64_t h = hash;
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdull;
+			h ^= h >> 33;
+			h *= 0xc4ceb9fe1a85ec53ull;
+			h ^= h >> 33;
+			return static_cast<size_t>(h);
+		}
+
+		inline size_t	H1(size_t hash)	{ return hash >> 7; }
+		inline Ctrl		H2(size_t hash)	{ return static_cast<Ctrl>(hash & 0x7F); }
+
+
+		inline unsigned	LowestBit(std::uint32_t mask)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return index;
+#else
+			return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+		}
+
+
+#if ENUMERABLES_FLATHASH_SSE2
+
+		/// Control bytes of 16 consecutive slots, bit i of the masks belongs to slot i.
+		struct Group {
+			static constexpr size_t Width = 16;
+
+			__m128i ctrl;
+
+			explicit Group(const Ctrl* pos) : ctrl { _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)) }
+			{
+			}
+
+			std::uint32_t	Match(Ctrl h2)	 const	{ return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))); }
+			std::uint32_t	MatchEmpty()	 const	{ return Match(Empty); }
+			std::uint32_t	MatchNonFull()	 const	{ return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl)); }		// sign bit: Empty or Deleted
+		};
+
+#else
+
+		/// Control bytes of 8 consecutive slots, bit i of the masks belongs to slot i.
+		struct Group {
+			static constexpr size_t Width = 8;
+
+			Ctrl ctrl[Width];
+
+			explicit Group(const Ctrl* pos)
+			{
+				std::memcpy(ctrl, pos, Width);
+			}
+
+			std::uint32_t	Match(Ctrl h2) const
+			{
+				std::uint32_t mask = 0;
+				for (size_t i = 0; i < Width; ++i)
+					mask |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+				return mask;
+			}
+
+			std::uint32_t	MatchEmpty() const
+			{
+				return Match(Empty);
+			}
+
+			std::uint32_t	MatchNonFull() const
+			{
+				std::uint32_t mask = 0;
+				for (size_t i = 0; i < Width; ++i)
+					mask |= static_cast<std::uint32_t>(ctrl[i] < 0) << i;
+				return mask;
+			}
+		};
+
+#endif
+
+
+		template <class T>
+		class IsTransparent {
+			template <class U>	static std::true_type	Test(typename U::is_transparent*);
+			template <class U>	static std::false_type	Test(...);
+
+		public:
+			static constexpr bool value = decltype(Test<T>(nullptr))::value;
+		};
+
+
+
+		/// Slots of FlatHashSet: the values themselves - never mutable through iterators.
+		template <class V>
+		struct SetPolicy {
+			using Key		= V;
+			using Slot		= V;
+			using Reference = const V&;
+
+			static const V&		KeyOf(const Slot& s)	{ return s; }
+
+			template <class A>
+			static void			Relocate(A& alloc, Slot* trg, Slot& src)
+			{
+				std::allocator_traits<A>::construct(alloc, trg, std::move_if_noexcept(src));
+			}
+		};
+
+
+		/// Slots of FlatHashMap: key-value pairs, as of std::unordered_map.
+		template <class K, class V>
+		struct MapPolicy {
+			using Key		= K;
+			using Slot		= std::pair<const K, V>;
+			using Reference = Slot&;
+
+			static const K&		KeyOf(const Slot& s)	{ return s.first; }
+
+			template <class A>
+			static void			Relocate(A& alloc, Slot* trg, Slot& src)
+			{
+				using MoveKeys = std::integral_constant<bool, (std::is_nothrow_move_constructible<K>::value && std::is_nothrow_move_constructible<V>::value)
+															  || !std::is_copy_constructible<Slot>::value>;
+				Relocate(alloc, trg, src, MoveKeys {});
+			}
+
+			// The source gets destroyed right after: its key can be moved despite constness (like std::map's node handles do).
+			template <class A>
+			static void			Relocate(A& alloc, Slot* trg, Slot& src, std::true_type)
+			{
+				std::allocator_traits<A>::construct(alloc, trg, std::move(const_cast<K&>(src.first)), std::move(src.second));
+			}
+
+			template <class A>
+			static void			Relocate(A& alloc, Slot* trg, Slot& src, std::false_type)
+			{
+				std::allocator_traits<A>::construct(alloc, trg, static_cast<const Slot&>(src));
+			}
+		};
+
+
+
+		/// Common implementation of FlatHashSet and FlatHashMap.
+		/// @remarks
+		///		Capacity is either 0 or a power of 2 (at least Group::Width) - with at most 7/8 of it used by elements and tombstones.
+		///		Control bytes of the first group are mirrored after the last slot, so that any group can be loaded unaligned.
+		template <class Policy, class Hash, class KeyEqual, class Alloc>
+		class FlatHashTable {
+		public:
+			using key_type			= typename Policy::Key;
+			using value_type		= typename Policy::Slot;
+			using size_type			= size_t;
+			using difference_type	= std::ptrdiff_t;
+			using hasher			= Hash;
+			using key_equal			= KeyEqual;
+			using allocator_type	= Alloc;
+			using reference			= value_type&;
+			using const_reference	= const value_type&;
+
+		protected:
+			using Traits	 = std::allocator_traits<Alloc>;
+			using CtrlAlloc	 = typename Traits::template rebind_alloc<Ctrl>;
+			using CtrlTraits = std::allocator_traits<CtrlAlloc>;
+
+			static_assert (std::is_same<typename Traits::value_type, value_type>::value, "Allocator of a flat hash container must allocate its value_type.");
+
+
+			template <class Ref>
+			class Iterator {
+				friend class FlatHashTable;
+				template <class>	friend class Iterator;
+
+				using Slot = typename FlatHashTable::value_type;
+
+				const Ctrl*	ctrl = nullptr;
+				const Ctrl*	last = nullptr;
+				Slot*		slot = nullptr;
+
+				Iterator(const Ctrl* ctrl, const Ctrl* last, Slot* slot) : ctrl { ctrl }, last { last }, slot { slot }
+				{
+				}
+
+				void	SkipNonFull()
+				{
+					while (ctrl != last && *ctrl < 0) {
+						++ctrl;
+						++slot;
+					}
+				}
+
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type		= Slot;
+				using difference_type	= std::ptrdiff_t;
+				using reference			= Ref;
+				using pointer			= std::remove_reference_t<Ref>*;
+
+				Iterator() = default;
+
+				template <class R, class = std::enable_if_t<!std::is_same<R, Ref>::value && std::is_convertible<R, Ref>::value>>
+				Iterator(const Iterator<R>& src) : ctrl { src.ctrl }, last { src.last }, slot { src.slot }
+				{
+				}
+
+				reference	operator *()	const	{ return *slot; }
+				pointer		operator ->()	const	{ return slot; }
+
+				Iterator&	operator ++()
+				{
+					++ctrl;
+					++slot;
+					SkipNonFull();
+					return *this;
+				}
+
+				Iterator	operator ++(int)
+				{
+					Iterator prev = *this;
+					++*this;
+					return prev;
+				}
+
+				friend bool	operator ==(const Iterator& lhs, const Iterator& rhs)	{ return lhs.ctrl == rhs.ctrl; }
+				friend bool	operator !=(const Iterator& lhs, const Iterator& rhs)	{ return lhs.ctrl != rhs.ctrl; }
+			};
+
+		public:
+			using iterator		 = Iterator<typename Policy::Reference>;
+			using const_iterator = Iterator<const value_type&>;
+
+		private:
+			// Allocator gets empty-base optimized
+			struct Storage : Alloc {
+				Ctrl*		ctrl		= nullptr;
+				value_type*	slots		= nullptr;
+				size_t		capacity	= 0;
+				size_t		count		= 0;
+				size_t		growthLeft	= 0;
+
+				explicit Storage(const Alloc& alloc) : Alloc { alloc }
+				{
+				}
+
+				Alloc&			Allocator()			{ return *this; }
+				const Alloc&	Allocator() const	{ return *this; }
+			};
+
+			Storage		storage;
+			Hash		hash;
+			KeyEqual	equal;
+
+
+			static size_t	MaxLoad(size_t capacity)	{ return capacity - capacity / 8; }
+
+			static void		SetCtrl(Ctrl* ctrl, size_t capacity, size_t i, Ctrl c)
+			{
+				ctrl[i] = c;
+				if (i < Group::Width)
+					ctrl[capacity + i] = c;
+			}
+
+			static size_t	FirstNonFull(const Ctrl* ctrl, size_t capacity, size_t h)
+			{
+				const size_t mask = capacity - 1;
+				size_t		 pos  = H1(h) & mask;
+				for (size_t step = Group::Width; ; step += Group::Width) {
+					const std::uint32_t nonFull = Group { ctrl + pos }.MatchNonFull();
+					if (nonFull != 0)
+						return (pos + LowestBit(nonFull)) & mask;
+
+					pos = (pos + step) & mask;
+				}
+			}
+
+			template <class K>
+			size_t			FindIndex(const K& key, size_t h) const
+			{
+				if (storage.capacity == 0)
+					return NotFound;
+
+				const size_t mask = storage.capacity - 1;
+				size_t		 pos  = H1(h) & mask;
+				for (size_t step = Group::Width; ; step += Group::Width) {
+					const Group group { storage.ctrl + pos };
+					for (std::uint32_t match = group.Match(H2(h)); match != 0; match &= match - 1) {
+						const size_t i = (pos + LowestBit(match)) & mask;
+						if (equal(Policy::KeyOf(storage.slots[i]), key))
+							return i;
+					}
+					if (group.MatchEmpty() != 0)
+						return NotFound;
+
+					pos = (pos + step) & mask;
+				}
+			}
+
+			template <class K>
+			size_t			FindIndex(const K& key) const
+			{
+				return FindIndex(key, Mix(hash(key)));
+			}
+
+			/// Slot to insert a new element of hash @p h at - or NotFound if growth is needed first.
+			size_t			PrepareInsert(size_t h) const
+			{
+				if (storage.capacity == 0)
+					return NotFound;
+
+				const size_t i = FirstNonFull(storage.ctrl, storage.capacity, h);
+				return storage.growthLeft > 0 || storage.ctrl[i] == Deleted ? i : NotFound;
+			}
+
+			void			CommitInsert(size_t i, size_t h)
+			{
+				if (storage.ctrl[i] == Empty)
+					--storage.growthLeft;
+
+				SetCtrl(storage.ctrl, storage.capacity, i, H2(h));
+				++storage.count;
+			}
+
+			void			Grow()
+			{
+				// when mostly tombstones are in the way, just clean them up
+				if (storage.capacity != 0 && storage.count <= MaxLoad(storage.capacity) / 2)
+					Rehash(storage.capacity);
+				else
+					Rehash(storage.capacity == 0 ? Group::Width : 2 * storage.capacity);
+			}
+
+			void			Rehash(size_t capacity)
+			{
+				Alloc&		alloc = storage.Allocator();
+				CtrlAlloc	ctrlAlloc { alloc };
+
+				Ctrl*		ctrl  = CtrlTraits::allocate(ctrlAlloc, capacity + Group::Width);
+				value_type*	slots = nullptr;
+				try {
+					slots = Traits::allocate(alloc, capacity);
+				}
+				catch (...) {
+					CtrlTraits::deallocate(ctrlAlloc, ctrl, capacity + Group::Width);
+					throw;
+				}
+				std::memset(ctrl, Empty, capacity + Group::Width);
+
+				try {
+					for (size_t i = 0; i < storage.capacity; ++i) {
+						if (storage.ctrl[i] < 0)
+							continue;
+
+						const size_t h = Mix(hash(Policy::KeyOf(storage.slots[i])));
+						const size_t j = FirstNonFull(ctrl, capacity, h);
+						Policy::Relocate(alloc, slots + j, storage.slots[i]);
+						SetCtrl(ctrl, capacity, j, H2(h));
+					}
+				}
+				catch (...) {
+					for (size_t j = 0; j < capacity; ++j) {
+						if (ctrl[j] >= 0)
+							Traits::destroy(alloc, slots + j);
+					}
+					Traits::deallocate(alloc, slots, capacity);
+					CtrlTraits::deallocate(ctrlAlloc, ctrl, capacity + Group::Width);
+					throw;
+				}
+
+				const size_t count = storage.count;
+				ReleaseAll();
+				storage.ctrl	   = ctrl;
+				storage.slots	   = slots;
+				storage.capacity   = capacity;
+				storage.count	   = count;
+				storage.growthLeft = MaxLoad(capacity) - count;
+			}
+
+			void			DestroyAll()
+			{
+				for (size_t i = 0; i < storage.capacity; ++i) {
+					if (storage.ctrl[i] >= 0)
+						Traits::destroy(storage.Allocator(), storage.slots + i);
+				}
+				storage.count = 0;
+			}
+
+			void			ReleaseAll()
+			{
+				if (storage.capacity == 0)
+					return;
+
+				DestroyAll();
+
+				CtrlAlloc ctrlAlloc { storage.Allocator() };
+				CtrlTraits::deallocate(ctrlAlloc, storage.ctrl, storage.capacity + Group::Width);
+				Traits::deallocate(storage.Allocator(), storage.slots, storage.capacity);
+
+				storage.ctrl	   = nullptr;
+				storage.slots	   = nullptr;
+				storage.capacity   = 0;
+				storage.growthLeft = 0;
+			}
+
+			/// Take the arrays of @p src - allocated by an allocator equal to this one's.
+			void			TakeArrays(FlatHashTable& src)
+			{
+				storage.ctrl	   = src.storage.ctrl;
+				storage.slots	   = src.storage.slots;
+				storage.capacity   = src.storage.capacity;
+				storage.count	   = src.storage.count;
+				storage.growthLeft = src.storage.growthLeft;
+
+				src.storage.ctrl	   = nullptr;
+				src.storage.slots	   = nullptr;
+				src.storage.capacity   = 0;
+				src.storage.count	   = 0;
+				src.storage.growthLeft = 0;
+			}
+
+			/// Insert elements of @p src known to be unique, by copy or @p Relocate.
+			template <bool Relocate>
+			void			InsertAllUnique(FlatHashTable& src)
+			{
+				reserve(storage.count + src.storage.count);
+				for (size_t i = 0; i < src.storage.capacity; ++i) {
+					if (src.storage.ctrl[i] < 0)
+						continue;
+
+					value_type&	 value = src.storage.slots[i];
+					const size_t h	   = Mix(hash(Policy::KeyOf(value)));
+					const size_t j	   = FirstNonFull(storage.ctrl, storage.capacity, h);
+					if (Relocate)
+						Policy::Relocate(storage.Allocator(), storage.slots + j, value);
+					else
+						Traits::construct(storage.Allocator(), storage.slots + j, static_cast<const value_type&>(value));
+
+					CommitInsert(j, h);
+				}
+			}
+
+			void	PropagateAllocator(const FlatHashTable& src, std::true_type)	{ storage.Allocator() = src.storage.Allocator(); }
+			void	PropagateAllocator(const FlatHashTable&,	 std::false_type)	{}
+
+			void	SwapAllocator(FlatHashTable& other, std::true_type)				{ using std::swap; swap(storage.Allocator(), other.storage.Allocator()); }
+			void	SwapAllocator(FlatHashTable&,		std::false_type)			{}
+
+
+			iterator		IteratorAt(size_t i)
+			{
+				return i == NotFound ? end() : iterator { storage.ctrl + i, storage.ctrl + storage.capacity, storage.slots + i };
+			}
+
+			const_iterator	IteratorAt(size_t i) const
+			{
+				return const_cast<FlatHashTable&>(*this).IteratorAt(i);
+			}
+
+		protected:
+			/// Insert unless @p key is present: the value is constructed from @p args - which may refer to other elements.
+			template <class K, class... Args>
+			std::pair<iterator, bool>	EmplaceUnique(const K& key, Args&&... args)
+			{
+				const size_t h = Mix(hash(key));
+				size_t		 i = FindIndex(key, h);
+				if (i != NotFound)
+					return { IteratorAt(i), false };
+
+				i = PrepareInsert(h);
+				if (i != NotFound) {
+					Traits::construct(storage.Allocator(), storage.slots + i, std::forward<Args>(args)...);
+				}
+				else {
+					// growth would invalidate referred elements
+					value_type value (std::forward<Args>(args)...);
+					Grow();
+					i = FirstNonFull(storage.ctrl, storage.capacity, h);
+					Traits::construct(storage.Allocator(), storage.slots + i, std::move(value));
+				}
+				CommitInsert(i, h);
+				return { IteratorAt(i), true };
+			}
+
+			template <class K>
+			using TransparentKey = std::enable_if_t<IsTransparent<Hash>::value && IsTransparent<KeyEqual>::value && !std::is_same<K, key_type>::value>;
+
+		public:
+			FlatHashTable() : FlatHashTable(0u)
+			{
+			}
+
+			explicit FlatHashTable(size_t capacity, const Hash& hash = Hash {}, const KeyEqual& equal = KeyEqual {}, const Alloc& alloc = Alloc {})
+				: storage { alloc }, hash { hash }, equal { equal }
+			{
+				reserve(capacity);
+			}
+
+			FlatHashTable(size_t capacity, const Alloc& alloc) : FlatHashTable(capacity, Hash {}, KeyEqual {}, alloc)
+			{
+			}
+
+			FlatHashTable(size_t capacity, const Hash& hash, const Alloc& alloc) : FlatHashTable(capacity, hash, KeyEqual {}, alloc)
+			{
+			}
+
+			explicit FlatHashTable(const Alloc& alloc) : FlatHashTable(0, Hash {}, KeyEqual {}, alloc)
+			{
+			}
+
+			FlatHashTable(const FlatHashTable& src, const Alloc& alloc) : FlatHashTable(0, src.hash, src.equal, alloc)
+			{
+				InsertAllUnique<false>(const_cast<FlatHashTable&>(src));
+			}
+
+			FlatHashTable(const FlatHashTable& src) : FlatHashTable(src, Traits::select_on_container_copy_construction(src.get_allocator()))
+			{
+			}
+
+			FlatHashTable(FlatHashTable&& src) noexcept : storage { src.storage.Allocator() }, hash { src.hash }, equal { src.equal }
+			{
+				TakeArrays(src);
+			}
+
+			~FlatHashTable()
+			{
+				ReleaseAll();
+			}
+
+
+			FlatHashTable&	operator =(const FlatHashTable& rhs)
+			{
+				if (this == &rhs)
+					return *this;
+
+				constexpr bool propagate = Traits::propagate_on_container_copy_assignment::value;
+
+				FlatHashTable copy (rhs, propagate ? rhs.get_allocator() : get_allocator());
+				ReleaseAll();
+				PropagateAllocator(rhs, typename Traits::propagate_on_container_copy_assignment {});
+				hash  = rhs.hash;
+				equal = rhs.equal;
+				TakeArrays(copy);
+				return *this;
+			}
+
+			FlatHashTable&	operator =(FlatHashTable&& rhs)
+			{
+				if (this == &rhs)
+					return *this;
+
+				ReleaseAll();
+				hash  = rhs.hash;
+				equal = rhs.equal;
+				if (Traits::propagate_on_container_move_assignment::value || storage.Allocator() == rhs.storage.Allocator()) {
+					PropagateAllocator(rhs, typename Traits::propagate_on_container_move_assignment {});
+					TakeArrays(rhs);
+				}
+				else {
+					// keep own allocator: elements get moved one by one
+					InsertAllUnique<true>(rhs);
+					rhs.clear();
+				}
+				return *this;
+			}
+
+
+			allocator_type	get_allocator()		const	{ return storage.Allocator(); }
+			hasher			hash_function()		const	{ return hash; }
+			key_equal		key_eq()			const	{ return equal; }
+
+			iterator		begin()
+			{
+				iterator first { storage.ctrl, storage.ctrl + storage.capacity, storage.slots };
+				first.SkipNonFull();
+				return first;
+			}
+
+			iterator		end()					{ return iterator { storage.ctrl + storage.capacity, storage.ctrl + storage.capacity, storage.slots + storage.capacity }; }
+			const_iterator	begin()			const	{ return const_cast<FlatHashTable&>(*this).begin(); }
+			const_iterator	end()			const	{ return const_cast<FlatHashTable&>(*this).end(); }
+			const_iterator	cbegin()		const	{ return begin(); }
+			const_iterator	cend()			const	{ return end(); }
+
+			size_t			size()			const	{ return storage.count; }
+			bool			empty()			const	{ return storage.count == 0; }
+			size_t			max_size()		const	{ return Traits::max_size(storage.Allocator()); }
+			size_t			bucket_count()	const	{ return storage.capacity; }
+
+
+			/// Make room for @p count elements in total, without further rehashing.
+			void	reserve(size_t count)
+			{
+				if (count <= storage.count + storage.growthLeft)
+					return;
+
+				size_t capacity = Group::Width;
+				while (MaxLoad(capacity) < count)
+					capacity *= 2;
+
+				Rehash(capacity);
+			}
+
+			/// Destroy all elements, keeping capacity.
+			void	clear()
+			{
+				if (storage.capacity == 0)
+					return;
+
+				DestroyAll();
+				std::memset(storage.ctrl, Empty, storage.capacity + Group::Width);
+				storage.growthLeft = MaxLoad(storage.capacity);
+			}
+
+
+			iterator		find(const key_type& key)				{ return IteratorAt(FindIndex(key)); }
+			const_iterator	find(const key_type& key)		const	{ return IteratorAt(FindIndex(key)); }
+			bool			contains(const key_type& key)	const	{ return FindIndex(key) != NotFound; }
+			size_t			count(const key_type& key)		const	{ return FindIndex(key) != NotFound ? 1 : 0; }
+
+			/// Heterogeneous lookup: only if both Hash and KeyEqual declare is_transparent.
+			template <class K, class = TransparentKey<K>>
+			iterator		find(const K& key)						{ return IteratorAt(FindIndex(key)); }
+			template <class K, class = TransparentKey<K>>
+			const_iterator	find(const K& key)				const	{ return IteratorAt(FindIndex(key)); }
+			template <class K, class = TransparentKey<K>>
+			bool			contains(const K& key)			const	{ return FindIndex(key) != NotFound; }
+			template <class K, class = TransparentKey<K>>
+			size_t			count(const K& key)				const	{ return FindIndex(key) != NotFound ? 1 : 0; }
+
+
+			/// Erasing leaves a tombstone: iterators to other elements stay valid.
+			iterator	erase(const_iterator pos)
+			{
+				const size_t i = static_cast<size_t>(pos.ctrl - storage.ctrl);
+				Traits::destroy(storage.Allocator(), storage.slots + i);
+				SetCtrl(storage.ctrl, storage.capacity, i, Deleted);
+				--storage.count;
+
+				iterator next { pos.ctrl, storage.ctrl + storage.capacity, storage.slots + i };
+				return ++next;
+			}
+
+			size_t		erase(const key_type& key)
+			{
+				const size_t i = FindIndex(key);
+				if (i == NotFound)
+					return 0;
+
+				erase(IteratorAt(i));
+				return 1;
+			}
+
+
+			void	swap(FlatHashTable& other)
+			{
+				using std::swap;
+				swap(storage.ctrl,		 other.storage.ctrl);
+				swap(storage.slots,		 other.storage.slots);
+				swap(storage.capacity,	 other.storage.capacity);
+				swap(storage.count,		 other.storage.count);
+				swap(storage.growthLeft, other.storage.growthLeft);
+				swap(hash,	other.hash);
+				swap(equal, other.equal);
+				SwapAllocator(other, typename Traits::propagate_on_container_swap {});
+			}
+
+			friend void	swap(FlatHashTable& lhs, FlatHashTable& rhs)
+			{
+				lhs.swap(rhs);
+			}
+
+			friend bool	operator ==(const FlatHashTable& lhs, const FlatHashTable& rhs)
+			{
+				if (lhs.size() != rhs.size())
+					return false;
+
+				for (const value_type& e : lhs) {
+					const size_t i = rhs.FindIndex(Policy::KeyOf(e));
+					if (i == NotFound || !(rhs.storage.slots[i] == e))
+						return false;
+				}
+				return true;
+			}
+
+			friend bool	operator !=(const FlatHashTable& lhs, const FlatHashTable& rhs)
+			{
+				return !(lhs == rhs);
+			}
+		};
+
+	}	// namespace FlatHashDetails
+
+
+
+	/// Hash set of open addressing: elements are stored in a flat array, probed in groups - see FlatHashDetails.
+	/// Interface follows std::unordered_set (as far as the library and usual clients need it), with C++20 heterogeneous lookup.
+	/// @remarks
+	///		Any insertion may move the elements, invalidating all iterators and references.
+	///		Erasure invalidates only the erased ones.
+	template <class V, class Hash = std::hash<V>, class KeyEqual = std::equal_to<V>, class Alloc = std::allocator<V>>
+	class FlatHashSet : public FlatHashDetails::FlatHashTable<FlatHashDetails::SetPolicy<V>, Hash, KeyEqual, Alloc> {
+		using Base = FlatHashDetails::FlatHashTable<FlatHashDetails::SetPolicy<V>, Hash, KeyEqual, Alloc>;
+
+	public:
+		using typename Base::iterator;
+		using typename Base::const_iterator;
+
+		using Base::Base;
+
+		FlatHashSet()
+		{
+		}
+
+		FlatHashSet(std::initializer_list<V> init, size_t capacity = 0, const Hash& hash = Hash {}, const KeyEqual& equal = KeyEqual {}, const Alloc& alloc = Alloc {})
+			: Base(capacity, hash, equal, alloc)
+		{
+			insert(init.begin(), init.end());
+		}
+
+		template <class It, class = typename std::iterator_traits<It>::iterator_category>
+		FlatHashSet(It first, It last, size_t capacity = 0, const Hash& hash = Hash {}, const KeyEqual& equal = KeyEqual {}, const Alloc& alloc = Alloc {})
+			: Base(capacity, hash, equal, alloc)
+		{
+			insert(first, last);
+		}
+
+
+		std::pair<iterator, bool>	insert(const V& value)	{ return this->EmplaceUnique(value, value); }
+		std::pair<iterator, bool>	insert(V&& value)		{ return this->EmplaceUnique(value, std::move(value)); }
+
+		template <class... Args>
+		std::pair<iterator, bool>	emplace(Args&&... args)
+		{
+			V value (std::forward<Args>(args)...);
+			return insert(std::move(value));
+		}
+
+		template <class It>
+		void	insert(It first, It last)
+		{
+			for (; first != last; ++first)
+				insert(*first);
+		}
+
+		void	insert(std::initializer_list<V> init)
+		{
+			insert(init.begin(), init.end());
+		}
+	};
+
+
+
+	/// Hash map of open addressing: key-value pairs are stored in a flat array, probed in groups - see FlatHashDetails.
+	/// Interface follows std::unordered_map (as far as the library and usual clients need it), with C++20 heterogeneous lookup.
+	/// @remarks
+	///		Any insertion may move the elements, invalidating all iterators and references.
+	///		Erasure invalidates only the erased ones.
+	template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>, class Alloc = std::allocator<std::pair<const K, V>>>
+	class FlatHashMap : public FlatHashDetails::FlatHashTable<FlatHashDetails::MapPolicy<K, V>, Hash, KeyEqual, Alloc> {
+		using Base = FlatHashDetails::FlatHashTable<FlatHashDetails::MapPolicy<K, V>, Hash, KeyEqual, Alloc>;
+
+	public:
+		using mapped_type = V;
+		using typename Base::value_type;
+		using typename Base::iterator;
+		using typename Base::const_iterator;
+
+		using Base::Base;
+
+		FlatHashMap()
+		{
+		}
+
+		FlatHashMap(std::initializer_list<value_type> init, size_t capacity = 0, const Hash& hash = Hash {}, const KeyEqual& equal = KeyEqual {}, const Alloc& alloc = Alloc {})
+			: Base(capacity, hash, equal, alloc)
+		{
+			insert(init.begin(), init.end());
+		}
+
+		template <class It, class = typename std::iterator_traits<It>::iterator_category>
+		FlatHashMap(It first, It last, size_t capacity = 0, const Hash& hash = Hash {}, const KeyEqual& equal = KeyEqual {}, const Alloc& alloc = Alloc {})
+			: Base(capacity, hash, equal, alloc)
+		{
+			insert(first, last);
+		}
+
+
+		template <class... Args>
+		std::pair<iterator, bool>	try_emplace(const K& key, Args&&... args)
+		{
+			return this->EmplaceUnique(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template <class... Args>
+		std::pair<iterator, bool>	try_emplace(K&& key, Args&&... args)
+		{
+			return this->EmplaceUnique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		std::pair<iterator, bool>	insert(const value_type& value)	{ return this->EmplaceUnique(value.first, value); }
+		std::pair<iterator, bool>	insert(value_type&& value)		{ return this->EmplaceUnique(value.first, std::move(value)); }
+
+		template <class P, class = std::enable_if_t<std::is_constructible<value_type, P&&>::value>>
+		std::pair<iterator, bool>	insert(P&& value)				{ return emplace(std::forward<P>(value)); }
+
+		template <class... Args>
+		std::pair<iterator, bool>	emplace(Args&&... args)
+		{
+			value_type value (std::forward<Args>(args)...);
+			return insert(std::move(value));
+		}
+
+		template <class M>
+		std::pair<iterator, bool>	insert_or_assign(const K& key, M&& mapped)
+		{
+			auto res = try_emplace(key, std::forward<M>(mapped));
+			if (!res.second)
+				res.first->second = std::forward<M>(mapped);
+			return res;
+		}
+
+		template <class It>
+		void	insert(It first, It last)
+		{
+			for (; first != last; ++first)
+				insert(*first);
+		}
+
+
+		V&			operator [](const K& key)	{ return try_emplace(key).first->second; }
+		V&			operator [](K&& key)		{ return try_emplace(std::move(key)).first->second; }
+
+		V&			at(const K& key)
+		{
+			auto it = this->find(key);
+			if (it == this->end())
+				throw std::out_of_range("FlatHashMap has no such key.");
+			return it->second;
+		}
+
+		const V&	at(const K& key) const
+		{
+			return const_cast<FlatHashMap&>(*this).at(key);
+		}
+	};
+
+
+}	// namespace Def
+
+
+using Def::FlatHashSet;
+using Def::FlatHashMap;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_FLATHASH_HPP
@@ -0,0 +1,140 @@
+#ifndef ENUMERABLES_HUGEPAGES_HPP
+#define ENUMERABLES_HUGEPAGES_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the allocator of ENUMERABLES_USE_HUGEPAGES:								  *
+	 *		- HugePageAllocator:	backs large blocks by transparent huge pages					  *
+	 *																								  *
+	 *  Included by Enumerables_ConfigDefaults.hpp if ENUMERABLES_USE_HUGEPAGES, otherwise			  *
+	 *  can be included after Enumerables_ConfigDefaults.hpp for the allocator alone.				  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#	include <sys/mman.h>
+#endif
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	using std::size_t;
+
+
+	/// Standard allocator serving blocks of at least ENUMERABLES_HUGEPAGE_THRESHOLD bytes aligned to 2 MB huge pages,
+	/// smaller ones by std::allocator.
+	/// @remarks
+	///		Large blocks are rounded up to whole huge pages, then on Linux advised by madvise(MADV_HUGEPAGE)
+	///		so that transparent huge pages can back them - unless disabled system-wide ("never" mode).
+	///		Elsewhere they only get aligned: e.g. Windows requires a privilege for large pages.
+	///		Stateless: any instances are interchangeable.
+	template <class T>
+	class HugePageAllocator {
+	public:
+		using value_type = T;
+
+		static constexpr size_t PageSize  = size_t(2) << 20;
+		static constexpr size_t Threshold = ENUMERABLES_HUGEPAGE_THRESHOLD;
+
+		static_assert (alignof(T) <= PageSize, "Huge pages cannot satisfy the alignment of T.");
+
+	private:
+		static size_t	PageBytes(size_t n)
+		{
+			const size_t bytes = n * sizeof(T);
+			return (bytes + PageSize - 1) / PageSize * PageSize;
+		}
+
+		static bool		IsLarge(size_t n)
+		{
+			return n * sizeof(T) >= Threshold;
+		}
+
+#if defined(__cpp_aligned_new)
+		static void*	AllocateAligned(size_t bytes)				{ return ::operator new(bytes, std::align_val_t { PageSize }); }
+		static void		DeallocateAligned(void* block, size_t bytes)	{ ::operator delete(block, bytes, std::align_val_t { PageSize }); }
+#else
+		// Pre-C++17: over-allocate, then align by hand - the original address is kept just below the aligned block.
+		static void*	AllocateAligned(size_t bytes)
+		{
+			void*		raw		= ::operator new(bytes + PageSize + sizeof(void*));
+			const auto	address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+			void*		block	= reinterpret_cast<void*>((address + PageSize - 1) / PageSize * PageSize);
+
+			static_cast<void**>(block)[-1] = raw;
+			return block;
+		}
+
+		static void		DeallocateAligned(void* block, size_t)
+		{
+			::operator delete(static_cast<void**>(block)[-1]);
+		}
+#endif
+
+		static void		Advise(void* block, size_t bytes)
+		{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+			::madvise(block, bytes, MADV_HUGEPAGE);			// merely a hint: failure leaves regular pages
+#else
+			(void)block;
+			(void)bytes;
+#endif
+		}
+
+	public:
+		HugePageAllocator() noexcept = default;
+
+		template <class U>
+		HugePageAllocator(const HugePageAllocator<U>&) noexcept
+		{
+		}
+
+
+		T*		allocate(size_t n)
+		{
+			if (n > ((std::numeric_limits<size_t>::max)() - 2 * PageSize) / sizeof(T))
+				throw std::bad_array_new_length();
+
+			if (!IsLarge(n))
+				return std::allocator<T>().allocate(n);
+
+			const size_t bytes = PageBytes(n);
+			void*		 block = AllocateAligned(bytes);
+			Advise(block, bytes);
+			return static_cast<T*>(block);
+		}
+
+		void	deallocate(T* p, size_t n) noexcept
+		{
+			if (IsLarge(n))
+				DeallocateAligned(p, PageBytes(n));
+			else
+				std::allocator<T>().deallocate(p, n);
+		}
+
+
+		template <class U>
+		bool	operator ==(const HugePageAllocator<U>&) const noexcept	{ return true; }
+		template <class U>
+		bool	operator !=(const HugePageAllocator<U>&) const noexcept	{ return false; }
+	};
+
+
+}	// namespace Def
+
+
+using Def::HugePageAllocator;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_HUGEPAGES_HPP
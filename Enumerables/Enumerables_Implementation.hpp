@@ -25,6 +25,7 @@
 #endif
 
 #include "Enumerables_Interface.hpp"
+#include "Enumerables_Simd.hpp"
 
 
 #define ENUMERABLES_STRINGIFY_EVALD(x)		#x
@@ -242,6 +243,26 @@ namespace Def {
 	}
 
 
+	template <class Ops, class Cont, class = void>
+	struct HasFinalize : std::false_type {};
+
+	template <class Ops, class Cont>
+	struct HasFinalize<Ops, Cont, void_t<decltype(Ops::Finalize(declval<Cont&>()))>> : std::true_type {};
+
+
+	/// Let the binding complete a container after all Adds - e.g. sort appended elements at once.
+	template <class Ops, class Cont, enable_if_t<HasFinalize<Ops, Cont>::value, int> = 0>
+	void	Finalize(Cont& target)
+	{
+		Ops::Finalize(target);
+	}
+
+	template <class Ops, class Cont, enable_if_t<!HasFinalize<Ops, Cont>::value, int> = 0>
+	void	Finalize(Cont&)
+	{
+	}
+
+
 	// Build a Dictionary via 2 mapper functions, use Cache if available.
 	// (Core idea follows ObtainCachedResults.)
 	template <class K, class V, class Source, class KeyMapper, class ValMapper, class... Options>
@@ -256,6 +277,7 @@ namespace Def {
 			K key = toKey(Revive(elem));
 			DictOperations::Add(res, move(key), toValue(PassRevived(elem)));
 		}
+		Finalize<DictOperations>(res);
 		return res;
 	}
 
@@ -273,6 +295,7 @@ namespace Def {
 			K      key  = toKey(elem);
 			DictOperations::Add(res, move(key), toValue(forward<decltype(elem)>(elem)));
 		}
+		Finalize<DictOperations>(res);
 		return res;
 	}
 
@@ -476,10 +499,67 @@ namespace Def {
 	}
 
 
-	template <class TFactory>
-	bool AutoEnumerable<TFactory>::AllEqual() const
+	// contiguous scalar sources are searched by vectorized kernels
+	template <CompareOp Op, class Et, class V, enable_if_t<IsVectorEquatable<Et, V>::value, int> = 0>
+	Optional<size_t>	FindEnumerated(Et& et, const V& val)
 	{
-		auto et = GetEnumerator();
+		const auto	 values = StridedView<Et>::Get(et);
+		const size_t i		= VectorFind<Op>(values, val);
+		if (i < values.count)
+			return i;
+
+		return NoValue<size_t>(StopReason::Empty);
+	}
+
+
+	/// Index of the first element which is (Equal) or is not (NotEqual) == val.
+	template <CompareOp Op, class Et, class V, enable_if_t<!IsVectorEquatable<Et, V>::value, int> = 0>
+	Optional<size_t>	FindEnumerated(Et& et, const V& val)
+	{
+		static_assert (Op == CompareOp::Equal || Op == CompareOp::NotEqual, "Only equality is searched.");
+
+		for (size_t i = 0; et.FetchNext(); ++i) {
+			const bool equal = et.Current() == val;
+			if (equal == (Op == CompareOp::Equal))
+				return i;
+		}
+		return NoValue<size_t>(StopReason::Empty);
+	}
+
+
+	template <class Et, class V, enable_if_t<IsVectorEquatable<Et, V>::value, int> = 0>
+	size_t	CountEnumerated(Et& et, const V& val)
+	{
+		return VectorCount(StridedView<Et>::Get(et), val);
+	}
+
+
+	template <class Et, class V, enable_if_t<!IsVectorEquatable<Et, V>::value, int> = 0>
+	size_t	CountEnumerated(Et& et, const V& val)
+	{
+		size_t count = 0;
+		while (et.FetchNext()) {
+			if (et.Current() == val)
+				count++;
+		}
+		return count;
+	}
+
+
+	template <class Et, enable_if_t<IsVectorEquatable<Et, ViewedValueT<Et>>::value, int> = 0>
+	bool	AllEqualEnumerated(Et& et)
+	{
+		const auto values = StridedView<Et>::Get(et);
+		return values.count < 2
+			|| VectorFind<CompareOp::NotEqual>(values.Slice(1, values.count - 1), values[0]) == values.count - 1;
+	}
+
+
+	template <class Et, enable_if_t<!IsVectorEquatable<Et, ViewedValueT<Et>>::value, int> = 0>
+	bool	AllEqualEnumerated(Et& et)
+	{
+		using TElem = EnumeratedT<Et>;
+
 		if (!et.FetchNext())
 			return true;
 
@@ -493,37 +573,44 @@ namespace Def {
 	}
 
 
-	// https://en.wikipedia.org/wiki/2Sum
-	//template <class S>
-	//void  Sum2(S& sum, const S& n, S& error)
-	//{
-	//	const S s0 = sum;
-	//	sum += n;
-	//	const S diff1 = s0 - (sum - n);
-	//	const S diff2 = n - (sum - s0);
-	//	error += diff1 + diff2;
-	//}
+	template <class TFactory>
+	bool AutoEnumerable<TFactory>::AllEqual() const
+	{
+		auto et = GetEnumerator();
+		return AllEqualEnumerated(et);
+	}
 
 
-	// https://en.wikipedia.org/wiki/Kahan_summation_algorithm
-	// Simple Kahan isn't appropriate since we have no assumptions about magnitudes!
-	// Neurmaier seems to perform slightly better on a current CPU, while slightly worse on an old one.
-	// Neither gives perfect results - Neumaier is the current choice.
-	template <class S>
-	void   NeumaierSum2(S& sum, const S& b, S& error)
+	template <class TFactory>
+	template <class R>
+	bool AutoEnumerable<TFactory>::AllEqual(const R& rhs) const
 	{
-		const S s0 = sum;
-		sum += b;
+		auto et = GetEnumerator();
+		return !FindEnumerated<CompareOp::NotEqual>(et, rhs).HasValue();
+	}
 
-		// for growing sums, first branch should be continuously predicted with success
-		if (abs(s0) >= abs(b)) {
-			const S diffB = b - (sum - s0);
-			error += diffB;
-		}
-		else {
-			const S diffA = s0 - (sum - b);
-			error += diffA;
-		}
+
+	template <class TFactory>
+	bool AutoEnumerable<TFactory>::Contains(TElemConstParam val) const
+	{
+		auto et = GetEnumerator();
+		return FindEnumerated<CompareOp::Equal>(et, val).HasValue();
+	}
+
+
+	template <class TFactory>
+	size_t AutoEnumerable<TFactory>::Count(TElemConstParam val) const
+	{
+		auto et = GetEnumerator();
+		return CountEnumerated(et, val);
+	}
+
+
+	template <class TFactory>
+	Optional<size_t> AutoEnumerable<TFactory>::IndexOf(TElemConstParam val) const
+	{
+		auto et = GetEnumerator();
+		return FindEnumerated<CompareOp::Equal>(et, val);
 	}
 
 
@@ -565,12 +652,77 @@ namespace Def {
 	}
 
 
+	// contiguous arithmetic sources are summed by vectorized kernels
+	template <class S, class Et, enable_if_t<IsVectorSummable<S, Et>::value, int> = 0>
+	S SumElements(Et& etor)
+	{
+		return VectorSum<S>(etor);
+	}
+
+
+	// placeholder expressions over contiguous sources are evaluated by blocks
+	template <class S, class Et, enable_if_t<!IsVectorSummable<S, Et>::value && IsFusedSummable<S, Et>::value, int> = 0>
+	S SumElements(Et& etor)
+	{
+		return FusedSum<S>(etor);
+	}
+
+
+	// products of two contiguous sources zipped are summed in a single pass
+	template <class S, class Et, enable_if_t<!IsVectorSummable<S, Et>::value && IsDotSummable<S, Et>::value, int> = 0>
+	S SumElements(Et& etor)
+	{
+		return DotSum<S>(etor);
+	}
+
+
+	template <class S, class Et, enable_if_t<!IsVectorSummable<S, Et>::value && !IsFusedSummable<S, Et>::value
+											 && !IsDotSummable<S, Et>::value, int> = 0>
+	S SumElements(Et& etor)
+	{
+		return SumEnumerated<S>(etor);
+	}
+
+
 	template <class TFactory>
 	template <class S>
 	S	AutoEnumerable<TFactory>::Sum() const
 	{
 		auto et = GetEnumerator();
-		return SumEnumerated<S>(et);
+		return SumElements<S>(et);
+	}
+
+
+
+	template <class S>
+	Optional<S>	CompensatedAverage(const CompensatedSum<S>& total, size_t count)
+	{
+		if (count) {
+			return total.sum / static_cast<S>(count)
+				 + total.err / static_cast<S>(count);
+		}
+		return NoValue<S>(StopReason::Empty);
+	}
+
+
+	template <class S, class Et, enable_if_t<IsVectorSummable<S, Et>::value, int> = 0>
+	Optional<S>	AverageElements(Et& etor)
+	{
+		const auto span = StridedView<Et>::Get(etor);
+		return CompensatedAverage(KernelSum(span), span.count);
+	}
+
+
+	template <class S, class Et, enable_if_t<!IsVectorSummable<S, Et>::value, int> = 0>
+	Optional<S>	AverageElements(Et& etor)
+	{
+		size_t				count = 0;
+		CompensatedSum<S>	total;
+		while (etor.FetchNext()) {
+			++count;
+			total.Add(static_cast<S>(etor.Current()));
+		}
+		return CompensatedAverage(total, count);
 	}
 
 
@@ -581,45 +733,55 @@ namespace Def {
 	{
 		static_assert (std::is_floating_point<S>::value, "Intended for floating-point operations.");
 
-		auto	enumerator = GetEnumerator();
-		size_t	count = 0;
-		S		sum {};
-		S		err {};
-		while (enumerator.FetchNext()) {
-			++count;
-			NeumaierSum2(sum, static_cast<S>(enumerator.Current()), err);
-		}
-		if (count) {
-			return sum / static_cast<S>(count)
-				 + err / static_cast<S>(count);
-		}
-		return NoValue<S>(StopReason::Empty);
+		auto enumerator = GetEnumerator();
+		return AverageElements<S>(enumerator);
 	}
 
 
 
-	// Formerly: ToReferenced().Minimums().First(), but let's be more lightweigth.
-	template<class TFactory>
-	template<class Comp>
-	auto AutoEnumerable<TFactory>::Min(const Comp& isLess) const -> Optional<TElemDecayed>
+	// contiguous arithmetic sources are searched by vectorized kernels
+	template <class R, class Et, class Comp, enable_if_t<IsVectorSeekable<Et, Comp>::byElement, int> = 0>
+	Optional<R>	MinEnumerated(Et& et, const Comp& isLess)
 	{
-		const auto& isLessLambda = BinPred(isLess);
+		const auto values = StridedView<Et>::Get(et);
+		if (values.count == 0)
+			return NoValue<R>(StopReason::Empty);
+
+		return static_cast<R>(VectorExtreme(values, isLess));
+	}
+
+
+	template <class R, class Et, class Comp, enable_if_t<!IsVectorSeekable<Et, Comp>::byElement, int> = 0>
+	Optional<R>	MinEnumerated(Et& et, const Comp& isLess)
+	{
+		using TElem = EnumeratedT<Et>;
 
-		auto et = GetEnumerator();
 		if (!et.FetchNext())
-			return NoValue<TElemDecayed>(StopReason::Empty);
+			return NoValue<R>(StopReason::Empty);
 
 		Reassignable<TElem> min = et.Current();
 
 		while (et.FetchNext()) {
 			TElem curr = et.Current();
-			if (isLessLambda(curr, *min))
+			if (isLess(curr, *min))
 				min.AssignHeadMoved(curr);
 		}
 		return min.PassValue();
 	}
 
 
+	// Formerly: ToReferenced().Minimums().First(), but let's be more lightweigth.
+	template<class TFactory>
+	template<class Comp>
+	auto AutoEnumerable<TFactory>::Min(const Comp& isLess) const -> Optional<TElemDecayed>
+	{
+		const auto& isLessLambda = BinPred(isLess);
+
+		auto et = GetEnumerator();
+		return MinEnumerated<TElemDecayed>(et, isLessLambda);
+	}
+
+
 	template<class TFactory>
 	template<class Comp>
 	auto AutoEnumerable<TFactory>::Max(const Comp& isLess) const -> Optional<TElemDecayed>
@@ -677,7 +839,6 @@ namespace Def {
 
 	template <class TFactory>
 	template <size_t N, class... Options>
-	ENUMERABLES_WARN_FOR_SMALLLIST
 	auto AutoEnumerable<TFactory>::ToList(size_t sizeHint) const -> SmallListType<TElemDecayed, N, Options...>
 	{
 		TEnumerator etor = GetEnumeratorNoDebug();
@@ -686,7 +847,6 @@ namespace Def {
 
 	template <class TFactory>
 	template <size_t N, class... Options>
-	ENUMERABLES_WARN_FOR_SMALLLIST
 	auto AutoEnumerable<TFactory>::ToList(size_t sizeHint, const Options&... opts) const -> SmallListType<TElemDecayed, N, Options...>
 	{
 		TEnumerator etor = GetEnumeratorNoDebug();
@@ -764,7 +924,7 @@ namespace Def {
 
 
 	template<class TFactory>
-	template<class... Options, class TKeyMapper, class TValueMapper, enable_if_t<!is_convertible<TValueMapper, size_t>::value, int>>
+	template<class... Options, class TKeyMapper, class TValueMapper, enable_if_t<!IsContainerParam<TValueMapper>::value, int>>
 	auto AutoEnumerable<TFactory>::ToDictionary(const TKeyMapper& toKey, const TValueMapper& toValue, size_t hint) const
 		-> DictionaryType<DecayedResultLV<TKeyMapper>,
 						  DecayedResult<TValueMapper>,
@@ -779,7 +939,7 @@ namespace Def {
 	}
 
 	template<class TFactory>
-	template<class... Options, class TKeyMapper, class TValueMapper, enable_if_t<!is_convertible<TValueMapper, size_t>::value, int>>
+	template<class... Options, class TKeyMapper, class TValueMapper, enable_if_t<!IsContainerParam<TValueMapper>::value, int>>
 	auto AutoEnumerable<TFactory>::ToDictionary(const TKeyMapper& toKey, const TValueMapper& toValue, size_t hint, const Options&... opts) const
 		-> DictionaryType<DecayedResultLV<TKeyMapper>,
 						  DecayedResult<TValueMapper>,
@@ -812,6 +972,34 @@ namespace Def {
 	}
 
 
+#if ENUMERABLES_USE_PMR
+
+	template <class TFactory>
+	auto AutoEnumerable<TFactory>::ToList(std::pmr::memory_resource* resource, size_t sizeHint) const -> ListType<TElemDecayed>
+	{
+		PmrBinding::ResourceScope scope { resource };
+		return ToList(sizeHint);
+	}
+
+	template <class TFactory>
+	auto AutoEnumerable<TFactory>::ToSet(std::pmr::memory_resource* resource, size_t sizeHint) const -> SetType<TElemDecayed>
+	{
+		PmrBinding::ResourceScope scope { resource };
+		return ToSet(sizeHint);
+	}
+
+	template<class TFactory>
+	template<class TKeyMapper>
+	auto AutoEnumerable<TFactory>::ToDictionary(const TKeyMapper& toKey, std::pmr::memory_resource* resource, size_t hint) const
+		-> DictionaryType<DecayedResultLV<TKeyMapper>, TElemDecayed>
+	{
+		PmrBinding::ResourceScope scope { resource };
+		return ToDictionary(toKey, hint);
+	}
+
+#endif
+
+
 	template <class TFactory>
 	template <class V>
 	auto AutoEnumerable<TFactory>::ToMaterialized() const
@@ -830,10 +1018,11 @@ namespace Def {
 		// actually this works for prvalues too, but is wasteful!
 		static_assert (is_reference<TElem>::value, "For by-value enumerations use ToMaterialized instead!");
 
-		using S = StorableT<TElem>;
+		using S		 = StorableT<TElem>;
+		using Caches = CacheArena<TEnumerator>;		// from the arena of WithArena chains - must outlive the snapshot then
 
 		TEnumerator etor = GetEnumeratorNoDebug();
-		auto		list = ObtainCachedResults<ListOperations, S>(etor, 0u);
+		auto		list = Caches { factory }.template Obtain<ListOperations, S, typename Caches::template ListT<S>>(etor);
 
 		return Enumerate<const S&>(move(list))
 				 .Map([](const S& sv) -> TElem { return Revive(sv); });
@@ -994,10 +1183,13 @@ namespace Def {
 	template <class V, class Factory>
 	void ResultBuffer<T>::Fill(Factory& getEnumerator, bool isPure, bool autoCall, enable_if_t<is_copy_constructible<V>::value>*)
 	{
-#	if !(ENUMERABLES_RESULTSVIEW_AUTO_EVAL & 4)
-		if (autoCall && (GetSize(Elements) > 0 || Status[0] == 'E'))
+		if (!Claim(autoCall))
 			return;
-#	endif
+
+		struct Release {
+			std::atomic<char>& state;
+			~Release()	{ state.store(Done); }
+		} release { state };
 
 		if (!isPure) {
 			Status = "Not available - enumeration is marked as having side-effects.";
@@ -1020,11 +1212,11 @@ namespace Def {
 
 		SizeInfo display = si.Limit(ENUMERABLES_RESULTSVIEW_MAX_ELEMS);
 		size_t   cap     = display.IsExact() ? display.value : 0u;
-		Elements = SmallListOperations::template Init<decltype(Elements)>(cap);
+		Elements = ListOperations::template Init<decltype(Elements)>(cap);
 
 		size_t count = 0;
 		while (et.FetchNext() && count < ENUMERABLES_RESULTSVIEW_MAX_ELEMS) {
-			SmallListOperations::Add(Elements, et.Current());
+			ListOperations::Add(Elements, et.Current());
 			++count;
 		}
 		Status = count < ENUMERABLES_RESULTSVIEW_MAX_ELEMS
@@ -1037,7 +1229,11 @@ namespace Def {
 	void ResultBuffer<T>::Fill(Factory&, bool isPure, bool autoCall, enable_if_t<!is_copy_constructible<V>::value>*)
 	{
 		ENUMERABLES_INTERNAL_ASSERT (!isPure);
+		if (!Claim(autoCall))
+			return;
+
 		Status = "Not available for this type.";
+		state.store(Done);
 		if (!autoCall)
 			ENUMERABLES_CLIENT_BREAK ("Unsupported type - cannot build debug buffer.");
 	}
@@ -1073,6 +1269,14 @@ namespace Def {
 
 
 
+#include "Enumerables_Parallel.hpp"
+#include "Enumerables_Vectorized.hpp"
+
+#if ENUMERABLES_USE_MULTIPROCESS
+#	include "Enumerables_MultiProcess.hpp"
+#endif
+
+
 #undef ENUMERABLES_STRINGIFY_EVALD
 #undef ENUMERABLES_STRINGIFY
 
@@ -50,6 +50,7 @@
 #include "Enumerables_ChainTool.hpp"
 #include "Enumerables_ConfigDefaults.hpp"
 #include "Enumerables_Enumerators.hpp"
+#include <atomic>
 #include <functional>
 
 
@@ -104,6 +105,33 @@ namespace Def {
 	template <class V>
 	using Enumerable = AutoEnumerable<std::function<InterfacedEnumerator<V> ()>>;
 
+	/// Splits the source of AsParallel() queries - see Enumerables_Parallel.hpp
+	template <class Source, class Etor = typename Source::TEnumerator, class = void>
+	struct PartitionerFor;
+
+	/// Prefetches its source as an executor task - see Enumerables_Parallel.hpp
+	template <class Source>
+	class BufferedEnumerator;
+
+	/// Enumerates nested sequences concurrently - see Enumerables_Parallel.hpp
+	template <class Source>
+	class ParallelFlattenerEnumerator;
+
+	/// Scheduler of concurrent operations - see Enumerables_Executors.hpp
+	class IExecutor;
+
+	template <class Seed, class Step, class Acc, class ForcedElem>
+	struct SequenceFactory;
+
+
+	/// Arguments of container creators that can follow a mapper function (thus are not a value mapper).
+	template <class T>
+	using IsContainerParam = std::integral_constant<bool, is_convertible<T, size_t>::value
+#	if ENUMERABLES_USE_PMR
+														  || is_convertible<T, std::pmr::memory_resource*>::value
+#	endif
+												   >;
+
 
 #if ENUMERABLES_USE_RESULTSVIEW
 
@@ -126,12 +154,53 @@ namespace Def {
 				"  See ENUMERABLES_RESULTSVIEW_AUTO_EVAL.";
 #			endif
 
-		SmallListType<TDebugValue, 4>	Elements;
+		ListType<TDebugValue>			Elements;
 
 		template <class V = TDebugValue, class Factory>
 		void Fill(Factory& getEnumerator, bool isPure, bool autoCall, enable_if_t<is_copy_constructible<V>::value>* = nullptr);
 		template <class V = TDebugValue, class Factory>
 		void Fill(Factory& getEnumerator, bool isPure, bool autoCall, enable_if_t<!is_copy_constructible<V>::value>* = nullptr);
+
+
+		ResultBuffer() = default;
+		ResultBuffer(const ResultBuffer& src)				{ Take(src); }
+		ResultBuffer(ResultBuffer&& src)					{ Take(move(src)); }
+		ResultBuffer& operator =(const ResultBuffer& src)	{ Take(src);	   return *this; }
+		ResultBuffer& operator =(ResultBuffer&& src)		{ Take(move(src)); return *this; }
+
+	private:
+		enum : char { Pending, Busy, Done };
+
+		// Only the thread claiming the buffer touches it - keeps const AutoEnumerables enumerable concurrently.
+		mutable std::atomic<char>	state { Pending };
+
+		/// Claim for evaluation. Auto-calls are satisfied by any earlier attempt, unless re-evaluation is configured.
+		bool Claim(bool autoCall)
+		{
+			char expected = Pending;
+			if (state.compare_exchange_strong(expected, Busy))
+				return true;
+
+#		if !(ENUMERABLES_RESULTSVIEW_AUTO_EVAL & 4)
+			if (autoCall)
+				return false;
+#		endif
+			return expected == Done && state.compare_exchange_strong(expected, Busy);
+		}
+
+		/// Take evaluated results, unless busy in another thread.
+		template <class Buffer>
+		void Take(Buffer&& src)
+		{
+			char expected = Done;
+			if (!src.state.compare_exchange_strong(expected, Busy))
+				return;
+
+			Status	 = src.Status;
+			Elements = forward<Buffer>(src).Elements;
+			src.state.store(Done);
+			state.store(Done);
+		}
 	};
 
 #endif
@@ -154,6 +223,86 @@ namespace TypeHelpers {
 		static constexpr bool value = true;
 	};
 
+
+
+	/// Pointer to a member function which cannot be called on const objects.
+	template <class M>
+	struct IsMutatingMember : std::false_type {};
+
+	template <class R, class C, class... Args>	struct IsMutatingMember<R (C::*)(Args...)>	  : std::true_type {};
+	template <class R, class C, class... Args>	struct IsMutatingMember<R (C::*)(Args...) &>  : std::true_type {};
+	template <class R, class C, class... Args>	struct IsMutatingMember<R (C::*)(Args...) &&> : std::true_type {};
+#if defined(__cpp_noexcept_function_type)
+	template <class R, class C, class... Args>	struct IsMutatingMember<R (C::*)(Args...) noexcept>	  : std::true_type {};
+	template <class R, class C, class... Args>	struct IsMutatingMember<R (C::*)(Args...) & noexcept>  : std::true_type {};
+	template <class R, class C, class... Args>	struct IsMutatingMember<R (C::*)(Args...) && noexcept> : std::true_type {};
+#endif
+
+
+	/// F has a single, non-const call operator - e.g. a mutable lambda.
+	template <class F, class = void>
+	struct HasMutatingCallOperator : std::false_type {};
+
+	template <class F>
+	struct HasMutatingCallOperator<F, void_t<decltype(&F::operator())>> : IsMutatingMember<decltype(&F::operator())> {};
+
+
+	/// F can be invoked concurrently via const&, without mutating shared state. Customization point.
+	/// @remarks
+	///		The library invokes stored callables only as const. Callables with a non-const call operator (mutable lambdas)
+	///		are rejected, the rest is trusted by default - they still shouldn't mutate captured state (by reference,
+	///		or via mutable members), which cannot be detected. Overloaded and template call operators are not examined.
+	///		Factories built by the library are composed of their parts, but type-erased ones cannot be verified.
+	///		Specialize for types known to be safe or unsafe.
+	template <class F>
+	struct IsConcurrencySafe
+	{
+		static constexpr bool value = !HasMutatingCallOperator<F>::value;
+	};
+
+	template <class Signature>
+	struct IsConcurrencySafe<std::function<Signature>>
+	{
+		static constexpr bool value = false;
+	};
+
+	template <class... Parts>
+	struct IsConcurrencySafe<std::tuple<Parts...>>
+	{
+		static constexpr bool value = std::conjunction<IsConcurrencySafe<std::decay_t<Parts>>...>::value;
+	};
+
+	template <class... Args>
+	struct IsConcurrencySafe<Def::ArgStorage<Args...>>
+	{
+		static constexpr bool value = IsConcurrencySafe<std::tuple<Args...>>::value;
+	};
+
+	template <template <class...> class Et, class SourceFactory, class TArgs, class SteadyArgs, class... PureTypeArgs>
+	struct IsConcurrencySafe<Def::ChainedFactory<Et, SourceFactory, TArgs, SteadyArgs, PureTypeArgs...>>
+	{
+		static constexpr bool value = IsConcurrencySafe<std::tuple<SourceFactory, TArgs, SteadyArgs>>::value;
+	};
+
+	/// Arena is not thread-safe: neither its chains, nor anything chained after them can be enumerated concurrently.
+	template <class SourceFactory, class TArgs, class SteadyArgs, class... PureTypeArgs>
+	struct IsConcurrencySafe<Def::ChainedFactory<Def::ArenaEnumerator, SourceFactory, TArgs, SteadyArgs, PureTypeArgs...>>
+	{
+		static constexpr bool value = false;
+	};
+
+	template <template <class...> class Et, class SourceFactories, class TArgs, class SteadyArgs, class... PureTypeArgs>
+	struct IsConcurrencySafe<Def::JoinerChainedFactory<Et, SourceFactories, TArgs, SteadyArgs, PureTypeArgs...>>
+	{
+		static constexpr bool value = IsConcurrencySafe<std::tuple<SourceFactories, TArgs, SteadyArgs>>::value;
+	};
+
+	template <class Seed, class Step, class Acc, class ForcedElem>
+	struct IsConcurrencySafe<Def::SequenceFactory<Seed, Step, Acc, ForcedElem>>
+	{
+		static constexpr bool value = IsConcurrencySafe<std::decay_t<Step>>::value;
+	};
+
 }
 
 #pragma endregion
@@ -172,9 +321,11 @@ namespace Def {
 	///		Can be upgraded to Enumerable<V> on demand, which cuts the chain of template nesting
 	///		by producing interfaced IEnumerator<V>, and provides type-erasure for the factory too.
 	///		Practically immutable, as queries should be repeatable in general.
+	///		Const methods can be called concurrently - see Shareable() for the conditions.
 	template <class TFactory>
 	class AutoEnumerable {
-		template <class>	friend class AutoEnumerable;
+		template <class>				friend class AutoEnumerable;
+		template <class, class, class>	friend struct PartitionerFor;
 
 		/// Factory object of Enumerators. Serves as a direct container
 		/// for any dependencies, including nested (upstream) factories.
@@ -371,11 +522,10 @@ namespace Def {
 		template <class Mapper, class TPropOvrd = void>
 		static auto	ComparatorForProperty(Mapper& getProperty)
 		{
-			using CP = TElemConstParam;
-			return [prop = LambdaCreators::CustomMapper<CP, TPropOvrd>(forward<Mapper>(getProperty))](CP l, CP r) -> bool
-			{
-				return prop(l) < prop(r);
-			};
+			using CP   = TElemConstParam;
+			using Prop = decay_t<decltype(LambdaCreators::CustomMapper<CP, TPropOvrd>(forward<Mapper>(getProperty)))>;
+
+			return PropertyComparator<CP, Prop> { LambdaCreators::CustomMapper<CP, TPropOvrd>(forward<Mapper>(getProperty)) };
 		}
 
 
@@ -444,6 +594,28 @@ namespace Def {
 		AutoEnumerable	NonPure() &&		{ return { move(factory),  false }; }
 
 
+		/// This query, checked at compile time to be enumerable by multiple threads at once - without cloning.
+		/// @remarks
+		///		Contract of concurrent enumeration via const methods (GetEnumerator, for ( : ), terminal operations):
+		///		 - factories and the callables they store are invoked as const, while all state of enumeration
+		///		   is kept by the enumerators themselves
+		///		 - debug ResultsView gets evaluated once, by the first thread to claim it
+		///		 - the chain is composed of IsConcurrencySafe parts, thus contains no unverified type-erasure
+		///		   (like Enumerable<T>) - specialize the trait when that's known to be safe
+		///		The callables still must not mutate captured state, nor may the underlying containers change meanwhile.
+		const AutoEnumerable&	Shareable() const &
+		{
+			static_assert (IsConcurrencySafe<TFactory>::value, "The chain contains parts not known to be safe for concurrent enumeration.");
+			return *this;
+		}
+
+		AutoEnumerable			Shareable() &&
+		{
+			static_assert (IsConcurrencySafe<TFactory>::value, "The chain contains parts not known to be safe for concurrent enumeration.");
+			return move(*this);
+		}
+
+
 	// ----- Filtration / Truncation -------------------------------------------------------------------------------------------------
 
 		/// Elements satisfying the given predicate.
@@ -772,10 +944,15 @@ namespace Def {
 
 	// ----- Shorthands comparing to an element --------------------------------------------------------------------------------------
 
+		// NOTE: Contiguous sources of scalars are compared by vectorized kernels.
+
 		template <class R = TElemDecayed>
-		bool	AllEqual(const R& rhs)		  const   { return ToReferenced().All  (FUN(x, x == rhs)); }
-		bool	Contains(TElemConstParam val) const   { return ToReferenced().Any  (FUN(x, x == val)); }
-		size_t	Count	(TElemConstParam val) const   { return ToReferenced().Where(FUN(x, x == val)).Count(); }
+		bool				AllEqual(const R& rhs)		  const;
+		bool				Contains(TElemConstParam val) const;
+		size_t				Count	(TElemConstParam val) const;
+
+		/// Position of the first element equal to val.
+		Optional<size_t>	IndexOf	(TElemConstParam val) const;
 
 
 	// ----- Aggregating operations --------------------------------------------------------------------------------------------------
@@ -858,6 +1035,10 @@ namespace Def {
 		template <class S = TElemDecayed>		Optional<S>				Avg() const;
 		template <class S = TElemDecayed>		S						Sum() const;
 
+		/// Sum of products of paired elements with a second sequence, as long as both last. Evaluated in a single pass.
+		template <class S = TElemDecayed, class Eb2>
+		S	Dot(Eb2&& second) const		{ return ToReferenced().Zip(forward<Eb2>(second), std::multiplies<>()).template Sum<S>(); }
+
 	#pragma endregion
 
 
@@ -913,7 +1094,7 @@ namespace Def {
 		/// @param  toKey:	  TElem& -> Key   mapper function
 		/// @param  toValue:  TElem  -> Value mapper function
 		template <class... Options, class KeyMapper, class ValueMapper,
-				  enable_if_t<!is_convertible<ValueMapper, size_t>::value, int> = 0>
+				  enable_if_t<!IsContainerParam<ValueMapper>::value, int> = 0>
 		DictionaryType<DecayedResultLV<KeyMapper>,
 					   DecayedResult<ValueMapper>, Options...>	ToDictionary  (const KeyMapper& toKey, const ValueMapper& toValue, size_t sizeHint = 0) const;
 
@@ -945,7 +1126,7 @@ namespace Def {
 		DictionaryType<decay_t<K>, TElemDecayed, Options...>					ToDictionaryOf(LVOverloadTo<K>,  size_t sizeHint, const Options&...) const;
 
 
-		template <class... Options, class KeyMapper, class ValueMapper, enable_if_t<!is_convertible<ValueMapper, size_t>::value, int> = 0>
+		template <class... Options, class KeyMapper, class ValueMapper, enable_if_t<!IsContainerParam<ValueMapper>::value, int> = 0>
 		DictionaryType<DecayedResultLV<KeyMapper>,
 					   DecayedResult<ValueMapper>, Options...>	ToDictionary  (const KeyMapper&, const ValueMapper&, size_t sizeHint, const Options&...) const;
 
@@ -953,6 +1134,21 @@ namespace Def {
 		DictionaryType<decay_t<K>, decay_t<V>, Options...>		ToDictionaryOf(LVOverloadTo<K>,  OverloadTo<V>,      size_t sizeHint, const Options&...) const;
 
 
+#	if ENUMERABLES_USE_PMR
+			// ----- Overloads allocating from a memory resource -----
+
+		// NOTE: Containers created meanwhile by the PMR bindings allocate from the resource too (see PmrBinding::ResourceScope),
+		//		 so caches of the query (e.g. the buffer of Order) can still pass as results without copy.
+
+		ListType<TElemDecayed>		ToList(std::pmr::memory_resource* resource, size_t sizeHint = 0) const;
+
+		SetType<TElemDecayed>		ToSet(std::pmr::memory_resource* resource, size_t sizeHint = 0)  const;
+
+		template <class KeyMapper>
+		DictionaryType<DecayedResultLV<KeyMapper>, TElemDecayed>	ToDictionary(const KeyMapper& getKey, std::pmr::memory_resource* resource, size_t sizeHint = 0) const;
+#	endif
+
+
 
 		// ----- Lifetime tools ------------------------------------------------------------------------------------------------------
 
@@ -975,6 +1171,72 @@ namespace Def {
 
 		auto ToReferenced()	&& = delete;
 
+		/// Allocate the internal caches of subsequent operations (e.g. buffers of Order, MinimumsBy, Except, CloseWithFirst) from @p arena.
+		/// @remarks
+		///		The arena must outlive the enumerations of the query, it is not synchronized for concurrent ones:
+		///		the chain is rejected by Shareable() and AsParallel().
+		///		ToSnapshot caches from the arena too, so it must outlive the snapshot as well.
+		///		Results of terminal operations (ToList, ToSet...) are allocated as usual.
+		///		Caches with explicit Options (e.g. an allocator given to Except) keep them.
+		auto WithArena(Arena& arena) const &	{ return   Chain<ArenaEnumerator>(SteadyParams(&arena)); }
+		auto WithArena(Arena& arena) &&			{ return MvChain<ArenaEnumerator>(SteadyParams(&arena)); }
+
+	#pragma endregion
+
+
+	// =========== Parallel evaluation ===============================================================================================
+	#pragma region
+
+		/// Switch to a ParallelEnumerable: subsequent element-local operations are recorded, then
+		/// applied to contiguous chunks of this sequence, which get evaluated by terminal operations concurrently.
+		/// @remarks
+		///		Requires a partitionable source: random-access iterator range (e.g. Enumerate(vector)), Range,
+		///		IndexRange or a caching operation (e.g. Order, ToMaterialized) - which gets evaluated upfront.
+		///		Results of ordered operations (ToList, Min, Max) match the sequential ones.
+		///		Not available for chains WithArena().
+		///		Scheduled on DefaultExecutor(), unless specified by WithExecutor().
+		///		Implemented in Enumerables_Parallel.hpp.
+		auto AsParallel() const &;
+		auto AsParallel() &&;
+
+
+		/// Switch to a VectorizedEnumerable: subsequent Where and Select get evaluated block-at-a-time by terminal operations,
+		/// filtering by selection vectors of row indices and mapping whole blocks at once.
+		/// @remarks
+		///		Contiguous sources (and their data members) are read in place, others are enumerated into blocks first.
+		///		Each operation is invoked for a whole block before the next one, so callables must not rely on interleaving.
+		///		Block size is ENUMERABLES_VECTORIZED_BLOCK. AsSequential() continues with the regular interface.
+		///		Implemented in Enumerables_Vectorized.hpp.
+		auto Vectorized() const &;
+		auto Vectorized() &&;
+
+
+		/// Evaluate the preceding operations as a background task, prefetching at most @p capacity elements.
+		/// @remarks
+		///		Two-stage pipeline: the producer runs concurrently with the consumer, so they must not share unsynchronized state.
+		///		Exceptions of the producer are rethrown by FetchNext after the elements preceding them.
+		///		Abandoning the enumeration stops the producer before its next element.
+		/// @param executor:	DefaultExecutor() if null
+		auto Buffered(size_t capacity = 64, IExecutor* executor = nullptr) const &	{ return   Chain<BufferedEnumerator>(SteadyParams(capacity, executor)); }
+		auto Buffered(size_t capacity = 64, IExecutor* executor = nullptr) &&		{ return MvChain<BufferedEnumerator>(SteadyParams(capacity, executor)); }
+
+
+		/// Flattened sequence of sequences, enumerating up to @p maxInFlight nested ones concurrently on an executor.
+		/// @remarks
+		///		The outer sequence is enumerated by the consumer, the nested ones by tasks, which buffer their elements.
+		///		Preserved order yields the same sequence as Flatten(), FirstCome yields each element as soon as available.
+		///		Exceptions of nested enumerations are rethrown by FetchNext. Abandoning the enumeration cancels them.
+		/// @param executor:	DefaultExecutor() if null
+		auto FlattenParallel(size_t maxInFlight, FlattenOrder order = FlattenOrder::Preserved, IExecutor* executor = nullptr) const &
+		{
+			return Chain<ParallelFlattenerEnumerator>(SteadyParams(maxInFlight, order, executor));
+		}
+
+		auto FlattenParallel(size_t maxInFlight, FlattenOrder order = FlattenOrder::Preserved, IExecutor* executor = nullptr) &&
+		{
+			return MvChain<ParallelFlattenerEnumerator>(SteadyParams(maxInFlight, order, executor));
+		}
+
 	#pragma endregion
 
 
@@ -1284,13 +1546,49 @@ namespace Def {
 
 
 
+	/// Step of ascending Ranges.
+	struct RangeIncrement {
+		template <class V>
+		void operator ()(V& x) const	{ ++x; }
+	};
+
+	/// Step of descending Ranges.
+	struct RangeDecrement {
+		template <class V>
+		void operator ()(V& x) const	{ --x; }
+	};
+
+
+	/// Factories of Ranges expose their bounds (First, Length) to let them get partitioned.
+	template <class V, class Step>
+	struct RangeFactory {
+		using TValue = V;
+		using TStep  = Step;
+
+		V		start;
+		size_t	count;
+		Step	step;
+
+		const V&	First()	 const	{ return start; }
+		size_t		Length() const	{ return count; }
+
+		CounterEnumerator<SequenceEnumerator<V, Step, V>>  operator ()() const
+		{
+			auto startSeq = [this]() {
+				return SequenceEnumerator<V, Step, V> { start, step };
+			};
+			return { startSeq, FilterMode::TakeWhile, count };
+		}
+	};
+
+
 	/// Range of given length generated by operator++. [value capture only]
 	template <class V>
 	auto Range(V start, size_t count)
 	{
 		static_assert (!is_reference<V>::value, "Can't create Range of references!");
 
-		return Sequence<V>(move(start), [](V& x) { ++x; }).Take(count);
+		return WrapFactory(RangeFactory<V, RangeIncrement> { move(start), count, {} });
 	}
 
 
@@ -1310,7 +1608,7 @@ namespace Def {
 	{
 		static_assert (!is_reference<V>::value, "Can't create Range of references!");
 
-		return Sequence<V>(move(start), [](V& x) { --x; }).Take(count);
+		return WrapFactory(RangeFactory<V, RangeDecrement> { move(start), count, {} });
 	}
 
 
@@ -1342,6 +1640,48 @@ namespace Def {
 	}
 
 
+	template <class V, class Container>
+	struct IndexRangeFactory {
+		using TValue = V;
+		using TStep  = RangeIncrement;
+
+		const Container&  list;
+		RangeIncrement	  step;
+
+		V			First()	 const	{ return V {}; }
+		size_t		Length() const	{ return GetSize(list); }
+
+		CounterEnumerator<SequenceEnumerator<V, TStep, V>>  operator ()() const
+		{
+			auto startSeq = [this]() {
+				return SequenceEnumerator<V, TStep, V> { First(), step };
+			};
+			return { startSeq, FilterMode::TakeWhile, Length() };
+		}
+	};
+
+
+	template <class V, class Container>
+	struct RevIndexRangeFactory {
+		using TValue = V;
+		using TStep  = RangeDecrement;
+
+		const Container&  list;
+		RangeDecrement	  step;
+
+		V			First()	 const	{ return static_cast<V>(GetSize(list) - 1); }
+		size_t		Length() const	{ return GetSize(list); }
+
+		CounterEnumerator<SequenceEnumerator<V, TStep, V>>  operator ()() const
+		{
+			auto startSeq = [this]() {
+				return SequenceEnumerator<V, TStep, V> { First(), step };
+			};
+			return { startSeq, FilterMode::TakeWhile, Length() };
+		}
+	};
+
+
 	/// Indices of a sequence container queried at start of enumeration. [Ref capture]
 	/// @remarks	For a snapshot consider Range(list.size()).
 	template <class V = size_t, class Container>
@@ -1349,24 +1689,7 @@ namespace Def {
 	{
 		static_assert (!is_reference<V>::value, "Can't create Range of references!");
 
-		struct IndexRangeFactory {
-			const Container&  list;
-
-			auto operator ()() const
-			{
-				auto advance  = [](V& x) { ++x; };
-
-				using SeqGen  = SequenceEnumerator<V, decltype(advance)>;
-				auto startSeq = [&]()	{ return SeqGen { V {}, advance }; };
-
-				return CounterEnumerator<SeqGen> {
-					startSeq,
-					FilterMode::TakeWhile,
-					GetSize(list)
-				};
-			}
-		};
-		return WrapFactory(IndexRangeFactory { list });
+		return WrapFactory(IndexRangeFactory<V, Container> { list, {} });
 	}
 
 
@@ -1378,24 +1701,7 @@ namespace Def {
 	{
 		static_assert (!is_reference<V>::value, "Can't create Range of references!");
 
-		struct RevIndexRangeFactory {
-			const Container&  list;
-
-			auto operator ()() const
-			{
-				auto advance  = [](V& x) { --x; };
-
-				using SeqGen  = SequenceEnumerator<V, decltype(advance)>;
-				auto startSeq = [&]()	{ return SeqGen { static_cast<V>(GetSize(list) - 1), advance }; };
-
-				return CounterEnumerator<SeqGen> {
-					startSeq,
-					FilterMode::TakeWhile,
-					GetSize(list)
-				};
-			}
-		};
-		return WrapFactory(RevIndexRangeFactory { list });
+		return WrapFactory(RevIndexRangeFactory<V, Container> { list, {} });
 	}
 
 	#pragma endregion
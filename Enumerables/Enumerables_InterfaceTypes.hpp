@@ -9,6 +9,7 @@
 
 #include "Enumerables_ConfigDefaults.hpp"
 #include "Enumerables_TypeHelpers.hpp"
+#include <functional>
 
 
 
@@ -91,6 +92,16 @@ namespace Enumerables {
 
 
 
+	// ==== Concurrent merge order ===============================================
+
+	/// Order of elements merged from concurrently enumerated sequences.
+	enum class FlattenOrder : char {
+		Preserved,		// same as sequentially
+		FirstCome		// as soon as available
+	};
+
+
+
 	// ==== Indexed result =======================================================
 
 	/// An element with its ordinal number attached.
@@ -110,6 +121,327 @@ namespace Enumerables {
 
 
 
+	// ==== Simple predicates ====================================================
+
+	/// Predicates transparent to the library, e.g. Where(Greater(0) && Less(100)) or Where(Greater(&Point::x, 0.0)).
+	/// Filters of contiguous arithmetic data can evaluate them by vectorized kernels, unlike opaque lambdas.
+	namespace Predicates {
+
+		enum class CompareOp : char { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+
+
+		template <CompareOp Op>	struct Comparer;
+
+		template <> struct Comparer<CompareOp::Less>		 { template <class A, class B> static bool Apply(const A& a, const B& b) { return a <  b; } };
+		template <> struct Comparer<CompareOp::LessEqual>	 { template <class A, class B> static bool Apply(const A& a, const B& b) { return a <= b; } };
+		template <> struct Comparer<CompareOp::Greater>		 { template <class A, class B> static bool Apply(const A& a, const B& b) { return a >  b; } };
+		template <> struct Comparer<CompareOp::GreaterEqual> { template <class A, class B> static bool Apply(const A& a, const B& b) { return a >= b; } };
+		template <> struct Comparer<CompareOp::Equal>		 { template <class A, class B> static bool Apply(const A& a, const B& b) { return a == b; } };
+		template <> struct Comparer<CompareOp::NotEqual>	 { template <class A, class B> static bool Apply(const A& a, const B& b) { return a != b; } };
+
+
+		/// Projections of the compared element.
+		struct Itself {
+			template <class V>
+			const V&		operator ()(const V& v)		const	{ return v; }
+		};
+
+		template <class Mptr>
+		struct Field {
+			Mptr member;
+
+			template <class V>
+			decltype(auto)	operator ()(const V& obj)	const	{ return obj.*member; }
+		};
+
+
+		/// Compares the element, or a data member of it, to a constant.
+		template <CompareOp Op, class T, class Projection = Itself>
+		struct Comparison {
+			T			operand;
+			Projection	projection;
+
+			template <class V>
+			bool	operator ()(const V& v) const	{ return Comparer<Op>::Apply(projection(v), operand); }
+		};
+
+
+		template <class L, class R>
+		struct Conjunction {
+			L	lhs;
+			R	rhs;
+
+			template <class V>
+			bool	operator ()(const V& v) const	{ return lhs(v) && rhs(v); }
+		};
+
+
+		template <class L, class R>
+		struct Disjunction {
+			L	lhs;
+			R	rhs;
+
+			template <class V>
+			bool	operator ()(const V& v) const	{ return lhs(v) || rhs(v); }
+		};
+
+
+		template <class P>							struct IsSimplePredicate						: std::false_type {};
+		template <CompareOp Op, class T, class Pr>	struct IsSimplePredicate<Comparison<Op, T, Pr>>	: std::true_type  {};
+		template <class L, class R>					struct IsSimplePredicate<Conjunction<L, R>>		: std::true_type  {};
+		template <class L, class R>					struct IsSimplePredicate<Disjunction<L, R>>		: std::true_type  {};
+
+
+		template <class L, class R, class = std::enable_if_t<IsSimplePredicate<L>::value && IsSimplePredicate<R>::value>>
+		Conjunction<L, R>	operator &&(const L& lhs, const R& rhs)		{ return { lhs, rhs }; }
+
+		template <class L, class R, class = std::enable_if_t<IsSimplePredicate<L>::value && IsSimplePredicate<R>::value>>
+		Disjunction<L, R>	operator ||(const L& lhs, const R& rhs)		{ return { lhs, rhs }; }
+
+
+		template <class T>	Comparison<CompareOp::Less,			T>	Less		(const T& c)	{ return { c }; }
+		template <class T>	Comparison<CompareOp::LessEqual,	T>	LessEqual	(const T& c)	{ return { c }; }
+		template <class T>	Comparison<CompareOp::Greater,		T>	Greater		(const T& c)	{ return { c }; }
+		template <class T>	Comparison<CompareOp::GreaterEqual,	T>	GreaterEqual(const T& c)	{ return { c }; }
+		template <class T>	Comparison<CompareOp::Equal,		T>	Equal		(const T& c)	{ return { c }; }
+		template <class T>	Comparison<CompareOp::NotEqual,		T>	NotEqual	(const T& c)	{ return { c }; }
+
+		template <class C, class F, class T>	Comparison<CompareOp::Less,			T, Field<F C::*>>	Less		(F C::* field, const T& c)	{ return { c, { field } }; }
+		template <class C, class F, class T>	Comparison<CompareOp::LessEqual,	T, Field<F C::*>>	LessEqual	(F C::* field, const T& c)	{ return { c, { field } }; }
+		template <class C, class F, class T>	Comparison<CompareOp::Greater,		T, Field<F C::*>>	Greater		(F C::* field, const T& c)	{ return { c, { field } }; }
+		template <class C, class F, class T>	Comparison<CompareOp::GreaterEqual,	T, Field<F C::*>>	GreaterEqual(F C::* field, const T& c)	{ return { c, { field } }; }
+		template <class C, class F, class T>	Comparison<CompareOp::Equal,		T, Field<F C::*>>	Equal		(F C::* field, const T& c)	{ return { c, { field } }; }
+		template <class C, class F, class T>	Comparison<CompareOp::NotEqual,		T, Field<F C::*>>	NotEqual	(F C::* field, const T& c)	{ return { c, { field } }; }
+
+	}	// namespace Predicates
+
+
+
+	// ==== Placeholder expressions ==============================================
+
+	/// Lambdas transparent to the library, e.g. Select(_1 * _1 + 3), Where(_1->*&Point::x > 0.0) or Aggregate(_1 + _2).
+	/// Comparing the argument (or a data member of it) to a value yields a simple predicate.
+	/// Expressions are callable as usual, while stages over contiguous data may evaluate them for whole blocks.
+	namespace Placeholders {
+
+		using Predicates::CompareOp;
+
+
+		/// The Nth argument of the call.
+		template <size_t N>	struct Arg;
+
+		template <>
+		struct Arg<1> {
+			template <class A, class... Rest>
+			A&&		operator ()(A&& a, Rest&&...)		  const		{ return std::forward<A>(a); }
+		};
+
+		template <>
+		struct Arg<2> {
+			template <class A, class B, class... Rest>
+			B&&		operator ()(A&&, B&& b, Rest&&...) const		{ return std::forward<B>(b); }
+		};
+
+
+		template <class T>
+		struct Constant {
+			T value;
+
+			template <class... A>
+			const T&	operator ()(A&&...)	const	{ return value; }
+		};
+
+
+		// NOTE: Arguments are passed on as l-values - each may be used by multiple subexpressions.
+
+		/// Data member of an evaluated object.
+		template <class E, class Mptr>
+		struct Member {
+			E		object;
+			Mptr	member;
+
+			template <class... A>
+			auto	operator ()(A&&... args) const -> decltype((object(args...).*member))
+			{
+				return object(args...).*member;
+			}
+		};
+
+
+		template <class Op, class E>
+		struct Unary {
+			E operand;
+
+			template <class... A>
+			auto	operator ()(A&&... args) const -> decltype(Op {}(operand(args...)))
+			{
+				return Op {}(operand(args...));
+			}
+		};
+
+
+		template <class Op, class L, class R>
+		struct Binary {
+			L lhs;
+			R rhs;
+
+			template <class... A>
+			auto	operator ()(A&&... args) const -> decltype(Op {}(lhs(args...), rhs(args...)))
+			{
+				return Op {}(lhs(args...), rhs(args...));
+			}
+		};
+
+		// && and || short-circuit, like for the built-in operators
+
+		template <class L, class R>
+		struct Binary<std::logical_and<>, L, R> {
+			L lhs;
+			R rhs;
+
+			template <class... A>
+			auto	operator ()(A&&... args) const -> decltype(lhs(args...) && rhs(args...))	{ return lhs(args...) && rhs(args...); }
+		};
+
+		template <class L, class R>
+		struct Binary<std::logical_or<>, L, R> {
+			L lhs;
+			R rhs;
+
+			template <class... A>
+			auto	operator ()(A&&... args) const -> decltype(lhs(args...) || rhs(args...))	{ return lhs(args...) || rhs(args...); }
+		};
+
+
+		constexpr Arg<1>	_1 {};
+		constexpr Arg<2>	_2 {};
+
+
+
+		/// Nodes of an expression - simple predicates included.
+		template <class T>						struct IsExpression							: Predicates::IsSimplePredicate<T> {};
+		template <size_t N>						struct IsExpression<Arg<N>>					: std::true_type {};
+		template <class T>						struct IsExpression<Constant<T>>			: std::true_type {};
+		template <class E, class M>				struct IsExpression<Member<E, M>>			: std::true_type {};
+		template <class Op, class E>			struct IsExpression<Unary<Op, E>>			: std::true_type {};
+		template <class Op, class L, class R>	struct IsExpression<Binary<Op, L, R>>		: std::true_type {};
+
+
+		/// Projections expressible by a simple predicate.
+		template <class E, class = void>
+		struct SimpleProjection {};
+
+		template <>
+		struct SimpleProjection<Arg<1>> {
+			static Predicates::Itself			Of(const Arg<1>&)						{ return {}; }
+		};
+
+		template <class F, class C>
+		struct SimpleProjection<Member<Arg<1>, F C::*>> {
+			static Predicates::Field<F C::*>	Of(const Member<Arg<1>, F C::*>& m)		{ return { m.member }; }
+		};
+
+
+		template <class E, std::enable_if_t<IsExpression<E>::value, int> = 0>
+		const E&		AsNode(const E& e)		{ return e; }
+
+		template <class T, std::enable_if_t<!IsExpression<T>::value, int> = 0>
+		Constant<T>		AsNode(const T& value)	{ return { value }; }
+
+		template <class T>
+		using NodeT = std::decay_t<decltype(AsNode(std::declval<const T&>()))>;
+
+
+		/// Operators apply to expressions - except to pairs of simple predicates, combined by their own operators.
+		template <class L, class R>
+		using IfOperands = std::enable_if_t<(IsExpression<L>::value || IsExpression<R>::value)
+											&& !(Predicates::IsSimplePredicate<L>::value && Predicates::IsSimplePredicate<R>::value), int>;
+
+		template <class Op, class L, class R>
+		Binary<Op, NodeT<L>, NodeT<R>>	MakeBinary(const L& lhs, const R& rhs)	{ return { AsNode(lhs), AsNode(rhs) }; }
+
+
+		template <class E, class = void>
+		struct HasSimpleProjection : std::false_type {};
+
+		template <class E>
+		struct HasSimpleProjection<E, decltype(void(SimpleProjection<E>::Of(std::declval<const E&>())))> : std::true_type {};
+
+
+		// Argument vs. value comparisons are lowered to simple predicates, others remain generic.
+
+		template <CompareOp Op, CompareOp Mirrored, class StdOp, class L, class R,
+				  std::enable_if_t<HasSimpleProjection<L>::value && !IsExpression<R>::value, int> = 0>
+		auto	MakeComparison(const L& lhs, const R& rhs)
+		{
+			return Predicates::Comparison<Op, R, decltype(SimpleProjection<L>::Of(lhs))> { rhs, SimpleProjection<L>::Of(lhs) };
+		}
+
+		template <CompareOp Op, CompareOp Mirrored, class StdOp, class L, class R,
+				  std::enable_if_t<!IsExpression<L>::value && HasSimpleProjection<R>::value, int> = 0>
+		auto	MakeComparison(const L& lhs, const R& rhs)
+		{
+			return Predicates::Comparison<Mirrored, L, decltype(SimpleProjection<R>::Of(rhs))> { lhs, SimpleProjection<R>::Of(rhs) };
+		}
+
+		template <CompareOp Op, CompareOp Mirrored, class StdOp, class L, class R,
+				  std::enable_if_t<!(HasSimpleProjection<L>::value && !IsExpression<R>::value)
+								   && !(!IsExpression<L>::value && HasSimpleProjection<R>::value), int> = 0>
+		auto	MakeComparison(const L& lhs, const R& rhs)
+		{
+			return MakeBinary<StdOp>(lhs, rhs);
+		}
+
+
+		template <class E, class C, class F, std::enable_if_t<IsExpression<E>::value && !std::is_function<F>::value, int> = 0>
+		Member<E, F C::*>	operator ->*(const E& object, F C::* member)	{ return { object, member }; }
+
+		template <class E, std::enable_if_t<IsExpression<E>::value, int> = 0>
+		Unary<std::negate<>, E>			operator -(const E& e)		{ return { e }; }
+
+		template <class E, std::enable_if_t<IsExpression<E>::value, int> = 0>
+		Unary<std::logical_not<>, E>	operator !(const E& e)		{ return { e }; }
+
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator +	 (const L& l, const R& r)	{ return MakeBinary<std::plus<>>		(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator -	 (const L& l, const R& r)	{ return MakeBinary<std::minus<>>		(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator *	 (const L& l, const R& r)	{ return MakeBinary<std::multiplies<>>	(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator /	 (const L& l, const R& r)	{ return MakeBinary<std::divides<>>		(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator %	 (const L& l, const R& r)	{ return MakeBinary<std::modulus<>>		(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator && (const L& l, const R& r)	{ return MakeBinary<std::logical_and<>>	(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator || (const L& l, const R& r)	{ return MakeBinary<std::logical_or<>>	(l, r); }
+
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator <	 (const L& l, const R& r)	{ return MakeComparison<CompareOp::Less,		 CompareOp::Greater,	  std::less<>>			(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator <= (const L& l, const R& r)	{ return MakeComparison<CompareOp::LessEqual,	 CompareOp::GreaterEqual, std::less_equal<>>	(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator >	 (const L& l, const R& r)	{ return MakeComparison<CompareOp::Greater,		 CompareOp::Less,		  std::greater<>>		(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator >= (const L& l, const R& r)	{ return MakeComparison<CompareOp::GreaterEqual, CompareOp::LessEqual,	  std::greater_equal<>>	(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator == (const L& l, const R& r)	{ return MakeComparison<CompareOp::Equal,		 CompareOp::Equal,		  std::equal_to<>>		(l, r); }
+		template <class L, class R, IfOperands<L, R> = 0>	auto operator != (const L& l, const R& r)	{ return MakeComparison<CompareOp::NotEqual,	 CompareOp::NotEqual,	  std::not_equal_to<>>	(l, r); }
+
+	}	// namespace Placeholders
+
+
+
+	// ==== Elementwise operations ===============================================
+
+	/// A binary operation declared pure and stateless - so the library may evaluate it for many operand pairs at once,
+	/// e.g. MapNeighbors(Elementwise(FUN(p, n,  n - p))) on contiguous data.
+	template <class F>
+	struct ElementwiseOp {
+		F op;
+
+		template <class L, class R>
+		auto	operator ()(L&& lhs, R&& rhs) const -> decltype(op(std::forward<L>(lhs), std::forward<R>(rhs)))
+		{
+			return op(std::forward<L>(lhs), std::forward<R>(rhs));
+		}
+	};
+
+
+	template <class F>
+	ElementwiseOp<std::decay_t<F>>	Elementwise(F&& op)		{ return { std::forward<F>(op) }; }
+
+
+
 	// ==== Optional Result ======================================================
 
 	/// A simplified, logically immutable optional type, offering & support and rich chaining/transformation features.
@@ -0,0 +1,280 @@
+#ifndef ENUMERABLES_MULTIPROCESS_HPP
+#define ENUMERABLES_MULTIPROCESS_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the multi-process evaluation of AutoEnumerable::AsParallel() queries:	  *
+	 *  ToSharedMemoryList() forks worker processes to evaluate the shards of the source, which		  *
+	 *  write their results directly into a memory mapping shared with the parent.					  *
+	 *																								  *
+	 *  POSIX only - enabled by ENUMERABLES_USE_MULTIPROCESS.										  *
+	 *  Included by Enumerables_Implementation.hpp - not to be used directly.						  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+
+namespace Enumerables {
+namespace Def {
+
+#pragma region Shared memory
+
+	/// Anonymous memory mapping, shared with the child processes forked after its creation.
+	class SharedMapping {
+		void*	address = nullptr;
+		size_t	bytes	= 0;
+
+	public:
+		explicit SharedMapping(size_t size) : bytes { size > 0 ? size : 1 }
+		{
+			void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+			if (mapped == MAP_FAILED)
+				throw LogicException("Failed to map shared memory.");
+
+			address = mapped;
+		}
+
+		SharedMapping(SharedMapping&& src) noexcept : address { src.address }, bytes { src.bytes }
+		{
+			src.address = nullptr;
+		}
+
+		SharedMapping(const SharedMapping&)				= delete;
+		SharedMapping& operator =(const SharedMapping&)	= delete;
+		SharedMapping& operator =(SharedMapping&&)		= delete;
+
+		~SharedMapping()
+		{
+			if (address != nullptr)
+				munmap(address, bytes);
+		}
+
+		char*	Data() const	{ return static_cast<char*>(address); }
+	};
+
+
+
+	/// Read-only array of trivially copyable results, residing in the memory mapping they were written to
+	/// by worker processes. Enumerable as a container.
+	template <class T>
+	class SharedMemoryList {
+		SharedMapping	mapping;
+		const T*		elems;
+		size_t			count;
+
+	public:
+		SharedMemoryList(SharedMapping&& mapping, const T* elems, size_t count) :
+			mapping { move(mapping) },
+			elems	{ elems },
+			count	{ count }
+		{
+		}
+
+		SharedMemoryList(SharedMemoryList&&) = default;
+
+		size_t		size()					const	{ return count; }
+		const T*	begin()					const	{ return elems; }
+		const T*	end()					const	{ return elems + count; }
+		const T&	operator [](size_t i)	const	{ return elems[i]; }
+	};
+
+
+	template <class T>
+	size_t GetSize(const SharedMemoryList<T>& l)	{ return l.size(); }
+
+#pragma endregion
+
+
+
+#pragma region ToSharedMemoryList
+
+	/// Written by a worker process for its shard.
+	struct ShardReport {
+		size_t	count;
+		bool	completed;
+	};
+
+
+	/// Where a worker process reads its shard from and writes its results to.
+	struct ShardSlot {
+		size_t	begin;
+		size_t	end;
+		size_t	offset;
+		size_t	capacity;
+	};
+
+
+	/// Wait for a child process, reporting whether it exited successfully.
+	inline bool AwaitWorkerProcess(pid_t pid)
+	{
+		int status = 0;
+		while (waitpid(pid, &status, 0) < 0) {
+			if (errno != EINTR)
+				return false;
+		}
+		return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	}
+
+
+	/// Evaluate the given shards in forked worker processes, each writing at most its capacity of results.
+	/// Reports count all the results of a shard, so overflows can be detected by the caller.
+	/// @returns whether all the workers completed
+	template <class T, class TSession, class TPipeline>
+	bool RunWorkerProcesses(const TSession&				 session,
+							const TPipeline&			 pipeline,
+							const std::vector<ShardSlot>& slots,
+							const std::vector<size_t>&	 shardIds,
+							ShardReport*				 reports,
+							T*							 elems)
+	{
+		for (size_t s : shardIds)
+			new (reports + s) ShardReport { 0, false };
+
+		std::vector<pid_t> workers;
+		for (size_t s : shardIds) {
+			const ShardSlot& slot = slots[s];
+
+			pid_t pid = fork();
+			if (pid == 0) {
+				// worker process: evaluate sequentially, then leave without unwinding the parent's state
+				int exitCode = 1;
+				try {
+					auto   query = pipeline(session.Slice(slot.begin, slot.end));
+					size_t n	 = 0;
+
+					auto et = query.GetEnumeratorNoDebug();
+					for (; et.FetchNext(); ++n) {
+						if (n < slot.capacity)
+							new (elems + slot.offset + n) T(et.Current());
+					}
+					reports[s].count	 = n;
+					reports[s].completed = true;
+					exitCode			 = 0;
+				}
+				catch (...) {
+				}
+				_exit(exitCode);
+			}
+
+			if (pid < 0) {
+				for (pid_t w : workers)
+					AwaitWorkerProcess(w);
+				throw LogicException("Failed to fork worker process.");
+			}
+			workers.push_back(pid);
+		}
+
+		bool succeeded = true;
+		for (pid_t w : workers)
+			succeeded = AwaitWorkerProcess(w) && succeeded;
+		for (size_t s : shardIds)
+			succeeded = succeeded && reports[s].completed;
+
+		return succeeded;
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ToSharedMemoryList(size_t processCount) const -> SharedMemoryList<TElemDecayed>
+	{
+		using T = TElemDecayed;
+
+		static_assert (std::is_trivially_copyable<T>::value, "Only trivially copyable results can be shared between processes.");
+
+		const TSession session = partitioner.Open();
+		const size_t   length  = session.Length();
+
+		if (processCount == 0)
+			processCount = ParallelWorkerCount(degree);
+
+		const size_t shards = (length == 0) ? 1 : (processCount < length ? processCount : length);
+
+		// first guess a slot per source element - enough unless some stage expands (e.g. Flatten)
+		const size_t  headerBytes = (shards * sizeof(ShardReport) + alignof(T) - 1) / alignof(T) * alignof(T);
+		SharedMapping mapping { headerBytes + length * sizeof(T) };
+
+		ShardReport* reports = reinterpret_cast<ShardReport*>(mapping.Data());
+		T*			 elems	 = reinterpret_cast<T*>(mapping.Data() + headerBytes);
+
+		std::vector<ShardSlot> slots;
+		std::vector<size_t>	   shardIds;
+		for (size_t s = 0; s < shards; ++s) {
+			const size_t b = length * s / shards;
+			const size_t e = length * (s + 1) / shards;
+			slots.push_back({ b, e, b, e - b });
+			shardIds.push_back(s);
+		}
+
+		if (!RunWorkerProcesses(session, pipeline, slots, shardIds, reports, elems))
+			throw LogicException("A worker process of ToSharedMemoryList failed.");
+
+		size_t total = 0;
+		shardIds.clear();
+		for (size_t s = 0; s < shards; ++s) {
+			total += reports[s].count;
+			if (reports[s].count > slots[s].capacity)
+				shardIds.push_back(s);
+		}
+
+		if (shardIds.empty()) {
+			// close the gaps left by filtered shards in place
+			size_t offset = 0;
+			for (size_t s = 0; s < shards; ++s) {
+				const size_t b = slots[s].offset;
+				const size_t n = reports[s].count;
+				if (b != offset && n > 0)
+					std::memmove(static_cast<void*>(elems + offset), elems + b, n * sizeof(T));
+
+				offset += n;
+			}
+			return { move(mapping), elems, total };
+		}
+
+		// overflowing shards now know their counts: keep the complete ones, re-evaluate the rest into a mapping of exact size
+		SharedMapping regrown { total * sizeof(T) };
+		T*			  regrownElems = reinterpret_cast<T*>(regrown.Data());
+
+		size_t offset = 0;
+		for (size_t s = 0; s < shards; ++s) {
+			const size_t n = reports[s].count;
+			if (n <= slots[s].capacity && n > 0)
+				std::memcpy(static_cast<void*>(regrownElems + offset), elems + slots[s].offset, n * sizeof(T));
+
+			slots[s].offset	  = offset;
+			slots[s].capacity = n;
+			offset += n;
+		}
+
+		if (!RunWorkerProcesses(session, pipeline, slots, shardIds, reports, regrownElems))
+			throw LogicException("A worker process of ToSharedMemoryList failed.");
+
+		for (size_t s : shardIds) {
+			if (reports[s].count != slots[s].capacity)
+				throw LogicException("Shards of ToSharedMemoryList yielded different results on re-evaluation.");
+		}
+
+		return { move(regrown), regrownElems, total };
+	}
+
+#pragma endregion
+
+
+}	// namespace Def
+
+
+using Def::SharedMemoryList;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_MULTIPROCESS_HPP
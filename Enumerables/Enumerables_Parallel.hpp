@@ -0,0 +1,1718 @@
+#ifndef ENUMERABLES_PARALLEL_HPP
+#define ENUMERABLES_PARALLEL_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the parallel evaluation facilities behind AutoEnumerable::AsParallel().	  *
+	 *  Also contains the Buffered() pipeline stage and FlattenParallel().							  *
+	 *  Included by Enumerables_Implementation.hpp - not to be used directly.						  *
+	 *																								  *
+	 *  --------------------------------------------------------------------------------------------  *
+	 *	Concept:																					  *
+	 *		A Partitioner opens a session over the source, which knows its length and can create	  *
+	 *		standalone AutoEnumerables for any [begin, end) slice of it.							  *
+	 *		ParallelEnumerable records element-local operations as a Pipeline, then terminal		  *
+	 *		operations evaluate the Pipeline over slices (chunks) scheduled by ParallelFor on an	  *
+	 *		IExecutor - split adaptively, as long as there are idle workers -,						  *
+	 *		merging partial results in chunk order.													  *
+	 *																								  *
+	 *		Slices are cheap to create for:															  *
+	 *			- random-access iterator ranges		(e.g. Enumerate(vector), Enumerate(b, e))		  *
+	 *			- Range, RangeDown, IndexRange, IndexRangeReversed									  *
+	 *			- Caching operations				(e.g. Order, ToMaterialized, Reverse) -			  *
+	 *												  evaluated upfront, on the calling thread.		  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include "Enumerables_Executors.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	using std::size_t;
+
+
+#pragma region Execution
+
+	/// Partial results of the pieces of a ParallelFor, restorable in source order.
+	template <class R>
+	class OrderedPieces {
+		std::mutex							lock;
+		std::vector<std::pair<size_t, R>>	pieces;
+
+	public:
+		template <class Creator>
+		void	Add(size_t pos, Creator&& create)
+		{
+			R result = create();
+
+			std::lock_guard<std::mutex> guard { lock };
+			pieces.emplace_back(pos, move(result));
+		}
+
+
+		ListType<R>	PassOrdered()
+		{
+			// R may not be assignable -> sort indices only
+			std::vector<size_t> order (pieces.size());
+			for (size_t i = 0; i < order.size(); ++i)
+				order[i] = i;
+
+			std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return pieces[a].first < pieces[b].first; });
+
+			auto results = ListOperations::Init<ListType<R>>(pieces.size());
+			for (size_t i : order)
+				ListOperations::Add(results, move(pieces[i].second));
+
+			return results;
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region Partitioning
+
+	/// Random-access iterators can form any slice in constant time.
+	template <class It>
+	using IsRandomAccessIter = std::is_base_of<std::random_access_iterator_tag,
+											   typename std::iterator_traits<It>::iterator_category>;
+
+
+	/// Partitioner selection by the source's Enumerator type.
+	template <class Source, class Etor, class>
+	struct PartitionerFor {
+		static_assert (AsDependentT<std::false_type, Source>::value,
+					   "AsParallel requires a source which can be sliced cheaply: random-access iterators, Range or a caching operation. "
+					   "Consider .ToMaterialized() (or ToList) first!");
+	};
+
+
+	/// Slices wrapped random-access iterator ranges.
+	template <class Source, class It, class ForcedElem>
+	struct PartitionerFor<Source, IteratorEnumerator<It, ForcedElem>, enable_if_t<IsRandomAccessIter<It>::value>> {
+
+		struct Session {
+			It		first;
+			size_t	length;
+
+			size_t	Length()				   const	{ return length; }
+			auto	Slice(size_t b, size_t e)  const
+			{
+				using Diff = typename std::iterator_traits<It>::difference_type;
+				return Enumerate<ForcedElem>(first + static_cast<Diff>(b), first + static_cast<Diff>(e));
+			}
+		};
+
+		Source	source;
+
+		Session	Open() const
+		{
+			auto et = source.GetEnumeratorNoDebug();
+			return { et.Position(), static_cast<size_t>(std::distance(et.Position(), et.End())) };
+		}
+
+		const Source&	SequentialSource() const &	{ return source; }
+		Source&&		SequentialSource() &&		{ return move(source); }
+	};
+
+
+
+	/// Element of a partitioned Range, without enumerating the preceding ones.
+	template <class V, enable_if_t<std::is_arithmetic<V>::value, int> = 0>
+	V	RangeElementAt(const V& first, size_t i, RangeIncrement)	{ return static_cast<V>(first + static_cast<V>(i)); }
+
+	template <class V, enable_if_t<std::is_arithmetic<V>::value, int> = 0>
+	V	RangeElementAt(const V& first, size_t i, RangeDecrement)	{ return static_cast<V>(first - static_cast<V>(i)); }
+
+	template <class V>
+	V*	RangeElementAt(V* first, size_t i, RangeIncrement)			{ return first + i; }
+
+	template <class V>
+	V*	RangeElementAt(V* first, size_t i, RangeDecrement)			{ return first - i; }
+
+
+	/// Slices Range, RangeDown, IndexRange and IndexRangeReversed of numbers or pointers.
+	/// @remarks	Bounds of IndexRanges are queried once, at start of evaluation.
+	template <class Fact, class Etor>
+	struct PartitionerFor<AutoEnumerable<Fact>, Etor,
+						  void_t<decltype(RangeElementAt(declval<const Fact&>().First(), 0u, declval<typename Fact::TStep>()))>> {
+
+		using V	   = typename Fact::TValue;
+		using Step = typename Fact::TStep;
+
+		struct Session {
+			V		first;
+			size_t	length;
+
+			size_t	Length()				   const	{ return length; }
+			auto	Slice(size_t b, size_t e)  const
+			{
+				return WrapFactory(RangeFactory<V, Step> { RangeElementAt(first, b, Step {}), e - b, {} });
+			}
+		};
+
+		AutoEnumerable<Fact>	source;
+
+		Session	Open() const
+		{
+			Fact fact = source.CloneFactory();
+			return { fact.First(), fact.Length() };
+		}
+
+		const AutoEnumerable<Fact>&	SequentialSource() const &	{ return source; }
+		AutoEnumerable<Fact>&&		SequentialSource() &&		{ return move(source); }
+	};
+
+
+
+	/// Evaluates caching operations upfront, then slices their results.
+	template <class Source, class Etor>
+	struct PartitionerFor<Source, Etor, enable_if_t<std::is_base_of<CachingEnumerator<typename Etor::TCache>, Etor>::value>> {
+
+		using Cache = typename Etor::TCache;
+		using TElem = typename Etor::TElem;
+
+		struct Session {
+			Cache	cache;
+
+			size_t	Length()				   const	{ return GetSize(cache); }
+			auto	Slice(size_t b, size_t e)  const
+			{
+				auto first = AdlBegin(cache);
+				return Enumerate(std::next(first, b), std::next(first, e))
+					  .Map([](auto& stored) -> TElem { return Revive(stored); });
+			}
+		};
+
+		Source	source;
+
+		Session	Open() const
+		{
+			Etor et = source.GetEnumeratorNoDebug();
+			return { et.CalcResults() };
+		}
+
+		const Source&	SequentialSource() const &	{ return source; }
+		Source&&		SequentialSource() &&		{ return move(source); }
+	};
+
+#pragma endregion
+
+
+
+#pragma region Pipeline
+
+	/// Pipeline of a fresh ParallelEnumerable: passes chunks through.
+	struct IdentityStage {
+		template <class Q>
+		Q	operator ()(Q&& query) const	{ return forward<Q>(query); }
+	};
+
+
+	/// Pipeline applying @p Next to the chunk-query returned by @p Prev.
+	template <class Prev, class Next>
+	struct ComposedStage {
+		Prev	prev;
+		Next	next;
+
+		template <class Q>
+		auto	operator ()(Q&& query) const	{ return next(prev(forward<Q>(query))); }
+	};
+
+#pragma endregion
+
+
+
+#pragma region Sharded lookups
+
+	/// Shard of a hash code. [Multiplicative mixing spreads identity hashes of integers too.]
+	inline size_t ShardIndex(size_t hash, size_t shardCount)
+	{
+		uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(mixed >> 32) % shardCount;
+	}
+
+
+	/// std::hash of any key type.
+	struct StdHasher {
+		template <class K>
+		size_t operator ()(const K& key) const	{ return std::hash<K> {}(key); }
+	};
+
+
+	/// Read-only container of hash-partitioned shards, built concurrently by ParallelEnumerable.
+	/// @remarks	Hasher must be consistent with the key equality of the Shard type.
+	template <class Shard, class Hasher>
+	class ShardedLookup {
+	protected:
+		std::vector<Shard>	shards;
+		Hasher				hasher;
+		size_t				count = 0;
+
+	public:
+		using TShard = Shard;
+
+		ShardedLookup(std::vector<Shard>&& shards, const Hasher& hasher) : shards { move(shards) }, hasher { hasher }
+		{
+			for (const Shard& s : this->shards)
+				count += GetSize(s);
+		}
+
+		size_t			Count()					const	{ return count; }
+		size_t			ShardCount()			const	{ return shards.size(); }
+		const Shard&	GetShard(size_t i)		const	{ return shards[i]; }
+
+		template <class K>
+		const Shard&	ShardOf(const K& key)	const	{ return shards[ShardIndex(hasher(key), shards.size())]; }
+	};
+
+
+
+	/// Set partitioned into shards by hash.
+	template <class V, class Hasher, class... Options>
+	class ShardedSet final : public ShardedLookup<SetType<V, Options...>, Hasher> {
+	public:
+		using typename ShardedSet::ShardedLookup::TShard;
+		using ShardedSet::ShardedLookup::ShardedLookup;
+
+		bool	Contains(const V& elem) const
+		{
+			return SetOperations::Contains(this->ShardOf(elem), elem);
+		}
+
+		/// Copy the elements of all shards into a single Set.
+		TShard	Merge(const Options&... opts) const
+		{
+			TShard result = SetOperations::Init<TShard>(this->count, opts...);
+			for (const TShard& shard : this->shards) {
+				for (const V& elem : shard)
+					SetOperations::Add(result, elem);
+			}
+			return result;
+		}
+	};
+
+
+
+	/// Dictionary partitioned into shards by the hash of keys.
+	template <class K, class V, class Hasher, class... Options>
+	class ShardedDictionary final : public ShardedLookup<DictionaryType<K, V, Options...>, Hasher> {
+	public:
+		using typename ShardedDictionary::ShardedLookup::TShard;
+		using ShardedDictionary::ShardedLookup::ShardedLookup;
+
+		bool		Contains(const K& key) const
+		{
+			return DictOperations::Contains(this->ShardOf(key), key);
+		}
+
+		/// Value stored for an existing @p key. [Throws LogicException otherwise.]
+		const V&	At(const K& key) const
+		{
+			const V* found = DictOperations::Find(this->ShardOf(key), key);
+			if (found == nullptr) {
+				ENUMERABLES_CLIENT_BREAK ("Key not found in ShardedDictionary!");
+				throw LogicException("Key not found in ShardedDictionary!");
+			}
+			return *found;
+		}
+
+		/// Move the entries of all shards into a single Dictionary.
+		TShard		Merge(const Options&... opts) &&
+		{
+			TShard result = DictOperations::Init<TShard>(this->count, opts...);
+			for (TShard& shard : this->shards) {
+				for (auto& kv : shard)
+					DictOperations::Add(result, kv.first, move(kv.second));
+			}
+			Finalize<DictOperations>(result);
+			return result;
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region ParallelEnumerable
+
+	/// Compensated sum of a block of elements.
+	template <class S>
+	struct CompensatedPartial {
+		S		sum {};
+		S		err {};
+		size_t	count = 0;
+
+		template <class Q>
+		static CompensatedPartial	Of(Q& query)
+		{
+			CompensatedPartial part;
+
+			auto et = query.GetEnumeratorNoDebug();
+			while (et.FetchNext()) {
+				++part.count;
+				NeumaierSum2(part.sum, static_cast<S>(et.Current()), part.err);
+			}
+			return part;
+		}
+
+		void	Merge(const CompensatedPartial& rhs)
+		{
+			NeumaierSum2(sum, rhs.sum, err);
+			err	  += rhs.err;
+			count += rhs.count;
+		}
+	};
+
+
+	/// Pairwise reduction of fixed shape: the order of operations depends only on the number of @p partials.
+	/// @param partials:	ListType of CompensatedPartials - taken as is, since bindings may hide its parameters
+	template <class PartialList>
+	auto	ReduceByTree(PartialList& partials)
+	{
+		size_t n = GetSize(partials);
+		for (size_t width = 1; width < n; width *= 2) {
+			for (size_t i = 0; i + width < n; i += 2 * width)
+				ListOperations::Access(partials, i).Merge(ListOperations::Access(partials, i + width));
+		}
+		return ListOperations::Access(partials, 0);
+	}
+
+
+	/// Enumerates the results of ParallelEnumerable::Scan - calculated on first fetch.
+	/// @remarks	Owns a copy of the query and the combiner: the scan runs detached from the creating AutoEnumerable.
+	template <class TParallel, class Combiner, class Acc>
+	class ParallelScannerEnumerator final : public CachingEnumerator<ListType<Acc>> {
+		TParallel	query;
+		Combiner	combiner;
+
+	public:
+		using typename ParallelScannerEnumerator::CachingEnumerator::TCache;
+		using typename ParallelScannerEnumerator::CachingEnumerator::TElem;
+
+		TCache	CalcResults() override
+		{
+			return query.template ScanToList<Acc>(combiner);
+		}
+
+		SizeInfo				Measure()   const override	{ return { Boundedness::Unknown }; }
+		IEnumerator<TElem>* 	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
+
+
+		ParallelScannerEnumerator(const TParallel& query, const Combiner& combiner) : query { query }, combiner { combiner }  {}
+		ParallelScannerEnumerator(ParallelScannerEnumerator&&) = default;
+	};
+
+
+
+	/// Results in memory shared with worker processes - see Enumerables_MultiProcess.hpp
+	template <class T>
+	class SharedMemoryList;
+
+
+
+	/// Query over a partitioned source - evaluated concurrently by terminal operations.
+	/// @remarks
+	///		Only element-local transformations can be chained, the rest of the
+	///		AutoEnumerable interface is available via AsSequential().
+	///		Callables passed here are invoked concurrently, so they must be thread-safe.
+	template <class TPartitioner, class TPipeline>
+	class ParallelEnumerable {
+		template <class, class>			friend class ParallelEnumerable;
+		template <class, class, class>	friend class ParallelScannerEnumerator;
+
+		using TSession = decltype(declval<const TPartitioner&>().Open());
+		using TSlice   = decltype(declval<const TSession&>().Slice(0, 0));
+
+		TPartitioner	partitioner;
+		TPipeline		pipeline;
+		size_t			degree;
+		IExecutor*		executor;
+
+	public:
+		/// The query evaluated on each chunk.
+		using TQuery		  = decltype(declval<const TPipeline&>()(declval<TSlice>()));
+		using TElem			  = typename TQuery::TElem;
+		using TElemDecayed	  = typename TQuery::TElemDecayed;
+		using TElemConstParam = typename TQuery::TElemConstParam;
+
+
+		ParallelEnumerable(TPartitioner&& partitioner, TPipeline&& pipeline, size_t degree = 0, IExecutor* executor = nullptr) :
+			partitioner { move(partitioner) },
+			pipeline	{ move(pipeline) },
+			degree		{ degree },
+			executor	{ executor }
+		{
+		}
+
+
+	private:
+		template <class Stage>
+		auto Then(Stage&& stage) const &
+		{
+			using Result = ParallelEnumerable<TPartitioner, ComposedStage<TPipeline, decay_t<Stage>>>;
+			return Result { TPartitioner { partitioner }, { pipeline, forward<Stage>(stage) }, degree, executor };
+		}
+
+		template <class Stage>
+		auto Then(Stage&& stage) &&
+		{
+			using Result = ParallelEnumerable<TPartitioner, ComposedStage<TPipeline, decay_t<Stage>>>;
+			return Result { move(partitioner), { move(pipeline), forward<Stage>(stage) }, degree, executor };
+		}
+
+
+		/// ParallelFor on the executor of this query, within its degree of parallelism.
+		template <class Body>
+		void Schedule(size_t length, size_t grain, const Body& body) const
+		{
+			IExecutor&	exec	 = (executor != nullptr) ? *executor : DefaultExecutor();
+			size_t		maxTasks = (degree != 0) ? ParallelWorkerCount(degree) : exec.Concurrency();
+
+			ParallelFor(exec, length, grain, maxTasks, body);
+		}
+
+
+		/// Results of @p chunkOp(TQuery&) evaluated concurrently for adaptively split chunks, listed in chunk order.
+		template <class ChunkOp>
+		auto EvaluateChunks(const ChunkOp& chunkOp) const
+		{
+			using R = decltype(chunkOp(declval<TQuery&>()));
+
+			const TSession session = partitioner.Open();
+
+			OrderedPieces<R> pieces;
+			Schedule(session.Length(), ENUMERABLES_PARALLEL_MIN_CHUNK, [&](size_t b, size_t e) {
+				TQuery query = pipeline(session.Slice(b, e));
+				pieces.Add(b, [&]() -> R { return chunkOp(query); });
+			});
+			return pieces.PassOrdered();
+		}
+
+
+		/// Results of @p blockOp(TQuery&) for each block of @p blockLength source elements, listed in order.
+		/// Unlike chunks, blocks are independent of the executor and the degree of parallelism. [At least 1 block.]
+		template <class BlockOp>
+		auto EvaluateBlocks(size_t blockLength, const BlockOp& blockOp) const
+		{
+			using R = decltype(blockOp(declval<TQuery&>()));
+
+			const TSession session = partitioner.Open();
+
+			size_t length = session.Length();
+			size_t blocks = (length == 0) ? 1 : (length - 1) / blockLength + 1;
+
+			auto slots = ListOperations::Init<ListType<Deferred<R>>>(blocks);
+			for (size_t i = 0; i < blocks; ++i)
+				ListOperations::Add(slots, Deferred<R> {});
+
+			Schedule(blocks, ENUMERABLES_PARALLEL_MIN_CHUNK / blockLength, [&](size_t bb, size_t be) {
+				for (size_t i = bb; i < be; ++i) {
+					size_t b	 = i * blockLength;
+					size_t e	 = (length - b > blockLength) ? b + blockLength : length;
+					TQuery query = pipeline(session.Slice(b, e));
+					ListOperations::Access(slots, i).AcceptRvo([&]() -> R { return blockOp(query); });
+				}
+			});
+
+			auto results = ListOperations::Init<ListType<R>>(blocks);
+			for (Deferred<R>& r : slots)
+				ListOperations::Add(results, r.PassValue());
+
+			return results;
+		}
+
+
+		/// Shard count used when not specified: some more than tasks, to balance the building.
+		size_t	DefaultShardCount() const
+		{
+			IExecutor&	exec = (executor != nullptr) ? *executor : DefaultExecutor();
+			size_t		n	 = (degree != 0) ? ParallelWorkerCount(degree) : exec.Concurrency();
+			return 4 * n;
+		}
+
+
+		/// MapReduce within the process: each chunk is split into @p shardCount parts, then each shard is
+		/// reduced concurrently from its parts, listed in chunk order.
+		/// @param partition:	(TQuery&, ListType<Part>& parts) -> void, parts being created by @p initPart()
+		/// @param reduce:		(ListType<ListType<Part>>& partsOfChunks, size_t shard) -> Shard
+		template <class Part, class InitOp, class PartitionOp, class ReduceOp>
+		auto	ReduceShards(size_t shardCount, const InitOp& initPart, const PartitionOp& partition, const ReduceOp& reduce) const;
+
+		/// Items of each chunk partitioned by @p shardOf, then each shard built concurrently from its items,
+		/// inserted in the order of the sequential equivalent.
+		/// @param toItem:		TElem -> Item
+		/// @param shardOf:		const Item& -> index < @p shardCount
+		/// @param initShard:	size_t capacity -> Shard
+		/// @param insert:		(Shard&, Item&&) -> void
+		template <class Shard, class ItemOp, class ShardOp, class InitOp, class InsertOp>
+		std::vector<Shard>	BuildShards(size_t shardCount, const ItemOp& toItem, const ShardOp& shardOf,
+										const InitOp& initShard, const InsertOp& insert) const;
+
+		template <class S>	S	SumOf(std::true_type  /*floating*/) const;
+		template <class S>	S	SumOf(std::false_type /*floating*/) const;
+
+		template <class Acc, class F>
+		ListType<Acc>	ScanToList(const F& combiner) const;
+
+
+		template <class Pred>
+		bool FindAny(const Pred& pred) const;
+
+
+	public:
+		// =========== Chaining element-local operations =============================================================================
+
+		template <class Pred>					auto Where(Pred&& p) const &		{ return		Then([p = forward<Pred>(p)](auto&& q) { return move(q).Where(p); }); }
+		template <class Pred>					auto Where(Pred&& p) &&				{ return move(*this).Then([p = forward<Pred>(p)](auto&& q) { return move(q).Where(p); }); }
+
+		template <class Mapper>					auto Map(Mapper&& m) const &		{ return		Then([m = forward<Mapper>(m)](auto&& q) { return move(q).Map(m); }); }
+		template <class Mapper>					auto Map(Mapper&& m) &&				{ return move(*this).Then([m = forward<Mapper>(m)](auto&& q) { return move(q).Map(m); }); }
+
+		template <class TMapped, class Mapper>	auto MapTo(Mapper&& m) const &		{ return		Then([m = forward<Mapper>(m)](auto&& q) { return move(q).template MapTo<TMapped>(m); }); }
+		template <class TMapped, class Mapper>	auto MapTo(Mapper&& m) &&			{ return move(*this).Then([m = forward<Mapper>(m)](auto&& q) { return move(q).template MapTo<TMapped>(m); }); }
+
+		template <class TSelected = void, class S>	auto Select(S&& s) const &		{ return		Then([s = forward<S>(s)](auto&& q) { return move(q).template Select<TSelected>(s); }); }
+		template <class TSelected = void, class S>	auto Select(S&& s) &&			{ return move(*this).Then([s = forward<S>(s)](auto&& q) { return move(q).template Select<TSelected>(s); }); }
+
+		template <class R>	auto As()		const &		{ return		   Then([](auto&& q) { return move(q).template As<R>(); }); }
+		template <class R>	auto As()		&&			{ return move(*this).Then([](auto&& q) { return move(q).template As<R>(); }); }
+
+		template <class R>	auto Cast()		const &		{ return		   Then([](auto&& q) { return move(q).template Cast<R>(); }); }
+		template <class R>	auto Cast()		&&			{ return move(*this).Then([](auto&& q) { return move(q).template Cast<R>(); }); }
+
+		template <class R>	auto OfType()	const &		{ return		   Then([](auto&& q) { return move(q).template OfType<R>(); }); }
+		template <class R>	auto OfType()	&&			{ return move(*this).Then([](auto&& q) { return move(q).template OfType<R>(); }); }
+
+		auto Decay()		const &		{ return		   Then([](auto&& q) { return move(q).Decay(); }); }
+		auto Decay()		&&			{ return move(*this).Then([](auto&& q) { return move(q).Decay(); }); }
+
+		auto NonNulls()		const &		{ return		   Then([](auto&& q) { return move(q).NonNulls(); }); }
+		auto NonNulls()		&&			{ return move(*this).Then([](auto&& q) { return move(q).NonNulls(); }); }
+
+		auto Addresses()	const &		{ return		   Then([](auto&& q) { return move(q).Addresses(); }); }
+		auto Addresses()	&&			{ return move(*this).Then([](auto&& q) { return move(q).Addresses(); }); }
+
+		auto Dereference()	const &		{ return		   Then([](auto&& q) { return move(q).Dereference(); }); }
+		auto Dereference()	&&			{ return move(*this).Then([](auto&& q) { return move(q).Dereference(); }); }
+
+		/// Flatten the sequences yielded by each element. [Keeps the order of the sequential equivalent.]
+		auto Flatten()		const &		{ return		   Then([](auto&& q) { return move(q).Flatten(); }); }
+		auto Flatten()		&&			{ return move(*this).Then([](auto&& q) { return move(q).Flatten(); }); }
+
+
+		/// Limit the number of threads used to evaluate this query.
+		ParallelEnumerable	WithDegreeOfParallelism(size_t n) const &	{ return { TPartitioner { partitioner }, TPipeline { pipeline }, n, executor }; }
+		ParallelEnumerable	WithDegreeOfParallelism(size_t n) &&		{ return { move(partitioner), move(pipeline), n, executor }; }
+
+		/// Schedule the evaluation of this query on @p ex instead of DefaultExecutor(). [Must outlive the evaluation.]
+		ParallelEnumerable	WithExecutor(IExecutor& ex) const &			{ return { TPartitioner { partitioner }, TPipeline { pipeline }, degree, &ex }; }
+		ParallelEnumerable	WithExecutor(IExecutor& ex) &&				{ return { move(partitioner), move(pipeline), degree, &ex }; }
+
+		/// Inclusive prefix accumulation by an associative @p combiner : (Acc, Acc) -> Acc, computed in parallel
+		/// by two passes over fixed blocks - then cached, like Order().
+		/// @remarks	The resulting AutoEnumerable can be turned AsParallel again.
+		template <class Acc = TElemDecayed, class F>
+		auto	Scan(F&& combiner) const &
+		{
+			return WrapFactory([query = *this, combiner = forward<F>(combiner)]() {
+				return ParallelScannerEnumerator<ParallelEnumerable, decay_t<F>, Acc> { query, combiner };
+			});
+		}
+
+		template <class Acc = TElemDecayed, class F>
+		auto	Scan(F&& combiner) &&
+		{
+			return WrapFactory([query = move(*this), combiner = forward<F>(combiner)]() {
+				return ParallelScannerEnumerator<ParallelEnumerable, decay_t<F>, Acc> { query, combiner };
+			});
+		}
+
+
+		/// Continue as a regular, sequentially evaluated AutoEnumerable.
+		auto				AsSequential() const &	{ return pipeline(partitioner.SequentialSource()); }
+		auto				AsSequential() &&		{ return pipeline(move(partitioner).SequentialSource()); }
+
+
+		// =========== Terminal operations ===========================================================================================
+
+		size_t					Count()	const;
+		bool					Any()	const;
+
+		template <class Pred>	bool	Any(const Pred& p) const;
+		template <class Pred>	bool	All(const Pred& p) const;
+
+		template <class Comp = std::less<>>	Optional<TElemDecayed>	Min(const Comp& isLess = {}) const;
+		template <class Comp = std::less<>>	Optional<TElemDecayed>	Max(const Comp& isLess = {}) const;
+
+		/// Sum of elements. Floating-point results are bit-identical regardless of the executor and the degree of parallelism.
+		template <class S = TElemDecayed>	S						Sum() const;
+		template <class S = TElemDecayed>	Optional<S>				Avg() const;
+
+
+		/// FoldL of each chunk - starting from a copy of @p seed -, then merge of the partial accumulators in chunk order.
+		/// @param combiner:	(Acc&&, TElem) -> Acc
+		/// @param merger:		(Acc&&, Acc&&) -> Acc, must be associative, having @p seed as its identity
+		/// @returns			Acc, by default the decayed type of @p seed - which is returned for empty input
+		template <class Acc = void, class Init, class F, class M>
+		auto	Aggregate(Init&& seed, const F& combiner, const M& merger) const;
+
+		/// Aggregate the elements of each key separately, like Aggregate(seed, combiner, merger).
+		/// Each chunk pre-aggregates into local tables per hash-partition of keys, which get merged by a reducer per partition.
+		/// @returns	Dictionary of keys and their accumulators
+		template <class Acc = void, class KeyMapper, class Init, class F, class M>
+		auto	AggregateBy(const KeyMapper& toKey, Init&& seed, const F& combiner, const M& merger) const;
+
+		/// AggregateBy(toKey, seed, combiner, merger) leaving its partitions as shards.
+		/// @param shardCount:	0 = a few times the degree of parallelism
+		/// @param hasher:		must be consistent with the key equality used by DictionaryType
+		/// @returns	ShardedDictionary of keys and their accumulators
+		template <class Acc = void, class KeyMapper, class Init, class F, class M, class Hasher = StdHasher>
+		auto	ShardedAggregateBy(const KeyMapper& toKey, Init&& seed, const F& combiner, const M& merger,
+								   size_t shardCount = 0, const Hasher& hasher = {}) const;
+
+		/// Group the elements by key, preserving their sequential order within each group.
+		/// @returns	Dictionary of keys and Lists of their elements
+		template <class KeyMapper>
+		auto	GroupBy(const KeyMapper& toKey) const;
+
+		/// Form a List in the order of the sequential equivalent.
+		template <class... Options>
+		ListType<TElemDecayed, Options...>	ToList()	const;
+
+		/// Form a Set merging the shards of ToShardedSet().
+		template <class... Options>
+		SetType<TElemDecayed, Options...>	ToSet()		const;
+
+		/// Form a Dictionary with unique keys, merging the shards of ToShardedDictionary().
+		/// On duplicated keys the outcome matches the sequential equivalent.
+		template <class... Options, class KeyMapper>
+		auto	ToDictionary(const KeyMapper& toKey) const;
+
+		template <class... Options, class KeyMapper, class ValueMapper>
+		auto	ToDictionary(const KeyMapper& toKey, const ValueMapper& toValue) const;
+
+		/// Form a read-only Set partitioned by hash into shards, which get built concurrently.
+		/// @param shardCount:	0 = a few times the degree of parallelism
+		/// @param hasher:		must be consistent with the equality used by SetType
+		template <class... Options, class Hasher = StdHasher>
+		auto	ToShardedSet(size_t shardCount = 0, const Hasher& hasher = {}) const;
+
+		/// Form a read-only Dictionary partitioned by the hash of keys into shards, which get built concurrently.
+		/// On duplicated keys the first element is kept, like sequentially.
+		/// @param shardCount:	0 = a few times the degree of parallelism
+		/// @param hasher:		must be consistent with the key equality used by DictionaryType
+		template <class... Options, class KeyMapper, class ValueMapper, class Hasher = StdHasher>
+		auto	ToShardedDictionary(const KeyMapper& toKey, const ValueMapper& toValue, size_t shardCount = 0, const Hasher& hasher = {}) const;
+
+#	if ENUMERABLES_USE_MULTIPROCESS
+		/// Evaluate the shards of the source in forked worker processes, which write their results into a memory mapping
+		/// read by this process in place. Isolates crashes of the workers, reported by throwing LogicException.
+		/// @param processCount:	0 = the degree of parallelism
+		/// @remarks
+		///		Results must be trivially copyable. Worker processes only have the forking thread,
+		///		so the callables of the query must not rely on other threads or locks held by them.
+		///		Shards outgrowing their source elements (e.g. by Flatten) get evaluated once more into a regrown mapping.
+		SharedMemoryList<TElemDecayed>		ToSharedMemoryList(size_t processCount = 0) const;
+#	endif
+	};
+
+
+
+	template <class TPartitioner, class TPipeline>
+	size_t	ParallelEnumerable<TPartitioner, TPipeline>::Count() const
+	{
+		auto counts = EvaluateChunks([](TQuery& q) { return q.Count(); });
+
+		size_t total = 0;
+		for (size_t c : counts)
+			total += c;
+
+		return total;
+	}
+
+
+	/// Shared early-exit: chunks stop at the next element once any of them has found a match.
+	template <class TPartitioner, class TPipeline>
+	template <class Pred>
+	bool	ParallelEnumerable<TPartitioner, TPipeline>::FindAny(const Pred& pred) const
+	{
+		std::atomic<bool> found { false };
+
+		EvaluateChunks([&found, &pred](TQuery& q) {
+			auto notFound = [&found](const auto&) { return !found.load(std::memory_order_relaxed); };
+
+			bool foundHere = q.TakeWhile(notFound).Where(RefLambda(pred)).Any();
+			if (foundHere)
+				found.store(true, std::memory_order_relaxed);
+
+			return foundHere;
+		});
+		return found.load();
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	bool	ParallelEnumerable<TPartitioner, TPipeline>::Any() const
+	{
+		return FindAny([](const auto&) { return true; });
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Pred>
+	bool	ParallelEnumerable<TPartitioner, TPipeline>::Any(const Pred& p) const
+	{
+		return FindAny(p);
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Pred>
+	bool	ParallelEnumerable<TPartitioner, TPipeline>::All(const Pred& p) const
+	{
+		return !FindAny([&p](auto&& x) { return !p(x); });
+	}
+
+
+	// Chunk-wise extremes are compared in chunk order -> the first one wins, just like sequentially.
+	template <class TPartitioner, class TPipeline>
+	template <class Comp>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::Min(const Comp& isLess) const -> Optional<TElemDecayed>
+	{
+		auto partials = EvaluateChunks([&isLess](TQuery& q) { return q.Min(isLess); });
+
+		auto isLessRef = RefLambda(isLess);
+		const auto& isLessLambda = LambdaCreators::BinaryPredicate<TElemConstParam>(isLessRef);
+
+		Optional<TElemDecayed>* min = nullptr;
+		for (Optional<TElemDecayed>& p : partials) {
+			if (HasValue(p) && (min == nullptr || isLessLambda(*p, **min)))
+				min = &p;
+		}
+		if (min == nullptr)
+			return NoValue<TElemDecayed>(StopReason::Empty);
+
+		return move(*min);
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Comp>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::Max(const Comp& isLess) const -> Optional<TElemDecayed>
+	{
+		auto isLessRef = RefLambda(isLess);
+
+		return Min(SwappedBinop(LambdaCreators::BinaryPredicate<TElemConstParam>(isLessRef)));
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class S>
+	S		ParallelEnumerable<TPartitioner, TPipeline>::Sum() const
+	{
+		return SumOf<S>(std::is_floating_point<S> {});
+	}
+
+
+	// Floating-point sums are reproducible: blocks of fixed length are merged by a fixed tree,
+	// thus the result is bit-identical on any executor and any degree of parallelism.
+	template <class TPartitioner, class TPipeline>
+	template <class S>
+	S		ParallelEnumerable<TPartitioner, TPipeline>::SumOf(std::true_type) const
+	{
+		auto partials = EvaluateBlocks(ENUMERABLES_PARALLEL_SUM_BLOCK, [](TQuery& q) { return CompensatedPartial<S>::Of(q); });
+		auto total	  = ReduceByTree(partials);
+
+		return total.sum + total.err;
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class S>
+	S		ParallelEnumerable<TPartitioner, TPipeline>::SumOf(std::false_type) const
+	{
+		auto partials = EvaluateChunks([](TQuery& q) { return q.template Sum<S>(); });
+		auto et		  = CreateEnumeratorFor(partials);
+
+		return SumEnumerated<S>(et);
+	}
+
+
+	// Reproducible, like floating-point Sum.
+	template <class TPartitioner, class TPipeline>
+	template <class S>
+	Optional<S>	ParallelEnumerable<TPartitioner, TPipeline>::Avg() const
+	{
+		static_assert (std::is_floating_point<S>::value, "Intended for floating-point operations.");
+
+		auto partials = EvaluateBlocks(ENUMERABLES_PARALLEL_SUM_BLOCK, [](TQuery& q) { return CompensatedPartial<S>::Of(q); });
+		auto total	  = ReduceByTree(partials);
+
+		if (total.count) {
+			return total.sum / static_cast<S>(total.count)
+				 + total.err / static_cast<S>(total.count);
+		}
+		return NoValue<S>(StopReason::Empty);
+	}
+
+
+	// 1st pass: local scans of fixed blocks
+	// 2nd pass: combine each block with the total of the preceding ones
+	template <class TPartitioner, class TPipeline>
+	template <class Acc, class F>
+	ListType<Acc>	ParallelEnumerable<TPartitioner, TPipeline>::ScanToList(const F& combiner) const
+	{
+		auto blocks = EvaluateBlocks(ENUMERABLES_PARALLEL_MIN_CHUNK, [&combiner](TQuery& q) {
+			auto local = ListOperations::Init<ListType<Acc>>(0);
+
+			auto et = q.GetEnumeratorNoDebug();
+			if (et.FetchNext()) {
+				ListOperations::Add(local, static_cast<Acc>(et.Current()));
+				while (et.FetchNext()) {
+					Acc next = combiner(ListOperations::Access(local, GetSize(local) - 1), static_cast<Acc>(et.Current()));
+					ListOperations::Add(local, move(next));
+				}
+			}
+			return local;
+		});
+
+		size_t count   = GetSize(blocks);
+		auto   offsets = ListOperations::Init<ListType<Deferred<Acc>>>(count);
+		for (size_t i = 0; i < count; ++i) {
+			ListOperations::Add(offsets, Deferred<Acc> {});
+			if (i == 0)
+				continue;
+
+			Deferred<Acc>&	prevOffset = ListOperations::Access(offsets, i - 1);
+			ListType<Acc>&	prevBlock  = ListOperations::Access(blocks, i - 1);
+			Deferred<Acc>&	offset	   = ListOperations::Access(offsets, i);
+			if (GetSize(prevBlock) == 0) {
+				if (prevOffset.IsInitialized())
+					offset.Construct(*prevOffset);
+			}
+			else {
+				const Acc& prevTotal = ListOperations::Access(prevBlock, GetSize(prevBlock) - 1);
+				if (prevOffset.IsInitialized())
+					offset.AcceptRvo([&]() -> Acc { return combiner(*prevOffset, prevTotal); });
+				else
+					offset.Construct(prevTotal);
+			}
+		}
+
+		Schedule(count, 1, [&](size_t bb, size_t be) {
+			for (size_t i = bb; i < be; ++i) {
+				Deferred<Acc>& offset = ListOperations::Access(offsets, i);
+				if (!offset.IsInitialized())
+					continue;
+
+				for (Acc& x : ListOperations::Access(blocks, i))
+					x = combiner(*offset, x);
+			}
+		});
+
+		size_t total = 0;
+		for (ListType<Acc>& b : blocks)
+			total += GetSize(b);
+
+		auto result = ListOperations::Init<ListType<Acc>>(total);
+		for (ListType<Acc>& b : blocks) {
+			for (Acc& x : b)
+				ListOperations::Add(result, move(x));
+		}
+		return result;
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Acc, class Init, class F, class M>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::Aggregate(Init&& seed, const F& combiner, const M& merger) const
+	{
+		using TAcc = OverrideT<Acc, decay_t<Init>>;
+
+		const TAcc init { forward<Init>(seed) };
+
+		auto partials = EvaluateChunks([&init, &combiner](TQuery& q) {
+			TAcc acc { init };
+
+			auto et = q.GetEnumeratorNoDebug();
+			while (et.FetchNext())
+				acc = combiner(move(acc), et.Current());
+
+			return acc;
+		});
+
+		TAcc& result = ListOperations::Access(partials, 0);
+		for (size_t i = 1; i < GetSize(partials); ++i)
+			result = merger(move(result), move(ListOperations::Access(partials, i)));
+
+		return move(result);
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Acc, class KeyMapper, class Init, class F, class M>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::AggregateBy(const KeyMapper& toKey, Init&& seed, const F& combiner, const M& merger) const
+	{
+		return ShardedAggregateBy<Acc>(toKey, forward<Init>(seed), combiner, merger).Merge();
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Acc, class KeyMapper, class Init, class F, class M, class Hasher>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ShardedAggregateBy(const KeyMapper& toKey, Init&& seed, const F& combiner, const M& merger,
+																		size_t shardCount, const Hasher& hasher) const
+	{
+		auto		keyRef = RefLambda(toKey);
+		const auto& keyOf  = LambdaCreators::UniformMapper<TElem&>(keyRef);
+
+		using TAcc = OverrideT<Acc, decay_t<Init>>;
+		using K	   = decay_t<decltype(keyOf(declval<TElem&>()))>;
+		using Dict = DictionaryType<K, TAcc>;
+
+		const TAcc init { forward<Init>(seed) };
+
+		if (shardCount == 0)
+			shardCount = DefaultShardCount();
+
+		auto shards = ReduceShards<Dict>(
+			shardCount,
+			[]() { return DictOperations::Init<Dict>(0); },
+			[&](TQuery& q, ListType<Dict>& parts) {
+				auto et = q.GetEnumeratorNoDebug();
+				while (et.FetchNext()) {
+					auto&& elem  = et.Current();
+					const K key	 = keyOf(elem);
+					Dict&	part = ListOperations::Access(parts, ShardIndex(hasher(key), shardCount));
+					if (!DictOperations::Contains(part, key))
+						DictOperations::Add(part, key, init);
+
+					TAcc& acc = DictOperations::Access(part, key);
+					acc = combiner(move(acc), forward<decltype(elem)>(elem));
+				}
+			},
+			[&merger](ListType<ListType<Dict>>& partsOfChunks, size_t shard) {
+				Dict result = move(ListOperations::Access(ListOperations::Access(partsOfChunks, 0), shard));
+				for (size_t c = 1; c < GetSize(partsOfChunks); ++c) {
+					for (auto& kv : ListOperations::Access(ListOperations::Access(partsOfChunks, c), shard)) {
+						if (DictOperations::Contains(result, kv.first)) {
+							TAcc& acc = DictOperations::Access(result, kv.first);
+							acc = merger(move(acc), move(kv.second));
+						}
+						else {
+							DictOperations::Add(result, kv.first, move(kv.second));
+						}
+					}
+				}
+				Finalize<DictOperations>(result);
+				return result;
+			}
+		);
+		return ShardedDictionary<K, TAcc, Hasher> { move(shards), hasher };
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class KeyMapper>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::GroupBy(const KeyMapper& toKey) const
+	{
+		using Group = ListType<TElemDecayed>;
+
+		return AggregateBy<Group>(
+			toKey,
+			ListOperations::Init<Group>(0),
+			[](Group&& group, auto&& elem) -> Group {
+				ListOperations::Add(group, forward<decltype(elem)>(elem));
+				return move(group);
+			},
+			[](Group&& group, Group&& tail) -> Group {
+				for (TElemDecayed& elem : tail)
+					ListOperations::Add(group, move(elem));
+				return move(group);
+			}
+		);
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class... Options>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ToList() const -> ListType<TElemDecayed, Options...>
+	{
+		using List = ListType<TElemDecayed, Options...>;
+
+		auto partials = EvaluateChunks([](TQuery& q) { return q.template ToList<Options...>(); });
+		if (GetSize(partials) == 1)
+			return move(ListOperations::Access(partials, 0));
+
+		size_t total = 0;
+		for (List& p : partials)
+			total += GetSize(p);
+
+		List result = ListOperations::Init<List>(total, Options {}...);
+		for (List& p : partials) {
+			for (auto& elem : p)
+				ListOperations::Add(result, move(elem));
+		}
+		return result;
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Part, class InitOp, class PartitionOp, class ReduceOp>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ReduceShards(size_t shardCount, const InitOp& initPart,
+																  const PartitionOp& partition, const ReduceOp& reduce) const
+	{
+		using Parts = ListType<Part>;
+		using Shard = decltype(reduce(declval<ListType<Parts>&>(), size_t {}));
+
+		auto partsOfChunks = EvaluateChunks([&](TQuery& q) {
+			auto parts = ListOperations::Init<Parts>(shardCount);
+			for (size_t s = 0; s < shardCount; ++s)
+				ListOperations::Add(parts, initPart());
+
+			partition(q, parts);
+			return parts;
+		});
+
+		std::vector<Deferred<Shard>> slots (shardCount);
+		Schedule(shardCount, 1, [&](size_t b, size_t e) {
+			for (size_t s = b; s < e; ++s)
+				slots[s].AcceptRvo([&]() -> Shard { return reduce(partsOfChunks, s); });
+		});
+
+		std::vector<Shard> shards;
+		shards.reserve(shardCount);
+		for (Deferred<Shard>& shard : slots)
+			shards.push_back(shard.PassValue());
+
+		return shards;
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class Shard, class ItemOp, class ShardOp, class InitOp, class InsertOp>
+	std::vector<Shard>	ParallelEnumerable<TPartitioner, TPipeline>::BuildShards(size_t shardCount, const ItemOp& toItem, const ShardOp& shardOf,
+																			 const InitOp& initShard, const InsertOp& insert) const
+	{
+		using Item	  = decltype(toItem(declval<TElem>()));
+		using Buckets = ListType<ListType<Item>>;
+
+		return ReduceShards<ListType<Item>>(
+			shardCount,
+			[]() { return ListOperations::Init<ListType<Item>>(0); },
+			[&](TQuery& q, Buckets& buckets) {
+				auto et = q.GetEnumeratorNoDebug();
+				while (et.FetchNext()) {
+					Item item = toItem(et.Current());
+					ListOperations::Add(ListOperations::Access(buckets, shardOf(item)), move(item));
+				}
+			},
+			[&](ListType<Buckets>& bucketsOfChunks, size_t s) -> Shard {
+				size_t total = 0;
+				for (Buckets& buckets : bucketsOfChunks)
+					total += GetSize(ListOperations::Access(buckets, s));
+
+				Shard shard = initShard(total);
+				for (Buckets& buckets : bucketsOfChunks) {
+					for (Item& item : ListOperations::Access(buckets, s))
+						insert(shard, move(item));
+				}
+				return shard;
+			}
+		);
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class... Options>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ToSet() const -> SetType<TElemDecayed, Options...>
+	{
+		return ToShardedSet<Options...>().Merge(Options {}...);
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class... Options, class KeyMapper>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ToDictionary(const KeyMapper& toKey) const
+	{
+		return ToDictionary<Options...>(toKey, Forwarder<TElem> {});
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class... Options, class KeyMapper, class ValueMapper>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ToDictionary(const KeyMapper& toKey, const ValueMapper& toValue) const
+	{
+		return ToShardedDictionary<Options...>(toKey, toValue).Merge(Options {}...);
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class... Options, class Hasher>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ToShardedSet(size_t shardCount, const Hasher& hasher) const
+	{
+		using Set = SetType<TElemDecayed, Options...>;
+
+		if (shardCount == 0)
+			shardCount = DefaultShardCount();
+
+		auto shards = BuildShards<Set>(
+			shardCount,
+			[](auto&& elem) -> TElemDecayed		{ return forward<decltype(elem)>(elem); },
+			[&](const TElemDecayed& elem)		{ return ShardIndex(hasher(elem), shardCount); },
+			[](size_t capacity)					{ return SetOperations::Init<Set>(capacity, Options {}...); },
+			[](Set& set, TElemDecayed&& elem)	{ SetOperations::Add(set, move(elem)); }
+		);
+		return ShardedSet<TElemDecayed, Hasher, Options...> { move(shards), hasher };
+	}
+
+
+	template <class TPartitioner, class TPipeline>
+	template <class... Options, class KeyMapper, class ValueMapper, class Hasher>
+	auto	ParallelEnumerable<TPartitioner, TPipeline>::ToShardedDictionary(const KeyMapper& toKey, const ValueMapper& toValue,
+																		 size_t shardCount, const Hasher& hasher) const
+	{
+		auto		keyRef	 = RefLambda(toKey);
+		auto		valueRef = RefLambda(toValue);
+		const auto& keyOf	 = LambdaCreators::UniformMapper<TElem&>(keyRef);
+		const auto& valueOf	 = LambdaCreators::UniformMapper<TElem&&>(valueRef);
+
+		using K	   = decay_t<decltype(keyOf(declval<TElem&>()))>;
+		using V	   = decay_t<decltype(valueOf(declval<TElem>()))>;
+		using Pair = std::pair<K, V>;
+		using Dict = DictionaryType<K, V, Options...>;
+
+		if (shardCount == 0)
+			shardCount = DefaultShardCount();
+
+		auto shards = BuildShards<Dict>(
+			shardCount,
+			[&keyOf, &valueOf](auto&& elem) {
+				K key = keyOf(elem);
+				return Pair { move(key), valueOf(forward<decltype(elem)>(elem)) };
+			},
+			[&](const Pair& kv)			{ return ShardIndex(hasher(kv.first), shardCount); },
+			[](size_t capacity)			{ return DictOperations::Init<Dict>(capacity, Options {}...); },
+			[](Dict& dict, Pair&& kv)	{ DictOperations::Add(dict, move(kv.first), move(kv.second)); }
+		);
+		for (Dict& shard : shards)
+			Finalize<DictOperations>(shard);
+
+		return ShardedDictionary<K, V, Hasher, Options...> { move(shards), hasher };
+	}
+
+#pragma endregion
+
+
+
+#pragma region Buffered
+
+	/// Single-producer, single-consumer ring buffer of fixed capacity.
+	/// Lock-free, except for the consumer sleeping when found empty. The producer is expected to pause when found full.
+	template <class T>
+	class SpscRing {
+		const size_t								capacity;
+		std::unique_ptr<DeferredReplaceable<T>[]>	slots;			// consumed elements are destroyed on reuse
+
+		std::atomic<size_t>			head		{ 0 };		// next to fill - by producer
+		std::atomic<size_t>			tail		{ 0 };		// next to consume - by consumer
+		std::atomic<bool>			closed		{ false };
+		std::atomic<bool>			cancelled	{ false };
+
+		std::mutex					sleepLock;
+		std::condition_variable		wakeup;
+		std::atomic<size_t>			sleepers	{ 0 };
+
+
+		void	Notify()
+		{
+			if (sleepers.load() > 0) {
+				std::lock_guard<std::mutex> guard { sleepLock };
+				wakeup.notify_all();
+			}
+		}
+
+	public:
+		size_t	Size() const			{ return head.load() - tail.load(); }
+
+
+		// ---- Producer side ----
+
+		bool	IsCancelled() const		{ return cancelled.load(std::memory_order_relaxed); }
+		bool	IsFull() const			{ return Size() >= capacity; }
+
+		/// Construct the result of @p create in the next slot. [Only if !IsFull()]
+		template <class F>
+		void	Push(F&& create)
+		{
+			size_t h = head.load(std::memory_order_relaxed);
+			slots[h % capacity].AcceptRvo(create);
+			head.store(h + 1);
+			Notify();
+		}
+
+		/// Signal that no more elements will be pushed.
+		void	Close()
+		{
+			closed.store(true);
+			Notify();
+		}
+
+
+		// ---- Consumer side ----
+
+		/// Has an element to consume, or it is closed.
+		bool	IsReady() const			{ return head.load() != tail.load(std::memory_order_relaxed) || closed.load(); }
+
+		/// Not closed and depleted. [Only if IsReady()]
+		bool	HasFront() const		{ return head.load() != tail.load(std::memory_order_relaxed); }
+
+		/// Sleep until IsReady(), for at most @p limit.
+		template <class Duration>
+		void	AwaitReady(const Duration& limit)
+		{
+			std::unique_lock<std::mutex> lock { sleepLock };
+			sleepers.fetch_add(1);
+			wakeup.wait_for(lock, limit, [this]() { return IsReady(); });
+			sleepers.fetch_sub(1);
+		}
+
+		T&		Front()		{ return slots[tail.load(std::memory_order_relaxed) % capacity].Value(); }
+
+		void	Pop()		{ tail.store(tail.load(std::memory_order_relaxed) + 1); }
+
+		/// Stop the producer before its next element.
+		void	Cancel()	{ cancelled.store(true); }
+
+
+		explicit SpscRing(size_t capacity) :
+			capacity { capacity > 0 ? capacity : 1 },
+			slots	 { new DeferredReplaceable<T>[capacity > 0 ? capacity : 1] }
+		{
+		}
+	};
+
+
+
+	/// Runs its source as a task on an IExecutor, which is submitted by the first FetchNext.
+	/// @remarks
+	///		The task pauses when the buffer gets full, to be resubmitted by the consumer once it is half empty.
+	///		Thus it doesn't hold a worker while waiting, and the consumer can execute it when there are no free workers.
+	///		Elements are buffered as StorableT: references are kept as such, but rvalues are stored by value.
+	template <class Source>
+	class BufferedEnumerator final : public IEnumerator<EnumeratedT<Source>> {
+	public:
+		using typename BufferedEnumerator::IEnumerator::TElem;
+
+	private:
+		struct Shared final : public ITask {
+			IExecutor&						executor;
+			Source							source;
+			SpscRing<StorableT<TElem>>		ring;
+			std::exception_ptr				error;					// published by ring.Close()
+			std::atomic<bool>				paused	{ false };		// found the ring full - to be resubmitted by the consumer
+			std::atomic<size_t>				running	{ 0 };			// submitted executions
+
+
+			void Start()
+			{
+				running.fetch_add(1);
+				executor.Submit(*this);
+			}
+
+
+			/// Found full: the consumer either resumes it later, or has just made room.
+			/// @returns	false if it was handed over to the consumer
+			bool ContinueWhenFull()
+			{
+				paused.store(true);
+				return !ring.IsFull() && paused.exchange(false);
+			}
+
+
+			void Execute() override
+			{
+				try {
+					while (!ring.IsCancelled()) {
+						if (ring.IsFull() && !ContinueWhenFull()) {
+							running.fetch_sub(1);		// this may be destroyed or executed again from here
+							return;
+						}
+						if (!source.FetchNext())
+							break;
+
+						ring.Push([this]() -> StorableT<TElem> { return source.Current(); });
+					}
+				}
+				catch (...) {
+					error = std::current_exception();
+				}
+				ring.Close();
+				running.fetch_sub(1);
+			}
+
+
+			template <class Factory>
+			Shared(Factory&& getSource, size_t capacity, IExecutor& executor) :
+				executor { executor },
+				source	 { getSource() },
+				ring	 { capacity }
+			{
+			}
+		};
+
+		std::unique_ptr<Shared>	shared;			// stable for the task
+		size_t					resumeAt;
+		bool					started = false;
+		bool					holding = false;
+
+	public:
+		bool FetchNext() override
+		{
+			Shared& sh = *shared;
+			if (!started) {
+				sh.Start();
+				started = true;
+			}
+			else if (holding) {
+				sh.ring.Pop();
+				if (sh.paused.load() && sh.ring.Size() <= resumeAt && sh.paused.exchange(false))
+					sh.Start();
+			}
+
+			// help executing tasks, or wait for the producer
+			while (!sh.ring.IsReady()) {
+				if (!sh.executor.RunPendingTask())
+					sh.ring.AwaitReady(std::chrono::milliseconds { 1 });
+			}
+
+			holding = sh.ring.HasFront();
+			if (!holding && sh.error)
+				std::rethrow_exception(sh.error);
+
+			return holding;
+		}
+
+
+		TElem Current() override
+		{
+			ENUMERABLES_ETOR_USAGE_ASSERT (holding, NotFetchedError);
+			return static_cast<TElem>(Revive(shared->ring.Front()));
+		}
+
+
+		SizeInfo Measure() const override
+		{
+			return started ? SizeInfo { Boundedness::Unknown } : shared->source.Measure();
+		}
+
+
+		IEnumerator<TElem>*	MoveTo(void* mem) override
+		{
+			return MoveToAligned(mem, this);
+		}
+
+
+		template <class Factory>
+		BufferedEnumerator(Factory&& getSource, size_t capacity, IExecutor* executor) :
+			shared	 { new Shared { forward<Factory>(getSource), capacity, executor != nullptr ? *executor : DefaultExecutor() } },
+			resumeAt { (capacity > 0 ? capacity : 1) / 2 }
+		{
+		}
+
+		BufferedEnumerator(BufferedEnumerator&&) = default;
+
+		~BufferedEnumerator() override
+		{
+			if (shared == nullptr)
+				return;
+
+			shared->ring.Cancel();
+			while (shared->running.load() > 0) {
+				if (!shared->executor.RunPendingTask())
+					std::this_thread::yield();
+			}
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region FlattenParallel
+
+	/// Enumerates the nested sequences of its source by tasks, up to a limited number at once.
+	/// @remarks
+	///		Each task enumerates a batch into the buffer of its sequence, then resubmits itself - or pauses while
+	///		the buffer is full, to be resumed by the consumer. Thus the consumer can help executing them when idle.
+	template <class Source>
+	class ParallelFlattenerEnumerator final : public IEnumerator<IterableT<EnumeratedT<Source>>> {
+	public:
+		using typename ParallelFlattenerEnumerator::IEnumerator::TElem;
+
+	private:
+		using NestedEb = EnumeratedT<Source>;
+		using Deducer  = UniformEnumerationDeducer<NestedEb>;
+		using NestedEt = decltype(Deducer::GetEnumerator(std::declval<NestedEb&>()));
+
+		static constexpr size_t Batch	 = ENUMERABLES_PARALLEL_FLATTEN_BATCH > 0 ? ENUMERABLES_PARALLEL_FLATTEN_BATCH : 1;
+		static constexpr size_t Capacity = 4 * Batch;
+
+
+		struct Shared {
+			IExecutor&					executor;
+			std::mutex					lock;
+			std::condition_variable		progress;
+			std::atomic<bool>			cancelled	{ false };
+			std::atomic<size_t>			running		{ 0 };		// submitted tasks
+
+			explicit Shared(IExecutor& executor) : executor { executor }
+			{
+			}
+		};
+
+
+		struct Nested final : public ITask {
+			Shared&							shared;
+			Deferred<NestedEb>				eb;				// lifetime might be tied to it! (e.g. ToMaterialized())
+			Deferred<NestedEt>				et;				// by the task only
+
+			// guarded by shared.lock
+			std::deque<StorableT<TElem>>	elems;
+			std::exception_ptr				error;
+			bool							done	= false;
+			bool							paused	= false;
+
+
+			void Execute() override
+			{
+				Shared& sh		 = shared;
+				bool	finished = true;
+				try {
+					if (!et.IsInitialized())
+						et.AcceptRvo([this]() { return Deducer::GetEnumerator(*eb); });
+
+					size_t n = 0;
+					while (!sh.cancelled.load(std::memory_order_relaxed) && (finished = !(*et).FetchNext()) == false) {
+						Deferred<TElem> elem;
+						elem.AcceptCurrent(*et);
+						{
+							std::lock_guard<std::mutex> guard { sh.lock };
+							elems.emplace_back(elem.PassValue());
+						}
+						sh.progress.notify_all();
+
+						if (++n == Batch)
+							break;
+					}
+					finished = finished || sh.cancelled.load(std::memory_order_relaxed);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> guard { sh.lock };
+					error	 = std::current_exception();
+					finished = true;
+				}
+
+				bool resubmit = false;
+				{
+					std::lock_guard<std::mutex> guard { sh.lock };
+					done	 = finished;
+					paused	 = !finished && elems.size() >= Capacity;
+					resubmit = !finished && !paused;
+				}
+				// this may be destroyed or executed again from here
+				if (resubmit) {
+					sh.executor.Submit(*this);
+					return;
+				}
+				sh.progress.notify_all();
+				sh.running.fetch_sub(1);
+			}
+
+			explicit Nested(Shared& shared) : shared { shared }
+			{
+			}
+		};
+
+
+		enum class Pick { Taken, Finished, None };
+
+
+		Source									source;
+		std::unique_ptr<Shared>					shared;			// stable for the tasks
+		std::deque<std::unique_ptr<Nested>>		inFlight;
+		DeferredReplaceable<TElem>				current;
+		size_t									maxInFlight;
+		FlattenOrder							order;
+		bool									outerDepleted = false;
+
+
+		void Start(Nested& nested)
+		{
+			shared->running.fetch_add(1);
+			shared->executor.Submit(nested);
+		}
+
+
+		void Launch()
+		{
+			while (!outerDepleted && inFlight.size() < maxInFlight) {
+				if (!source.FetchNext()) {
+					outerDepleted = true;
+					return;
+				}
+				std::unique_ptr<Nested> nested { new Nested { *shared } };
+				nested->eb.AcceptCurrent(source);
+				Start(*nested);
+				inFlight.push_back(move(nested));
+			}
+		}
+
+
+		/// Take the next available element or drop a finished sequence. [Under shared->lock.]
+		Pick TryPick(std::exception_ptr& error, Nested*& toResume)
+		{
+			size_t candidates = (order == FlattenOrder::Preserved) ? 1 : inFlight.size();
+
+			for (size_t i = 0; i < candidates; ++i) {
+				Nested& nested = *inFlight[i];
+				if (!nested.elems.empty()) {
+					current.AcceptRvo([&nested]() -> TElem { return PassRevived(nested.elems.front()); });
+					nested.elems.pop_front();
+
+					if (nested.paused && nested.elems.size() < Capacity / 2) {
+						nested.paused = false;
+						toResume	  = &nested;
+					}
+					return Pick::Taken;
+				}
+				if (nested.done) {
+					error = nested.error;
+					inFlight.erase(inFlight.begin() + i);
+					return Pick::Finished;
+				}
+			}
+			return Pick::None;
+		}
+
+	public:
+		bool FetchNext() override
+		{
+			for (;;) {
+				Launch();
+				if (inFlight.empty())
+					return false;
+
+				std::exception_ptr error;
+				Nested*			   toResume = nullptr;
+				Pick			   pick;
+				{
+					std::lock_guard<std::mutex> guard { shared->lock };
+					pick = TryPick(error, toResume);
+				}
+				if (toResume != nullptr)
+					Start(*toResume);
+				if (error)
+					std::rethrow_exception(error);
+				if (pick == Pick::Taken)
+					return true;
+				if (pick == Pick::Finished)
+					continue;
+
+				// help executing the batches, or wait for the running ones
+				if (shared->executor.RunPendingTask())
+					continue;
+
+				std::unique_lock<std::mutex> lock { shared->lock };
+				shared->progress.wait_for(lock, std::chrono::milliseconds { 1 });
+			}
+		}
+
+
+		TElem Current() override
+		{
+			ENUMERABLES_ETOR_USAGE_ASSERT (current.IsInitialized(), NotFetchedError);
+			return *current;
+		}
+
+
+		SizeInfo			Measure()   const override	{ return { Boundedness::Unknown }; }
+		IEnumerator<TElem>*	MoveTo(void* mem) override	{ return MoveToAligned(mem, this); }
+
+
+		template <class Factory>
+		ParallelFlattenerEnumerator(Factory&& getSource, size_t maxInFlight, FlattenOrder order, IExecutor* executor) :
+			source		{ getSource() },
+			shared		{ new Shared { executor != nullptr ? *executor : DefaultExecutor() } },
+			maxInFlight	{ maxInFlight > 0 ? maxInFlight : 1 },
+			order		{ order }
+		{
+		}
+
+		ParallelFlattenerEnumerator(ParallelFlattenerEnumerator&&) = default;
+
+		~ParallelFlattenerEnumerator() override
+		{
+			if (shared == nullptr)
+				return;
+
+			shared->cancelled.store(true);
+			while (shared->running.load() > 0) {
+				if (!shared->executor.RunPendingTask())
+					std::this_thread::yield();
+			}
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region AsParallel
+
+	template <class TFactory>
+	auto AutoEnumerable<TFactory>::AsParallel() const &
+	{
+		static_assert (!IsArenaChain<TEnumerator>::value, "Chains WithArena() cannot be evaluated in parallel: Arena is not thread-safe.");
+
+		using Partitioner = PartitionerFor<AutoEnumerable>;
+		return ParallelEnumerable<Partitioner, IdentityStage> { Partitioner { *this }, IdentityStage {} };
+	}
+
+
+	template <class TFactory>
+	auto AutoEnumerable<TFactory>::AsParallel() &&
+	{
+		static_assert (!IsArenaChain<TEnumerator>::value, "Chains WithArena() cannot be evaluated in parallel: Arena is not thread-safe.");
+
+		using Partitioner = PartitionerFor<AutoEnumerable>;
+		return ParallelEnumerable<Partitioner, IdentityStage> { Partitioner { move(*this) }, IdentityStage {} };
+	}
+
+#pragma endregion
+
+}	// namespace Def
+
+
+using Def::ShardedSet;
+using Def::ShardedDictionary;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_PARALLEL_HPP
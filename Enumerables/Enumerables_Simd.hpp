@@ -0,0 +1,2825 @@
+#ifndef ENUMERABLES_SIMD_HPP
+#define ENUMERABLES_SIMD_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the vectorized arithmetic kernels behind terminal operations (like Sum),	  *
+	 *  which read the elements of contiguous sources directly, bypassing their Enumerators.		  *
+	 *  Included by Enumerables_Implementation.hpp - not to be used directly.						  *
+	 *																								  *
+	 *  --------------------------------------------------------------------------------------------  *
+	 *	Concept:																					  *
+	 *		StridedView recognizes Enumerators in their initial state, which would read evenly		  *
+	 *		strided arithmetic values from memory:													  *
+	 *			- contiguous iterator ranges	(e.g. Enumerate(vector), Enumerate(ptr, ptr + n))	  *
+	 *			- field projections of those	(e.g. Enumerate(vector).Select(&Pair::first))		  *
+	 *		Kernels are dispatched by the instruction set detected once at runtime:					  *
+	 *			- x86:		AVX2 (also gathering strided fields), otherwise SSE2					  *
+	 *			- ARM64:	NEON																	  *
+	 *			- scalar loops otherwise, or when disabled by ENUMERABLES_USE_SIMD					  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <algorithm>
+#include <bitset>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#if ENUMERABLES_USE_SIMD
+#	if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define ENUMERABLES_SIMD_X86		1
+#		ifdef _MSC_VER
+#			include <intrin.h>
+#		endif
+#		include <immintrin.h>
+#	elif defined(__aarch64__) || defined(_M_ARM64)
+#		define ENUMERABLES_SIMD_NEON	1
+#		if defined(_MSC_VER) && !defined(__clang__)
+#			include <arm64_neon.h>
+#		else
+#			include <arm_neon.h>
+#		endif
+#	endif
+#endif
+
+#ifndef ENUMERABLES_SIMD_X86
+#	define ENUMERABLES_SIMD_X86		0
+#endif
+#ifndef ENUMERABLES_SIMD_NEON
+#	define ENUMERABLES_SIMD_NEON	0
+#endif
+
+// SSE2 is the baseline of the x86 kernels, AVX2 ones are compiled for their own target, selected at runtime.
+#if ENUMERABLES_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#	define ENUMERABLES_TARGET_AVX2	__attribute__((target("avx2")))
+#else
+#	define ENUMERABLES_TARGET_AVX2
+#endif
+
+
+
+namespace Enumerables {
+namespace TypeHelpers {
+
+	namespace Simd {
+
+		template <class It, class V, bool = std::is_arithmetic<V>::value || (std::is_class<V>::value && !std::is_abstract<V>::value)>
+		struct IsStdVectorIterator : std::false_type {};
+
+		template <class It, class V>
+		struct IsStdVectorIterator<It, V, true>
+			: std::integral_constant<bool, !std::is_same<V, bool>::value
+										&& (std::is_same<It, typename std::vector<V>::iterator>::value
+											|| std::is_same<It, typename std::vector<V>::const_iterator>::value)> {};
+	}
+
+
+	/// Iterators to elements stored adjacently in memory - vectorized kernels can read them directly.
+	/// @remarks	Recognizes pointers and std::vector iterators (any std::contiguous_iterator since C++20).
+	///				Specialize for iterators of further contiguous containers.
+	template <class It, class = void>
+	struct IsContiguousIterator {
+#if defined(__cpp_lib_concepts)
+		static constexpr bool value = std::contiguous_iterator<It>;
+#else
+		static constexpr bool value = std::is_pointer<It>::value
+								   || Simd::IsStdVectorIterator<It, typename std::iterator_traits<It>::value_type>::value;
+#endif
+	};
+
+}
+
+
+namespace Def {
+
+	using std::size_t;
+
+
+#pragma region Compensated summation
+
+	// https://en.wikipedia.org/wiki/2Sum
+	//template <class S>
+	//void  Sum2(S& sum, const S& n, S& error)
+	//{
+	//	const S s0 = sum;
+	//	sum += n;
+	//	const S diff1 = s0 - (sum - n);
+	//	const S diff2 = n - (sum - s0);
+	//	error += diff1 + diff2;
+	//}
+
+
+	// https://en.wikipedia.org/wiki/Kahan_summation_algorithm
+	// Simple Kahan isn't appropriate since we have no assumptions about magnitudes!
+	// Neurmaier seems to perform slightly better on a current CPU, while slightly worse on an old one.
+	// Neither gives perfect results - Neumaier is the current choice.
+	template <class S>
+	void   NeumaierSum2(S& sum, const S& b, S& error)
+	{
+		const S s0 = sum;
+		sum += b;
+
+		// for growing sums, first branch should be continuously predicted with success
+		if (abs(s0) >= abs(b)) {
+			const S diffB = b - (sum - s0);
+			error += diffB;
+		}
+		else {
+			const S diffA = s0 - (sum - b);
+			error += diffA;
+		}
+	}
+
+
+	template <class S>
+	struct CompensatedSum {
+		S	sum {};
+		S	err {};
+
+		void	Add(const S& b)		{ NeumaierSum2(sum, b, err); }
+		S		Total()		const	{ return sum + err; }
+	};
+
+#pragma endregion
+
+
+
+#pragma region Instruction set
+
+	enum class SimdLevel : char { Scalar, Sse2, Avx2, Neon };
+
+
+	inline SimdLevel	DetectSimdLevel()
+	{
+#if ENUMERABLES_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#elif ENUMERABLES_SIMD_X86
+		int regs[4];
+		__cpuid(regs, 0);
+		if (regs[0] < 7)
+			return SimdLevel::Sse2;
+
+		// AVX registers must be enabled by the OS too
+		__cpuid(regs, 1);
+		const bool osSaves = (regs[2] & (1 << 27)) && (regs[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+
+		__cpuidex(regs, 7, 0);
+		return osSaves && (regs[1] & (1 << 5)) ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#elif ENUMERABLES_SIMD_NEON
+		return SimdLevel::Neon;
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+
+	/// Instruction set used by the kernels - detected on first use.
+	/// @remarks	Can be lowered (not raised!) before evaluations, e.g. to exercise narrower kernels in tests.
+	inline SimdLevel&	ActiveSimdLevel()
+	{
+		static SimdLevel level = DetectSimdLevel();
+		return level;
+	}
+
+#pragma endregion
+
+
+
+#pragma region Strided views
+
+	/// Evenly strided run of values in memory - elements of a contiguous range or a field of them.
+	template <class T>
+	struct StridedSpan {
+		const char*	first;
+		size_t		stride;		// in bytes
+		size_t		count;
+
+		bool		IsContiguous()			const	{ return stride == sizeof(T); }
+		bool		IsGatherable()			const	{ return IsContiguous() || stride <= INT_MAX / 8; }
+		const T&	operator [](size_t i)	const	{ return *reinterpret_cast<const T*>(first + i * stride); }
+
+		StridedSpan	Slice(size_t offset, size_t n)	const	{ return { first + offset * stride, stride, n }; }
+
+		/// Reinterpret as a same-sized type - e.g. the signed counterpart of unsigned elements.
+		template <class U>
+		StridedSpan<U>	As()				const	{ static_assert (sizeof(U) == sizeof(T), "Size mismatch."); return { first, stride, count }; }
+	};
+
+
+	/// Recognizes Enumerators which would read evenly strided values of TValue from memory.
+	/// Specializations provide:
+	///		- TValue
+	///		- static StridedSpan<TValue> Get(const Etor&)	- for an Enumerator in its initial state
+	///		- static void Skip(Etor&, size_t n)				- to step over n elements without fetching them
+	template <class Etor, class = void>
+	struct StridedView {};
+
+
+	template <class It, class ForcedElem>
+	struct StridedView<IteratorEnumerator<It, ForcedElem>,
+					   enable_if_t<IsContiguousIterator<It>::value
+								   && (is_void<ForcedElem>::value
+									   || is_same<decay_t<ForcedElem>, std::remove_cv_t<typename std::iterator_traits<It>::value_type>>::value)>> {
+
+		using TValue = std::remove_cv_t<typename std::iterator_traits<It>::value_type>;
+
+		static StridedSpan<TValue>	Get(const IteratorEnumerator<It, ForcedElem>& et)
+		{
+			const size_t count = static_cast<size_t>(std::distance(et.Position(), et.End()));
+			const char*	 first = count > 0 ? reinterpret_cast<const char*>(std::addressof(*et.Position())) : nullptr;
+			return { first, sizeof(TValue), count };
+		}
+
+		static void	Skip(IteratorEnumerator<It, ForcedElem>& et, size_t n)
+		{
+			et.Skip(n);
+		}
+	};
+
+
+	/// Mappers which merely read a data member - by MemberCaller, optionally converted to the field's own type.
+	/// Specializations provide:
+	///		- TOwner, TField
+	///		- static TField TOwner::* Member(const Mapper&)
+	template <class Mapper, class = void>
+	struct FieldSelector {};
+
+
+	template <class F, class C>
+	struct FieldSelector<MemberCaller<F C::*>, enable_if_t<std::is_arithmetic<F>::value || std::is_class<F>::value>> {
+		using TOwner = C;
+		using TField = F;
+
+		static F C::*	Member(const MemberCaller<F C::*>& m)	{ return m.member; }
+	};
+
+
+	template <class M, class R>
+	struct FieldSelector<ReturnConverter<M, R>,
+						 enable_if_t<is_same<decay_t<R>, std::remove_cv_t<typename FieldSelector<M>::TField>>::value>> {
+		using TOwner = typename FieldSelector<M>::TOwner;
+		using TField = typename FieldSelector<M>::TField;
+
+		static TField TOwner::*	Member(const ReturnConverter<M, R>& m)	{ return FieldSelector<M>::Member(m.lambda); }
+	};
+
+
+	template <class F, class C>
+	struct FieldSelector<Placeholders::Member<Placeholders::Arg<1>, F C::*>, enable_if_t<std::is_arithmetic<F>::value || std::is_class<F>::value>> {
+		using TOwner = C;
+		using TField = F;
+
+		static F C::*	Member(const Placeholders::Member<Placeholders::Arg<1>, F C::*>& m)	{ return m.member; }
+	};
+
+
+	/// Values of a data member of the viewed objects.
+	template <class F, class C>
+	StridedSpan<std::remove_cv_t<F>>	FieldSpan(const StridedSpan<C>& objects, F C::* member)
+	{
+		if (objects.count == 0)
+			return { nullptr, objects.stride, 0 };
+
+		const F& field = objects[0].*member;
+		return { reinterpret_cast<const char*>(std::addressof(field)), objects.stride, objects.count };
+	}
+
+
+	/// Data members selected from viewable objects, e.g. .Select(&Pair::first)
+	template <class Source, class Mapper>
+	struct StridedView<MapperEnumerator<Source, Mapper>,
+					   enable_if_t<is_same<typename StridedView<Source>::TValue, typename FieldSelector<Mapper>::TOwner>::value>> {
+
+		using TValue = std::remove_cv_t<typename FieldSelector<Mapper>::TField>;
+
+		static StridedSpan<TValue>	Get(const MapperEnumerator<Source, Mapper>& et)
+		{
+			return FieldSpan(StridedView<Source>::Get(et.Inner()), FieldSelector<Mapper>::Member(et.Mapping()));
+		}
+
+		static void	Skip(MapperEnumerator<Source, Mapper>& et, size_t n)
+		{
+			StridedView<Source>::Skip(et.Inner(), n);
+		}
+	};
+
+
+	template <class Etor, class = void>
+	struct ViewedValue {
+		using type = void;
+	};
+
+	template <class Etor>
+	struct ViewedValue<Etor, void_t<typename StridedView<Etor>::TValue>> {
+		using type = typename StridedView<Etor>::TValue;
+	};
+
+	/// Type of the values read by a StridedView of Etor - void if not viewable.
+	template <class Etor>
+	using ViewedValueT = typename ViewedValue<Etor>::type;
+
+
+	/// Type the kernels operate with on values of T - integers reinterpreted as the fixed-size signed type.
+	template <class T>
+	using KernelValueT = conditional_t<std::is_floating_point<T>::value,
+									   T,
+									   conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>>;
+
+
+	/// Kernels compare values of T without reinterpretation: floating point or signed integers of 4/8 bytes.
+	template <class T>
+	struct HasCompareKernel {
+		static constexpr bool value = is_same<T, float>::value || is_same<T, double>::value
+								   || (std::is_integral<T>::value && std::is_signed<T>::value && (sizeof(T) == 4 || sizeof(T) == 8));
+	};
+
+	template <>
+	struct HasCompareKernel<void> : std::false_type {};
+
+#pragma endregion
+
+
+
+#pragma region Sum kernels
+
+	/// Sum<S> of values of T can be computed by a kernel, equally to the sequential loop:
+	///		- floating-point: compensated per lane, then lanes merged
+	///		- integers:		  in 64-bit lanes, truncated to S by the same modular arithmetic as sequential += would
+	template <class S, class T>
+	struct HasSumKernel {
+		static constexpr bool value = (is_same<S, T>::value && (is_same<T, float>::value || is_same<T, double>::value))
+								   || (std::is_integral<S>::value && !is_same<S, bool>::value && sizeof(S) <= 8
+									   && std::is_integral<T>::value && !is_same<T, bool>::value
+									   && (sizeof(T) == 4 || sizeof(T) == 8)
+									   && (std::is_signed<T>::value || sizeof(S) <= sizeof(T)));
+	};
+
+	template <class S>
+	struct HasSumKernel<S, void> : std::false_type {};
+
+
+	/// Sum<S> of Etor's elements can be computed by a kernel.
+	template <class S, class Etor>
+	using IsVectorSummable = HasSumKernel<S, ViewedValueT<Etor>>;
+
+
+	template <class T, size_t L>
+	CompensatedSum<T>	MergeLanes(const T (&sums)[L], const T (&errs)[L], const StridedSpan<T>& span, size_t tail)
+	{
+		CompensatedSum<T> total;
+		for (size_t l = 0; l < L; ++l) {
+			total.Add(sums[l]);
+			total.err += errs[l];
+		}
+		for (size_t i = tail; i < span.count; ++i)
+			total.Add(span[i]);
+
+		return total;
+	}
+
+
+	template <class T, size_t L>
+	std::uint64_t	MergeLanes(const std::uint64_t (&lanes)[L], const StridedSpan<T>& span, size_t tail)
+	{
+		std::uint64_t total = 0;
+		for (size_t l = 0; l < L; ++l)
+			total += lanes[l];
+
+		for (size_t i = tail; i < span.count; ++i)
+			total += static_cast<std::uint64_t>(static_cast<std::int64_t>(span[i]));
+
+		return total;
+	}
+
+
+
+	template <class T, enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	CompensatedSum<T>	SumScalar(const StridedSpan<T>& span)
+	{
+		CompensatedSum<T> total;
+		for (size_t i = 0; i < span.count; ++i)
+			total.Add(span[i]);
+
+		return total;
+	}
+
+
+	template <class T, enable_if_t<std::is_integral<T>::value, int> = 0>
+	std::uint64_t		SumScalar(const StridedSpan<T>& span)
+	{
+		std::uint64_t total = 0;
+		for (size_t i = 0; i < span.count; ++i)
+			total += static_cast<std::uint64_t>(static_cast<std::int64_t>(span[i]));
+
+		return total;
+	}
+
+
+#if ENUMERABLES_SIMD_X86
+
+	// Lanes take the branch of NeumaierSum2 chosen by their own magnitudes.
+
+	inline CompensatedSum<double>	SumSse2(const StridedSpan<double>& span)
+	{
+		const double*	p		 = &span[0];
+		const __m128d	signMask = _mm_set1_pd(-0.0);
+		__m128d			sum		 = _mm_setzero_pd();
+		__m128d			err		 = _mm_setzero_pd();
+
+		size_t i = 0;
+		for (; i + 2 <= span.count; i += 2) {
+			const __m128d b		 = _mm_loadu_pd(p + i);
+			const __m128d s0	 = sum;
+			sum = _mm_add_pd(s0, b);
+
+			const __m128d bigger = _mm_cmpge_pd(_mm_andnot_pd(signMask, s0), _mm_andnot_pd(signMask, b));
+			const __m128d diffB	 = _mm_sub_pd(b, _mm_sub_pd(sum, s0));
+			const __m128d diffA	 = _mm_sub_pd(s0, _mm_sub_pd(sum, b));
+			err = _mm_add_pd(err, _mm_or_pd(_mm_and_pd(bigger, diffB), _mm_andnot_pd(bigger, diffA)));
+		}
+
+		double sums[2], errs[2];
+		_mm_storeu_pd(sums, sum);
+		_mm_storeu_pd(errs, err);
+		return MergeLanes(sums, errs, span, i);
+	}
+
+
+	inline CompensatedSum<float>	SumSse2(const StridedSpan<float>& span)
+	{
+		const float*	p		 = &span[0];
+		const __m128	signMask = _mm_set1_ps(-0.0f);
+		__m128			sum		 = _mm_setzero_ps();
+		__m128			err		 = _mm_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const __m128 b		= _mm_loadu_ps(p + i);
+			const __m128 s0		= sum;
+			sum = _mm_add_ps(s0, b);
+
+			const __m128 bigger = _mm_cmpge_ps(_mm_andnot_ps(signMask, s0), _mm_andnot_ps(signMask, b));
+			const __m128 diffB	= _mm_sub_ps(b, _mm_sub_ps(sum, s0));
+			const __m128 diffA	= _mm_sub_ps(s0, _mm_sub_ps(sum, b));
+			err = _mm_add_ps(err, _mm_or_ps(_mm_and_ps(bigger, diffB), _mm_andnot_ps(bigger, diffA)));
+		}
+
+		float sums[4], errs[4];
+		_mm_storeu_ps(sums, sum);
+		_mm_storeu_ps(errs, err);
+		return MergeLanes(sums, errs, span, i);
+	}
+
+
+	inline std::uint64_t	SumSse2(const StridedSpan<std::int32_t>& span)
+	{
+		const std::int32_t*	p	= &span[0];
+		__m128i				acc = _mm_setzero_si128();
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const __m128i v	   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			const __m128i sign = _mm_srai_epi32(v, 31);
+			acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+			acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+		}
+
+		std::uint64_t lanes[2];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+		return MergeLanes(lanes, span, i);
+	}
+
+
+	inline std::uint64_t	SumSse2(const StridedSpan<std::int64_t>& span)
+	{
+		const std::int64_t*	p	= &span[0];
+		__m128i				acc = _mm_setzero_si128();
+
+		size_t i = 0;
+		for (; i + 2 <= span.count; i += 2)
+			acc = _mm_add_epi64(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+
+		std::uint64_t lanes[2];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+		return MergeLanes(lanes, span, i);
+	}
+
+
+
+	// AVX2 kernels gather strided fields with byte offsets of the lanes.
+	// (Masked gathers with zeroed source: plain ones trigger false uninitialized warnings on GCC.)
+
+	ENUMERABLES_TARGET_AVX2
+	inline CompensatedSum<double>	SumAvx2(const StridedSpan<double>& span)
+	{
+		const int		stride	 = static_cast<int>(span.stride);
+		const __m128i	offsets	 = _mm_setr_epi32(0, stride, 2 * stride, 3 * stride);
+		const __m256i	every	 = _mm256_set1_epi32(-1);
+		const __m256d	signMask = _mm256_set1_pd(-0.0);
+		__m256d			sum		 = _mm256_setzero_pd();
+		__m256d			err		 = _mm256_setzero_pd();
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const double* p		 = &span[i];
+			const __m256d b		 = span.IsContiguous() ? _mm256_loadu_pd(p)
+													   : _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, offsets, _mm256_castsi256_pd(every), 1);
+			const __m256d s0	 = sum;
+			sum = _mm256_add_pd(s0, b);
+
+			const __m256d bigger = _mm256_cmp_pd(_mm256_andnot_pd(signMask, s0), _mm256_andnot_pd(signMask, b), _CMP_GE_OQ);
+			const __m256d diffB	 = _mm256_sub_pd(b, _mm256_sub_pd(sum, s0));
+			const __m256d diffA	 = _mm256_sub_pd(s0, _mm256_sub_pd(sum, b));
+			err = _mm256_add_pd(err, _mm256_blendv_pd(diffA, diffB, bigger));
+		}
+
+		double sums[4], errs[4];
+		_mm256_storeu_pd(sums, sum);
+		_mm256_storeu_pd(errs, err);
+		return MergeLanes(sums, errs, span, i);
+	}
+
+
+	ENUMERABLES_TARGET_AVX2
+	inline CompensatedSum<float>	SumAvx2(const StridedSpan<float>& span)
+	{
+		const int		stride	 = static_cast<int>(span.stride);
+		const __m256i	offsets	 = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+		const __m256i	every	 = _mm256_set1_epi32(-1);
+		const __m256	signMask = _mm256_set1_ps(-0.0f);
+		__m256			sum		 = _mm256_setzero_ps();
+		__m256			err		 = _mm256_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 8 <= span.count; i += 8) {
+			const float* p		= &span[i];
+			const __m256 b		= span.IsContiguous() ? _mm256_loadu_ps(p)
+													  : _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, offsets, _mm256_castsi256_ps(every), 1);
+			const __m256 s0		= sum;
+			sum = _mm256_add_ps(s0, b);
+
+			const __m256 bigger = _mm256_cmp_ps(_mm256_andnot_ps(signMask, s0), _mm256_andnot_ps(signMask, b), _CMP_GE_OQ);
+			const __m256 diffB	= _mm256_sub_ps(b, _mm256_sub_ps(sum, s0));
+			const __m256 diffA	= _mm256_sub_ps(s0, _mm256_sub_ps(sum, b));
+			err = _mm256_add_ps(err, _mm256_blendv_ps(diffA, diffB, bigger));
+		}
+
+		float sums[8], errs[8];
+		_mm256_storeu_ps(sums, sum);
+		_mm256_storeu_ps(errs, err);
+		return MergeLanes(sums, errs, span, i);
+	}
+
+
+	ENUMERABLES_TARGET_AVX2
+	inline std::uint64_t	SumAvx2(const StridedSpan<std::int32_t>& span)
+	{
+		const int		stride	= static_cast<int>(span.stride);
+		const __m256i	offsets	= _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		__m256i			acc		= _mm256_setzero_si256();
+
+		size_t i = 0;
+		for (; i + 8 <= span.count; i += 8) {
+			const int*	  p = reinterpret_cast<const int*>(&span[i]);
+			const __m256i v = span.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+												  : _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), p, offsets, every, 1);
+			acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+			acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+		}
+
+		std::uint64_t lanes[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+		return MergeLanes(lanes, span, i);
+	}
+
+
+	ENUMERABLES_TARGET_AVX2
+	inline std::uint64_t	SumAvx2(const StridedSpan<std::int64_t>& span)
+	{
+		const int		stride	= static_cast<int>(span.stride);
+		const __m128i	offsets	= _mm_setr_epi32(0, stride, 2 * stride, 3 * stride);
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		__m256i			acc		= _mm256_setzero_si256();
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const long long* p = reinterpret_cast<const long long*>(&span[i]);
+			const __m256i	 v = span.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+													 : _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), p, offsets, every, 1);
+			acc = _mm256_add_epi64(acc, v);
+		}
+
+		std::uint64_t lanes[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+		return MergeLanes(lanes, span, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_X86
+
+
+#if ENUMERABLES_SIMD_NEON
+
+	inline CompensatedSum<double>	SumNeon(const StridedSpan<double>& span)
+	{
+		const double* p	  = &span[0];
+		float64x2_t	  sum = vdupq_n_f64(0.0);
+		float64x2_t	  err = vdupq_n_f64(0.0);
+
+		size_t i = 0;
+		for (; i + 2 <= span.count; i += 2) {
+			const float64x2_t b		 = vld1q_f64(p + i);
+			const float64x2_t s0	 = sum;
+			sum = vaddq_f64(s0, b);
+
+			const uint64x2_t  bigger = vcgeq_f64(vabsq_f64(s0), vabsq_f64(b));
+			const float64x2_t diffB	 = vsubq_f64(b, vsubq_f64(sum, s0));
+			const float64x2_t diffA	 = vsubq_f64(s0, vsubq_f64(sum, b));
+			err = vaddq_f64(err, vbslq_f64(bigger, diffB, diffA));
+		}
+
+		double sums[2], errs[2];
+		vst1q_f64(sums, sum);
+		vst1q_f64(errs, err);
+		return MergeLanes(sums, errs, span, i);
+	}
+
+
+	inline CompensatedSum<float>	SumNeon(const StridedSpan<float>& span)
+	{
+		const float* p	 = &span[0];
+		float32x4_t	 sum = vdupq_n_f32(0.0f);
+		float32x4_t	 err = vdupq_n_f32(0.0f);
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const float32x4_t b		 = vld1q_f32(p + i);
+			const float32x4_t s0	 = sum;
+			sum = vaddq_f32(s0, b);
+
+			const uint32x4_t  bigger = vcgeq_f32(vabsq_f32(s0), vabsq_f32(b));
+			const float32x4_t diffB	 = vsubq_f32(b, vsubq_f32(sum, s0));
+			const float32x4_t diffA	 = vsubq_f32(s0, vsubq_f32(sum, b));
+			err = vaddq_f32(err, vbslq_f32(bigger, diffB, diffA));
+		}
+
+		float sums[4], errs[4];
+		vst1q_f32(sums, sum);
+		vst1q_f32(errs, err);
+		return MergeLanes(sums, errs, span, i);
+	}
+
+
+	inline std::uint64_t	SumNeon(const StridedSpan<std::int32_t>& span)
+	{
+		const std::int32_t*	p	= &span[0];
+		int64x2_t			acc = vdupq_n_s64(0);
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4)
+			acc = vpadalq_s32(acc, vld1q_s32(p + i));
+
+		std::uint64_t lanes[2];
+		vst1q_u64(lanes, vreinterpretq_u64_s64(acc));
+		return MergeLanes(lanes, span, i);
+	}
+
+
+	inline std::uint64_t	SumNeon(const StridedSpan<std::int64_t>& span)
+	{
+		const std::int64_t*	p	= &span[0];
+		int64x2_t			acc = vdupq_n_s64(0);
+
+		size_t i = 0;
+		for (; i + 2 <= span.count; i += 2)
+			acc = vaddq_s64(acc, vld1q_s64(p + i));
+
+		std::uint64_t lanes[2];
+		vst1q_u64(lanes, vreinterpretq_u64_s64(acc));
+		return MergeLanes(lanes, span, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_NEON
+
+
+	/// Sum of the viewed values by the best kernel available for the span.
+	/// @returns	CompensatedSum for floating-point, modular 64-bit sum for integers.
+	template <class T>
+	auto	KernelSum(const StridedSpan<T>& span)
+	{
+		if (span.count == 0)
+			return SumScalar(span);
+
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() == SimdLevel::Avx2 && span.IsGatherable())
+			return SumAvx2(span);
+		if (ActiveSimdLevel() >= SimdLevel::Sse2 && span.IsContiguous())
+			return SumSse2(span);
+#elif ENUMERABLES_SIMD_NEON
+		if (ActiveSimdLevel() == SimdLevel::Neon && span.IsContiguous())
+			return SumNeon(span);
+#endif
+		return SumScalar(span);
+	}
+
+
+
+	/// Sum<S> of the elements an Enumerator would yield, read directly by a kernel.
+	/// @pre	IsVectorSummable<S, Etor>, @p et is in initial state.
+	template <class S, class Etor, enable_if_t<std::is_floating_point<S>::value, int> = 0>
+	S	VectorSum(const Etor& et)
+	{
+		return KernelSum(StridedView<Etor>::Get(et)).Total();
+	}
+
+
+	template <class S, class Etor, enable_if_t<std::is_integral<S>::value, int> = 0>
+	S	VectorSum(const Etor& et)
+	{
+		using TKernel = KernelValueT<typename StridedView<Etor>::TValue>;
+
+		const std::uint64_t total = KernelSum(StridedView<Etor>::Get(et).template As<TKernel>());
+		return static_cast<S>(total);
+	}
+
+#pragma endregion
+
+
+#pragma region Extreme kernels
+
+	/// Minimum or maximum of a span - as a sequential search would pick it.
+	template <class T>
+	struct Extreme {
+		T		value;
+		bool	unordered;		// floating-point NaN among the values
+	};
+
+
+	template <class T, enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	bool	IsUnordered(const T& v)		{ return v != v; }
+
+	template <class T, enable_if_t<!std::is_floating_point<T>::value, int> = 0>
+	bool	IsUnordered(const T&)		{ return false; }
+
+
+	/// Strict ordering by operator <, reversed for Max.
+	template <bool Max, class T>
+	bool	Precedes(const T& lhs, const T& rhs)
+	{
+		return Max ? rhs < lhs : lhs < rhs;
+	}
+
+
+	/// Rule of sequential search: a later value replaces the extreme only if strictly better.
+	/// Kernels apply it per lane, then to the lanes in order.
+	template <bool Max, class T>
+	const T&	Better(const T& candidate, const T& extreme)
+	{
+		return Precedes<Max>(candidate, extreme) ? candidate : extreme;
+	}
+
+
+	template <bool Max, class T, size_t L>
+	Extreme<T>	MergeExtremeLanes(const T (&lanes)[L], bool unordered, const StridedSpan<T>& span, size_t tail)
+	{
+		Extreme<T> ext { lanes[0], unordered };
+		for (size_t l = 1; l < L; ++l)
+			ext.value = Better<Max>(lanes[l], ext.value);
+
+		for (size_t i = tail; i < span.count; ++i) {
+			ext.value	   = Better<Max>(span[i], ext.value);
+			ext.unordered |= IsUnordered(span[i]);
+		}
+		return ext;
+	}
+
+
+	template <bool Max, class T>
+	Extreme<T>	ExtremeScalar(const StridedSpan<T>& span)
+	{
+		const T	  lanes[1] = { span[0] };
+		return MergeExtremeLanes<Max>(lanes, IsUnordered(span[0]), span, 1);
+	}
+
+
+#if ENUMERABLES_SIMD_X86
+
+	// Lanes start from the first value. MINPD/MAXPD return their 2nd operand unless the 1st is strictly better,
+	// thus NaN candidates are skipped - while a NaN first value remains, as sequentially.
+
+	template <bool Max>
+	Extreme<double>	ExtremeSse2(const StridedSpan<double>& span)
+	{
+		const double*	p	= &span[0];
+		__m128d			ext = _mm_set1_pd(p[0]);
+		__m128d			nan = _mm_setzero_pd();
+
+		size_t i = 0;
+		for (; i + 2 <= span.count; i += 2) {
+			const __m128d b = _mm_loadu_pd(p + i);
+			ext = Max ? _mm_max_pd(b, ext) : _mm_min_pd(b, ext);
+			nan = _mm_or_pd(nan, _mm_cmpunord_pd(b, b));
+		}
+
+		double lanes[2];
+		_mm_storeu_pd(lanes, ext);
+		return MergeExtremeLanes<Max>(lanes, _mm_movemask_pd(nan) != 0, span, i);
+	}
+
+
+	template <bool Max>
+	Extreme<float>	ExtremeSse2(const StridedSpan<float>& span)
+	{
+		const float*	p	= &span[0];
+		__m128			ext = _mm_set1_ps(p[0]);
+		__m128			nan = _mm_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const __m128 b = _mm_loadu_ps(p + i);
+			ext = Max ? _mm_max_ps(b, ext) : _mm_min_ps(b, ext);
+			nan = _mm_or_ps(nan, _mm_cmpunord_ps(b, b));
+		}
+
+		float lanes[4];
+		_mm_storeu_ps(lanes, ext);
+		return MergeExtremeLanes<Max>(lanes, _mm_movemask_ps(nan) != 0, span, i);
+	}
+
+
+	template <bool Max>
+	Extreme<std::int32_t>	ExtremeSse2(const StridedSpan<std::int32_t>& span)
+	{
+		const std::int32_t*	p	= &span[0];
+		__m128i				ext = _mm_set1_epi32(p[0]);
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const __m128i b		 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			const __m128i better = Max ? _mm_cmpgt_epi32(b, ext) : _mm_cmplt_epi32(b, ext);
+			ext = _mm_or_si128(_mm_and_si128(better, b), _mm_andnot_si128(better, ext));
+		}
+
+		std::int32_t lanes[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), ext);
+		return MergeExtremeLanes<Max>(lanes, false, span, i);
+	}
+
+
+	// no 64-bit comparison in SSE2
+	template <bool Max>
+	Extreme<std::int64_t>	ExtremeSse2(const StridedSpan<std::int64_t>& span)
+	{
+		return ExtremeScalar<Max>(span);
+	}
+
+
+
+	template <bool Max>
+	ENUMERABLES_TARGET_AVX2
+	Extreme<double>	ExtremeAvx2(const StridedSpan<double>& span)
+	{
+		const int		stride	= static_cast<int>(span.stride);
+		const __m128i	offsets	= _mm_setr_epi32(0, stride, 2 * stride, 3 * stride);
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		__m256d			ext		= _mm256_set1_pd(span[0]);
+		__m256d			nan		= _mm256_setzero_pd();
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const double* p = &span[i];
+			const __m256d b = span.IsContiguous() ? _mm256_loadu_pd(p)
+												  : _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, offsets, _mm256_castsi256_pd(every), 1);
+			ext = Max ? _mm256_max_pd(b, ext) : _mm256_min_pd(b, ext);
+			nan = _mm256_or_pd(nan, _mm256_cmp_pd(b, b, _CMP_UNORD_Q));
+		}
+
+		double lanes[4];
+		_mm256_storeu_pd(lanes, ext);
+		return MergeExtremeLanes<Max>(lanes, _mm256_movemask_pd(nan) != 0, span, i);
+	}
+
+
+	template <bool Max>
+	ENUMERABLES_TARGET_AVX2
+	Extreme<float>	ExtremeAvx2(const StridedSpan<float>& span)
+	{
+		const int		stride	= static_cast<int>(span.stride);
+		const __m256i	offsets	= _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		__m256			ext		= _mm256_set1_ps(span[0]);
+		__m256			nan		= _mm256_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 8 <= span.count; i += 8) {
+			const float* p = &span[i];
+			const __m256 b = span.IsContiguous() ? _mm256_loadu_ps(p)
+												 : _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, offsets, _mm256_castsi256_ps(every), 1);
+			ext = Max ? _mm256_max_ps(b, ext) : _mm256_min_ps(b, ext);
+			nan = _mm256_or_ps(nan, _mm256_cmp_ps(b, b, _CMP_UNORD_Q));
+		}
+
+		float lanes[8];
+		_mm256_storeu_ps(lanes, ext);
+		return MergeExtremeLanes<Max>(lanes, _mm256_movemask_ps(nan) != 0, span, i);
+	}
+
+
+	template <bool Max>
+	ENUMERABLES_TARGET_AVX2
+	Extreme<std::int32_t>	ExtremeAvx2(const StridedSpan<std::int32_t>& span)
+	{
+		const int		stride	= static_cast<int>(span.stride);
+		const __m256i	offsets	= _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		__m256i			ext		= _mm256_set1_epi32(span[0]);
+
+		size_t i = 0;
+		for (; i + 8 <= span.count; i += 8) {
+			const int*	  p = reinterpret_cast<const int*>(&span[i]);
+			const __m256i b = span.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+												  : _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), p, offsets, every, 1);
+			ext = Max ? _mm256_max_epi32(b, ext) : _mm256_min_epi32(b, ext);
+		}
+
+		std::int32_t lanes[8];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), ext);
+		return MergeExtremeLanes<Max>(lanes, false, span, i);
+	}
+
+
+	template <bool Max>
+	ENUMERABLES_TARGET_AVX2
+	Extreme<std::int64_t>	ExtremeAvx2(const StridedSpan<std::int64_t>& span)
+	{
+		const int		stride	= static_cast<int>(span.stride);
+		const __m128i	offsets	= _mm_setr_epi32(0, stride, 2 * stride, 3 * stride);
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		__m256i			ext		= _mm256_set1_epi64x(span[0]);
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const long long* p		= reinterpret_cast<const long long*>(&span[i]);
+			const __m256i	 b		= span.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+															  : _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), p, offsets, every, 1);
+			const __m256i	 better = Max ? _mm256_cmpgt_epi64(b, ext) : _mm256_cmpgt_epi64(ext, b);
+			ext = _mm256_blendv_epi8(ext, b, better);
+		}
+
+		std::int64_t lanes[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), ext);
+		return MergeExtremeLanes<Max>(lanes, false, span, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_X86
+
+
+#if ENUMERABLES_SIMD_NEON
+
+	// Selection by explicit comparison: NEON min/max would propagate NaNs.
+
+	template <bool Max>
+	Extreme<double>	ExtremeNeon(const StridedSpan<double>& span)
+	{
+		const double* p		  = &span[0];
+		float64x2_t	  ext	  = vdupq_n_f64(p[0]);
+		uint64x2_t	  ordered = vdupq_n_u64(~0ull);
+
+		size_t i = 0;
+		for (; i + 2 <= span.count; i += 2) {
+			const float64x2_t b = vld1q_f64(p + i);
+			ext		= vbslq_f64(Max ? vcgtq_f64(b, ext) : vcltq_f64(b, ext), b, ext);
+			ordered = vandq_u64(ordered, vceqq_f64(b, b));
+		}
+
+		double lanes[2];
+		vst1q_f64(lanes, ext);
+		const bool unordered = (vgetq_lane_u64(ordered, 0) & vgetq_lane_u64(ordered, 1)) == 0;
+		return MergeExtremeLanes<Max>(lanes, unordered, span, i);
+	}
+
+
+	template <bool Max>
+	Extreme<float>	ExtremeNeon(const StridedSpan<float>& span)
+	{
+		const float* p		 = &span[0];
+		float32x4_t	 ext	 = vdupq_n_f32(p[0]);
+		uint32x4_t	 ordered = vdupq_n_u32(~0u);
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const float32x4_t b = vld1q_f32(p + i);
+			ext		= vbslq_f32(Max ? vcgtq_f32(b, ext) : vcltq_f32(b, ext), b, ext);
+			ordered = vandq_u32(ordered, vceqq_f32(b, b));
+		}
+
+		float lanes[4];
+		vst1q_f32(lanes, ext);
+		return MergeExtremeLanes<Max>(lanes, vminvq_u32(ordered) == 0, span, i);
+	}
+
+
+	template <bool Max>
+	Extreme<std::int32_t>	ExtremeNeon(const StridedSpan<std::int32_t>& span)
+	{
+		const std::int32_t*	p	= &span[0];
+		int32x4_t			ext = vdupq_n_s32(p[0]);
+
+		size_t i = 0;
+		for (; i + 4 <= span.count; i += 4) {
+			const int32x4_t b = vld1q_s32(p + i);
+			ext = Max ? vmaxq_s32(b, ext) : vminq_s32(b, ext);
+		}
+
+		std::int32_t lanes[4];
+		vst1q_s32(lanes, ext);
+		return MergeExtremeLanes<Max>(lanes, false, span, i);
+	}
+
+
+	template <bool Max>
+	Extreme<std::int64_t>	ExtremeNeon(const StridedSpan<std::int64_t>& span)
+	{
+		const std::int64_t*	p	= &span[0];
+		int64x2_t			ext = vdupq_n_s64(p[0]);
+
+		size_t i = 0;
+		for (; i + 2 <= span.count; i += 2) {
+			const int64x2_t b = vld1q_s64(p + i);
+			ext = vbslq_s64(Max ? vcgtq_s64(b, ext) : vcltq_s64(b, ext), b, ext);
+		}
+
+		std::int64_t lanes[2];
+		vst1q_s64(lanes, ext);
+		return MergeExtremeLanes<Max>(lanes, false, span, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_NEON
+
+
+	/// Extreme of a non-empty span by the best kernel available.
+	template <bool Max, class T>
+	Extreme<T>	KernelExtreme(const StridedSpan<T>& span)
+	{
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() == SimdLevel::Avx2 && span.IsGatherable())
+			return ExtremeAvx2<Max>(span);
+		if (ActiveSimdLevel() >= SimdLevel::Sse2 && span.IsContiguous())
+			return ExtremeSse2<Max>(span);
+#elif ENUMERABLES_SIMD_NEON
+		if (ActiveSimdLevel() == SimdLevel::Neon && span.IsContiguous())
+			return ExtremeNeon<Max>(span);
+#endif
+		return ExtremeScalar<Max>(span);
+	}
+
+
+
+	/// Recognizes orderings which compare viewed values of TValue, or a field of them, by operator <.
+	/// Specializations provide:
+	///		- isMax:	reversed ordering
+	///		- TKey
+	///		- static StridedSpan<TKey> Keys(const StridedSpan<TValue>&, const Ordering&)
+	template <class Ordering, class TValue, class = void>
+	struct ExtremeSeeker {};
+
+
+	template <class Ordering, class TValue>
+	struct ExtremeSeeker<Ordering, TValue, enable_if_t<std::is_arithmetic<TValue>::value
+													   && (is_same<Ordering, std::less<>>::value || is_same<Ordering, std::less<TValue>>::value)>> {
+		static constexpr bool isMax = false;
+		using TKey = TValue;
+
+		static StridedSpan<TKey>	Keys(const StridedSpan<TValue>& values, const Ordering&)	{ return values; }
+	};
+
+
+	/// E.g. .MinimumsBy(&Pair::first)
+	template <class CP, class Prop, class TValue>
+	struct ExtremeSeeker<PropertyComparator<CP, Prop>, TValue,
+						 enable_if_t<is_same<typename FieldSelector<Prop>::TOwner, TValue>::value
+									 && std::is_arithmetic<typename FieldSelector<Prop>::TField>::value>> {
+		static constexpr bool isMax = false;
+		using TKey = std::remove_cv_t<typename FieldSelector<Prop>::TField>;
+
+		static StridedSpan<TKey>	Keys(const StridedSpan<TValue>& objects, const PropertyComparator<CP, Prop>& ordering)
+		{
+			return FieldSpan(objects, FieldSelector<Prop>::Member(ordering.prop));
+		}
+	};
+
+
+	/// Max, Maximums, MaximumsBy
+	template <class F, class TValue>
+	struct ExtremeSeeker<BinopSwapper<F>, TValue, void_t<typename ExtremeSeeker<decay_t<F>, TValue>::TKey>> {
+		using Inner = ExtremeSeeker<decay_t<F>, TValue>;
+
+		static constexpr bool isMax = !Inner::isMax;
+		using TKey = typename Inner::TKey;
+
+		static StridedSpan<TKey>	Keys(const StridedSpan<TValue>& values, const BinopSwapper<F>& ordering)	{ return Inner::Keys(values, ordering.op); }
+	};
+
+
+	template <class F, class TValue>
+	struct ExtremeSeeker<LambdaRef<F>, TValue, void_t<typename ExtremeSeeker<F, TValue>::TKey>> {
+		using Inner = ExtremeSeeker<F, TValue>;
+
+		static constexpr bool isMax = Inner::isMax;
+		using TKey = typename Inner::TKey;
+
+		static StridedSpan<TKey>	Keys(const StridedSpan<TValue>& values, const LambdaRef<F>& ordering)		{ return Inner::Keys(values, ordering.lambda); }
+	};
+
+
+
+	/// Extreme of Etor's elements by Ordering can be found by a kernel.
+	///		- value:		keys are the elements themselves or a field of them
+	///		- byElement:	keys are the elements themselves
+	template <class Etor, class Ordering, class = void>
+	struct IsVectorSeekable {
+		static constexpr bool value		= false;
+		static constexpr bool byElement = false;
+	};
+
+	template <class Etor, class Ordering>
+	struct IsVectorSeekable<Etor, Ordering, void_t<typename ExtremeSeeker<decay_t<Ordering>, ViewedValueT<Etor>>::TKey>> {
+		using TKey = typename ExtremeSeeker<decay_t<Ordering>, ViewedValueT<Etor>>::TKey;
+
+		static constexpr bool value		= HasCompareKernel<TKey>::value;
+		static constexpr bool byElement = value && is_same<TKey, ViewedValueT<Etor>>::value;
+	};
+
+
+
+	/// Sequential search picks the first of equivalent extremes - distinguishable only for signed zeros.
+	template <class T, enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	T	FirstEquivalent(const StridedSpan<T>& keys, const T& extreme)
+	{
+		if (extreme == T {}) {
+			for (size_t i = 0; i < keys.count; ++i) {
+				if (keys[i] == extreme)
+					return keys[i];
+			}
+		}
+		return extreme;
+	}
+
+	template <class T, enable_if_t<!std::is_floating_point<T>::value, int> = 0>
+	T	FirstEquivalent(const StridedSpan<T>&, const T& extreme)
+	{
+		return extreme;
+	}
+
+
+	/// Min or Max of the non-empty viewed values, as sequential search would find it.
+	/// @pre	IsVectorSeekable<Etor, Ordering>::byElement
+	template <class T, class Ordering>
+	T	VectorExtreme(const StridedSpan<T>& values, const Ordering& ordering)
+	{
+		using Seeker  = ExtremeSeeker<decay_t<Ordering>, T>;
+		using TKernel = KernelValueT<T>;
+
+		const auto keys = Seeker::Keys(values, ordering).template As<TKernel>();
+		return static_cast<T>(FirstEquivalent(keys, KernelExtreme<Seeker::isMax>(keys).value));
+	}
+
+
+
+	/// Seeks blocks of keys by kernel, skips those worse than the extremes found so far,
+	/// scans the rest while still in cache. Scanning follows sequential search exactly - NaN keys included.
+	template <class Source, class Ordering>
+	struct MinimumsKernel<Source, Ordering, enable_if_t<IsVectorSeekable<Source, Ordering>::value>> {
+
+		static constexpr size_t blockSize = 512;
+
+		template <class TCache>
+		static bool	TrySeek(Source& source, const Ordering& ordering, TCache& extremes)
+		{
+			using Seeker  = ExtremeSeeker<decay_t<Ordering>, ViewedValueT<Source>>;
+			using TKernel = KernelValueT<typename Seeker::TKey>;
+
+			const auto keys  = Seeker::Keys(StridedView<Source>::Get(source), ordering).template As<TKernel>();
+			bool	   found = false;
+			TKernel	   best {};
+
+			for (size_t start = 0; start < keys.count; start += blockSize) {
+				const auto				block = keys.Slice(start, (std::min)(blockSize, keys.count - start));
+				const Extreme<TKernel>	ext	  = KernelExtreme<Seeker::isMax>(block);
+
+				if (found && !ext.unordered && Precedes<Seeker::isMax>(best, ext.value)) {
+					StridedView<Source>::Skip(source, block.count);
+					continue;
+				}
+
+				for (size_t i = 0; i < block.count; ++i) {
+					source.FetchNext();
+					if (found && Precedes<Seeker::isMax>(best, block[i]))
+						continue;
+
+					if (!found || Precedes<Seeker::isMax>(block[i], best)) {
+						ListOperations::Clear(extremes);
+						best  = block[i];
+						found = true;
+					}
+					ListOperations::Add(extremes, source.Current());
+				}
+			}
+			return true;
+		}
+	};
+
+#pragma endregion
+
+
+#pragma region Filter kernels
+
+	using Predicates::CompareOp;
+
+
+	/// Integer comparisons are composed of less, greater and equal, negated as needed.
+	constexpr CompareOp	BasicCompare(CompareOp op)
+	{
+		return op == CompareOp::LessEqual	 ? CompareOp::Greater
+			 : op == CompareOp::GreaterEqual ? CompareOp::Less
+			 : op == CompareOp::NotEqual	 ? CompareOp::Equal
+			 : op;
+	}
+
+	constexpr bool		IsNegatedCompare(CompareOp op)
+	{
+		return BasicCompare(op) != op;
+	}
+
+
+	/// Bit i set for keys[i] satisfying the comparison - up to 64 keys.
+	template <CompareOp Op, class T>
+	std::uint64_t	CompareMaskScalar(const StridedSpan<T>& keys, const T& operand)
+	{
+		std::uint64_t mask = 0;
+		for (size_t i = 0; i < keys.count; ++i)
+			mask |= static_cast<std::uint64_t>(Predicates::Comparer<Op>::Apply(keys[i], operand)) << i;
+
+		return mask;
+	}
+
+
+	template <CompareOp Op, class T>
+	std::uint64_t	TailMask(const StridedSpan<T>& keys, const T& operand, size_t from)
+	{
+		return from < keys.count ? CompareMaskScalar<Op>(keys.Slice(from, keys.count - from), operand) << from
+								 : 0;
+	}
+
+
+	/// Survivors of up to 64 values compacted to out, which has room for 8 more values than count.
+	/// Branch-free: each value is written, but only the selected ones are kept.
+	template <class T>
+	size_t	CompressScalar(const StridedSpan<T>& values, std::uint64_t mask, T* out)
+	{
+		size_t n = 0;
+		for (size_t i = 0; i < values.count; ++i) {
+			out[n] = values[i];
+			n	  += (mask >> i) & 1;
+		}
+		return n;
+	}
+
+
+#if ENUMERABLES_SIMD_X86
+
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskSse2(const StridedSpan<double>& keys, double operand)
+	{
+		const double*	p = &keys[0];
+		const __m128d	c = _mm_set1_pd(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 2 <= keys.count; i += 2) {
+			const __m128d v = _mm_loadu_pd(p + i);
+			const __m128d r = Op == CompareOp::Less			? _mm_cmplt_pd(v, c)
+							: Op == CompareOp::LessEqual	? _mm_cmple_pd(v, c)
+							: Op == CompareOp::Greater		? _mm_cmpgt_pd(v, c)
+							: Op == CompareOp::GreaterEqual	? _mm_cmpge_pd(v, c)
+							: Op == CompareOp::Equal		? _mm_cmpeq_pd(v, c)
+							:								  _mm_cmpneq_pd(v, c);		// unordered: true for NaN, as !=
+			mask |= static_cast<std::uint64_t>(_mm_movemask_pd(r)) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskSse2(const StridedSpan<float>& keys, float operand)
+	{
+		const float*	p = &keys[0];
+		const __m128	c = _mm_set1_ps(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 4 <= keys.count; i += 4) {
+			const __m128 v = _mm_loadu_ps(p + i);
+			const __m128 r = Op == CompareOp::Less			? _mm_cmplt_ps(v, c)
+						   : Op == CompareOp::LessEqual		? _mm_cmple_ps(v, c)
+						   : Op == CompareOp::Greater		? _mm_cmpgt_ps(v, c)
+						   : Op == CompareOp::GreaterEqual	? _mm_cmpge_ps(v, c)
+						   : Op == CompareOp::Equal			? _mm_cmpeq_ps(v, c)
+						   :								  _mm_cmpneq_ps(v, c);
+			mask |= static_cast<std::uint64_t>(_mm_movemask_ps(r)) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskSse2(const StridedSpan<std::int32_t>& keys, std::int32_t operand)
+	{
+		constexpr CompareOp basic = BasicCompare(Op);
+		constexpr int		flip  = IsNegatedCompare(Op) ? 0xF : 0;
+
+		const std::int32_t*	p = &keys[0];
+		const __m128i		c = _mm_set1_epi32(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 4 <= keys.count; i += 4) {
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			const __m128i r = basic == CompareOp::Less	  ? _mm_cmplt_epi32(v, c)
+							: basic == CompareOp::Greater ? _mm_cmpgt_epi32(v, c)
+							:								_mm_cmpeq_epi32(v, c);
+			mask |= static_cast<std::uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(r)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	// no 64-bit comparison in SSE2
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskSse2(const StridedSpan<std::int64_t>& keys, std::int64_t operand)
+	{
+		return CompareMaskScalar<Op>(keys, operand);
+	}
+
+
+
+	template <CompareOp Op>
+	struct AvxCompareImm : std::integral_constant<int, Op == CompareOp::Less		 ? _CMP_LT_OQ
+													 : Op == CompareOp::LessEqual	 ? _CMP_LE_OQ
+													 : Op == CompareOp::Greater		 ? _CMP_GT_OQ
+													 : Op == CompareOp::GreaterEqual ? _CMP_GE_OQ
+													 : Op == CompareOp::Equal		 ? _CMP_EQ_OQ
+													 :								   _CMP_NEQ_UQ> {};
+
+
+	template <CompareOp Op>
+	ENUMERABLES_TARGET_AVX2
+	std::uint64_t	CompareMaskAvx2(const StridedSpan<double>& keys, double operand)
+	{
+		const int		stride	= static_cast<int>(keys.stride);
+		const __m128i	offsets	= _mm_setr_epi32(0, stride, 2 * stride, 3 * stride);
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		const __m256d	c		= _mm256_set1_pd(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 4 <= keys.count; i += 4) {
+			const double* p = &keys[i];
+			const __m256d v = keys.IsContiguous() ? _mm256_loadu_pd(p)
+												  : _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, offsets, _mm256_castsi256_pd(every), 1);
+			mask |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(v, c, AvxCompareImm<Op>::value))) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	ENUMERABLES_TARGET_AVX2
+	std::uint64_t	CompareMaskAvx2(const StridedSpan<float>& keys, float operand)
+	{
+		const int		stride	= static_cast<int>(keys.stride);
+		const __m256i	offsets	= _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		const __m256	c		= _mm256_set1_ps(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 8 <= keys.count; i += 8) {
+			const float* p = &keys[i];
+			const __m256 v = keys.IsContiguous() ? _mm256_loadu_ps(p)
+												 : _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, offsets, _mm256_castsi256_ps(every), 1);
+			mask |= static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(v, c, AvxCompareImm<Op>::value))) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	ENUMERABLES_TARGET_AVX2
+	std::uint64_t	CompareMaskAvx2(const StridedSpan<std::int32_t>& keys, std::int32_t operand)
+	{
+		constexpr CompareOp basic = BasicCompare(Op);
+		constexpr int		flip  = IsNegatedCompare(Op) ? 0xFF : 0;
+
+		const int		stride	= static_cast<int>(keys.stride);
+		const __m256i	offsets	= _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		const __m256i	c		= _mm256_set1_epi32(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 8 <= keys.count; i += 8) {
+			const int*	  p = reinterpret_cast<const int*>(&keys[i]);
+			const __m256i v = keys.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+												  : _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), p, offsets, every, 1);
+			const __m256i r = basic == CompareOp::Less	  ? _mm256_cmpgt_epi32(c, v)
+							: basic == CompareOp::Greater ? _mm256_cmpgt_epi32(v, c)
+							:								_mm256_cmpeq_epi32(v, c);
+			mask |= static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(r)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	ENUMERABLES_TARGET_AVX2
+	std::uint64_t	CompareMaskAvx2(const StridedSpan<std::int64_t>& keys, std::int64_t operand)
+	{
+		constexpr CompareOp basic = BasicCompare(Op);
+		constexpr int		flip  = IsNegatedCompare(Op) ? 0xF : 0;
+
+		const int		stride	= static_cast<int>(keys.stride);
+		const __m128i	offsets	= _mm_setr_epi32(0, stride, 2 * stride, 3 * stride);
+		const __m256i	every	= _mm256_set1_epi32(-1);
+		const __m256i	c		= _mm256_set1_epi64x(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 4 <= keys.count; i += 4) {
+			const long long* p = reinterpret_cast<const long long*>(&keys[i]);
+			const __m256i	 v = keys.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+													 : _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), p, offsets, every, 1);
+			const __m256i	 r = basic == CompareOp::Less	 ? _mm256_cmpgt_epi64(c, v)
+							   : basic == CompareOp::Greater ? _mm256_cmpgt_epi64(v, c)
+							   :							   _mm256_cmpeq_epi64(v, c);
+			mask |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(r)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+
+	/// Lane indices to compact a vector by a mask of its lanes, packed as bytes.
+	struct CompressTable {
+		std::uint64_t	dwords[256];	// 8 x 32-bit lanes
+		std::uint64_t	qwords[16];		// 4 x 64-bit lanes, as pairs of 32-bit ones
+
+		constexpr CompressTable() : dwords {}, qwords {}
+		{
+			for (unsigned m = 0; m < 256; ++m) {
+				unsigned n = 0;
+				for (unsigned l = 0; l < 8; ++l) {
+					if (m >> l & 1)
+						dwords[m] |= std::uint64_t { l } << 8 * n++;
+				}
+			}
+			for (unsigned m = 0; m < 16; ++m) {
+				unsigned n = 0;
+				for (unsigned l = 0; l < 4; ++l) {
+					if (m >> l & 1) {
+						qwords[m] |= std::uint64_t { 2 * l }	 << 8 * n++;
+						qwords[m] |= std::uint64_t { 2 * l + 1 } << 8 * n++;
+					}
+				}
+			}
+		}
+	};
+
+
+	inline const CompressTable&	GetCompressTable()
+	{
+		static constexpr CompressTable table;
+		return table;
+	}
+
+
+	/// Compress-store: selected lanes are permuted to the front of a full vector store.
+	template <class T, enable_if_t<sizeof(T) == 4, int> = 0>
+	ENUMERABLES_TARGET_AVX2
+	size_t	CompressAvx2(const StridedSpan<T>& values, std::uint64_t mask, T* out)
+	{
+		const CompressTable& table	 = GetCompressTable();
+		const int			 stride	 = static_cast<int>(values.stride);
+		const __m256i		 offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+		const __m256i		 every	 = _mm256_set1_epi32(-1);
+
+		size_t n = 0;
+		size_t i = 0;
+		for (; i + 8 <= values.count; i += 8) {
+			const unsigned m = static_cast<unsigned>(mask >> i) & 0xFF;
+			if (m == 0)
+				continue;
+
+			const int*	  p		= reinterpret_cast<const int*>(&values[i]);
+			const __m256i v		= values.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+														: _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), p, offsets, every, 1);
+			const __m256i lanes	= _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.dwords + m)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + n), _mm256_permutevar8x32_epi32(v, lanes));
+			n += std::bitset<8>(m).count();
+		}
+		return i < values.count ? n + CompressScalar(values.Slice(i, values.count - i), mask >> i, out + n)
+								: n;
+	}
+
+
+	template <class T, enable_if_t<sizeof(T) == 8, int> = 0>
+	ENUMERABLES_TARGET_AVX2
+	size_t	CompressAvx2(const StridedSpan<T>& values, std::uint64_t mask, T* out)
+	{
+		const CompressTable& table	 = GetCompressTable();
+		const int			 stride	 = static_cast<int>(values.stride);
+		const __m128i		 offsets = _mm_setr_epi32(0, stride, 2 * stride, 3 * stride);
+		const __m256i		 every	 = _mm256_set1_epi32(-1);
+
+		size_t n = 0;
+		size_t i = 0;
+		for (; i + 4 <= values.count; i += 4) {
+			const unsigned m = static_cast<unsigned>(mask >> i) & 0xF;
+			if (m == 0)
+				continue;
+
+			const long long* p	   = reinterpret_cast<const long long*>(&values[i]);
+			const __m256i	 v	   = values.IsContiguous() ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+														   : _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), p, offsets, every, 1);
+			const __m256i	 lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.qwords + m)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + n), _mm256_permutevar8x32_epi32(v, lanes));
+			n += std::bitset<4>(m).count();
+		}
+		return i < values.count ? n + CompressScalar(values.Slice(i, values.count - i), mask >> i, out + n)
+								: n;
+	}
+
+#endif	// ENUMERABLES_SIMD_X86
+
+
+#if ENUMERABLES_SIMD_NEON
+
+	// NEON compares directly, except != as negated ==. Lanes are reduced to a mask by weights of their bits.
+
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskNeon(const StridedSpan<double>& keys, double operand)
+	{
+		static const std::uint64_t weightBits[2] = { 1, 2 };
+		constexpr int			   flip			 = Op == CompareOp::NotEqual ? 0x3 : 0;
+
+		const double*	  p		  = &keys[0];
+		const float64x2_t c		  = vdupq_n_f64(operand);
+		const uint64x2_t  weights = vld1q_u64(weightBits);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 2 <= keys.count; i += 2) {
+			const float64x2_t v = vld1q_f64(p + i);
+			const uint64x2_t  r = Op == CompareOp::Less			? vcltq_f64(v, c)
+								: Op == CompareOp::LessEqual	? vcleq_f64(v, c)
+								: Op == CompareOp::Greater		? vcgtq_f64(v, c)
+								: Op == CompareOp::GreaterEqual	? vcgeq_f64(v, c)
+								:								  vceqq_f64(v, c);
+			mask |= (vaddvq_u64(vandq_u64(r, weights)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskNeon(const StridedSpan<float>& keys, float operand)
+	{
+		static const std::uint32_t weightBits[4] = { 1, 2, 4, 8 };
+		constexpr int			   flip			 = Op == CompareOp::NotEqual ? 0xF : 0;
+
+		const float*	  p		  = &keys[0];
+		const float32x4_t c		  = vdupq_n_f32(operand);
+		const uint32x4_t  weights = vld1q_u32(weightBits);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 4 <= keys.count; i += 4) {
+			const float32x4_t v = vld1q_f32(p + i);
+			const uint32x4_t  r = Op == CompareOp::Less			? vcltq_f32(v, c)
+								: Op == CompareOp::LessEqual	? vcleq_f32(v, c)
+								: Op == CompareOp::Greater		? vcgtq_f32(v, c)
+								: Op == CompareOp::GreaterEqual	? vcgeq_f32(v, c)
+								:								  vceqq_f32(v, c);
+			mask |= static_cast<std::uint64_t>(vaddvq_u32(vandq_u32(r, weights)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskNeon(const StridedSpan<std::int32_t>& keys, std::int32_t operand)
+	{
+		static const std::uint32_t weightBits[4] = { 1, 2, 4, 8 };
+		constexpr int			   flip			 = Op == CompareOp::NotEqual ? 0xF : 0;
+
+		const std::int32_t*	p		= &keys[0];
+		const int32x4_t		c		= vdupq_n_s32(operand);
+		const uint32x4_t	weights = vld1q_u32(weightBits);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 4 <= keys.count; i += 4) {
+			const int32x4_t  v = vld1q_s32(p + i);
+			const uint32x4_t r = Op == CompareOp::Less			? vcltq_s32(v, c)
+							   : Op == CompareOp::LessEqual		? vcleq_s32(v, c)
+							   : Op == CompareOp::Greater		? vcgtq_s32(v, c)
+							   : Op == CompareOp::GreaterEqual	? vcgeq_s32(v, c)
+							   :								  vceqq_s32(v, c);
+			mask |= static_cast<std::uint64_t>(vaddvq_u32(vandq_u32(r, weights)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	std::uint64_t	CompareMaskNeon(const StridedSpan<std::int64_t>& keys, std::int64_t operand)
+	{
+		static const std::uint64_t weightBits[2] = { 1, 2 };
+		constexpr int			   flip			 = Op == CompareOp::NotEqual ? 0x3 : 0;
+
+		const std::int64_t*	p		= &keys[0];
+		const int64x2_t		c		= vdupq_n_s64(operand);
+		const uint64x2_t	weights = vld1q_u64(weightBits);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 2 <= keys.count; i += 2) {
+			const int64x2_t  v = vld1q_s64(p + i);
+			const uint64x2_t r = Op == CompareOp::Less			? vcltq_s64(v, c)
+							   : Op == CompareOp::LessEqual		? vcleq_s64(v, c)
+							   : Op == CompareOp::Greater		? vcgtq_s64(v, c)
+							   : Op == CompareOp::GreaterEqual	? vcgeq_s64(v, c)
+							   :								  vceqq_s64(v, c);
+			mask |= (vaddvq_u64(vandq_u64(r, weights)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_NEON
+
+
+	/// Comparison mask of a non-empty block of up to 64 keys by the best kernel available.
+	template <CompareOp Op, class T>
+	std::uint64_t	KernelCompareMask(const StridedSpan<T>& keys, const T& operand)
+	{
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() == SimdLevel::Avx2 && keys.IsGatherable())
+			return CompareMaskAvx2<Op>(keys, operand);
+		if (ActiveSimdLevel() >= SimdLevel::Sse2 && keys.IsContiguous())
+			return CompareMaskSse2<Op>(keys, operand);
+#elif ENUMERABLES_SIMD_NEON
+		if (ActiveSimdLevel() == SimdLevel::Neon && keys.IsContiguous())
+			return CompareMaskNeon<Op>(keys, operand);
+#endif
+		return CompareMaskScalar<Op>(keys, operand);
+	}
+
+
+	/// Selected values of a block compacted to out - with room for 8 more values than the block.
+	template <class T>
+	size_t	KernelCompress(const StridedSpan<T>& values, std::uint64_t mask, T* out)
+	{
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() == SimdLevel::Avx2 && values.IsGatherable())
+			return CompressAvx2(values, mask, out);
+#endif
+		return CompressScalar(values, mask, out);
+	}
+
+
+
+	/// The operand converts to TKey just as for the scalar comparison.
+	/// (common_type is only asked for kernel types: TKey is void for sources without a contiguous view.)
+	template <class TKey, class T, bool = HasCompareKernel<TKey>::value && std::is_arithmetic<T>::value>
+	struct IsKernelComparable : std::false_type {};
+
+	template <class TKey, class T>
+	struct IsKernelComparable<TKey, T, true> : is_same<std::common_type_t<TKey, T>, TKey> {};
+
+
+	/// Recognizes simple predicates over objects of TValue.
+	/// Specializations provide:
+	///		- static std::uint64_t Mask(const Pred&, const StridedSpan<TValue>& block)	- for non-empty blocks of up to 64 objects
+	template <class Pred, class TValue, class = void>
+	struct PredicateMask {};
+
+
+	template <CompareOp Op, class T, class TValue>
+	struct PredicateMask<Predicates::Comparison<Op, T, Predicates::Itself>, TValue, enable_if_t<IsKernelComparable<TValue, T>::value>> {
+
+		static std::uint64_t	Mask(const Predicates::Comparison<Op, T, Predicates::Itself>& pred, const StridedSpan<TValue>& block)
+		{
+			using TKernel = KernelValueT<TValue>;
+			return KernelCompareMask<Op>(block.template As<TKernel>(), static_cast<TKernel>(static_cast<TValue>(pred.operand)));
+		}
+	};
+
+
+	template <CompareOp Op, class T, class C, class F, class TValue>
+	struct PredicateMask<Predicates::Comparison<Op, T, Predicates::Field<F C::*>>, TValue,
+						 enable_if_t<is_same<C, TValue>::value && IsKernelComparable<std::remove_cv_t<F>, T>::value>> {
+
+		static std::uint64_t	Mask(const Predicates::Comparison<Op, T, Predicates::Field<F C::*>>& pred, const StridedSpan<TValue>& block)
+		{
+			using TField  = std::remove_cv_t<F>;
+			using TKernel = KernelValueT<TField>;
+
+			const auto keys = FieldSpan(block, pred.projection.member).template As<TKernel>();
+			return KernelCompareMask<Op>(keys, static_cast<TKernel>(static_cast<TField>(pred.operand)));
+		}
+	};
+
+
+	template <class L, class R, class TValue>
+	struct PredicateMask<Predicates::Conjunction<L, R>, TValue,
+						 void_t<decltype(&PredicateMask<L, TValue>::Mask), decltype(&PredicateMask<R, TValue>::Mask)>> {
+
+		static std::uint64_t	Mask(const Predicates::Conjunction<L, R>& pred, const StridedSpan<TValue>& block)
+		{
+			return PredicateMask<L, TValue>::Mask(pred.lhs, block) & PredicateMask<R, TValue>::Mask(pred.rhs, block);
+		}
+	};
+
+
+	template <class L, class R, class TValue>
+	struct PredicateMask<Predicates::Disjunction<L, R>, TValue,
+						 void_t<decltype(&PredicateMask<L, TValue>::Mask), decltype(&PredicateMask<R, TValue>::Mask)>> {
+
+		static std::uint64_t	Mask(const Predicates::Disjunction<L, R>& pred, const StridedSpan<TValue>& block)
+		{
+			return PredicateMask<L, TValue>::Mask(pred.lhs, block) | PredicateMask<R, TValue>::Mask(pred.rhs, block);
+		}
+	};
+
+
+
+	template <class Ops, class Cont, class T, class = void>
+	struct HasAddRange : std::false_type {};
+
+	template <class Ops, class Cont, class T>
+	struct HasAddRange<Ops, Cont, T, void_t<decltype(Ops::AddRange(declval<Cont&>(), declval<const T*>(), declval<const T*>()))>> : std::true_type {};
+
+
+	template <class Ops, class Cont, class T, enable_if_t<HasAddRange<Ops, Cont, T>::value, int> = 0>
+	void	AddRange(Cont& target, const T* first, const T* last)
+	{
+		Ops::AddRange(target, first, last);
+	}
+
+	template <class Ops, class Cont, class T, enable_if_t<!HasAddRange<Ops, Cont, T>::value, int> = 0>
+	void	AddRange(Cont& target, const T* first, const T* last)
+	{
+		for (; first != last; ++first)
+			Ops::Add(target, *first);
+	}
+
+
+	/// Arithmetic values are compress-stored, then appended at once.
+	template <class Ops, class Cont, class T, enable_if_t<HasCompareKernel<T>::value, int> = 0>
+	void	AddSelected(Cont& target, const StridedSpan<T>& block, std::uint64_t mask)
+	{
+		T			 survivors[64 + 8];
+		const size_t n = KernelCompress(block, mask, survivors);
+		AddRange<Ops>(target, survivors, survivors + n);
+	}
+
+	template <class Ops, class Cont, class T, enable_if_t<!HasCompareKernel<T>::value, int> = 0>
+	void	AddSelected(Cont& target, const StridedSpan<T>& block, std::uint64_t mask)
+	{
+		for (size_t i = 0; i < block.count; ++i) {
+			if (mask >> i & 1)
+				Ops::Add(target, block[i]);
+		}
+	}
+
+
+	/// Evaluates simple predicates for blocks of viewed objects by kernels, then copies the survivors to the results.
+	/// Only for results storing the objects themselves - not reference wrappers or conversions of them.
+	template <class Source, class Pred>
+	struct CollectKernel<FilterEnumerator<Source, Pred>, void_t<decltype(&PredicateMask<Pred, ViewedValueT<Source>>::Mask)>> {
+
+		using TValue = ViewedValueT<Source>;
+
+		static constexpr size_t blockSize = 64;
+
+		template <class ContainerOps, class R, class Cont, enable_if_t<is_same<StorableT<R>, TValue>::value, int> = 0>
+		static bool	TryCollect(FilterEnumerator<Source, Pred>& etor, Cont& results)
+		{
+			const auto values = StridedView<Source>::Get(etor.Inner());
+
+			for (size_t start = 0; start < values.count; start += blockSize) {
+				const auto			block = values.Slice(start, (std::min)(blockSize, values.count - start));
+				const std::uint64_t mask  = PredicateMask<Pred, TValue>::Mask(etor.Condition(), block);
+				if (mask != 0)
+					AddSelected<ContainerOps>(results, block, mask);
+			}
+			return true;
+		}
+
+		template <class ContainerOps, class R, class Cont, enable_if_t<!is_same<StorableT<R>, TValue>::value, int> = 0>
+		static bool	TryCollect(FilterEnumerator<Source, Pred>&, Cont&)
+		{
+			return false;
+		}
+	};
+
+#pragma endregion
+
+
+#pragma region Equality kernels
+
+	/// Kernels compare values of T for equality: floating point by value, other scalars bitwise.
+	template <class T>
+	struct HasEqualityKernel {
+		static constexpr bool value = (std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value
+									   || is_same<T, float>::value || is_same<T, double>::value)
+								   && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+	};
+
+	template <>
+	struct HasEqualityKernel<void> : std::false_type {};
+
+
+	/// Type the equality kernels operate with on values of T.
+	template <class T>
+	using EqualityKernelValueT = conditional_t<std::is_floating_point<T>::value,
+											   T,
+											   conditional_t<sizeof(T) == 1, std::int8_t,
+											   conditional_t<sizeof(T) == 2, std::int16_t,
+																			 KernelValueT<T>>>>;
+
+
+	/// Elements of Etor can be compared to a V by an equality kernel.
+	template <class Etor, class V>
+	struct IsVectorEquatable {
+		static constexpr bool value = HasEqualityKernel<ViewedValueT<Etor>>::value && is_same<decay_t<V>, ViewedValueT<Etor>>::value;
+	};
+
+
+	template <class U, class T>
+	U	BitCast(const T& value)
+	{
+		static_assert (sizeof(U) == sizeof(T), "Size mismatch.");
+
+		U result;
+		std::memcpy(&result, &value, sizeof(U));
+		return result;
+	}
+
+
+	/// @pre mask != 0
+	inline size_t	LowestSetBit(std::uint64_t mask)
+	{
+		return std::bitset<64>((mask & (0 - mask)) - 1).count();
+	}
+
+
+#if ENUMERABLES_SIMD_X86
+
+	template <CompareOp Op>
+	std::uint64_t	EqualityMaskSse2(const StridedSpan<std::int8_t>& keys, std::int8_t operand)
+	{
+		constexpr unsigned flip = Op == CompareOp::NotEqual ? 0xFFFF : 0;
+
+		const std::int8_t*	p = &keys[0];
+		const __m128i		c = _mm_set1_epi8(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 16 <= keys.count; i += 16) {
+			const __m128i r = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), c);
+			mask |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(r)) ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+
+	template <CompareOp Op>
+	std::uint64_t	EqualityMaskSse2(const StridedSpan<std::int16_t>& keys, std::int16_t operand)
+	{
+		constexpr unsigned flip = Op == CompareOp::NotEqual ? 0xFF : 0;
+
+		const std::int16_t*	p = &keys[0];
+		const __m128i		c = _mm_set1_epi16(operand);
+
+		std::uint64_t mask = 0;
+		size_t		  i	   = 0;
+		for (; i + 8 <= keys.count; i += 8) {
+			const __m128i r		 = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), c);
+			const unsigned bits	 = static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(r, _mm_setzero_si128()))) & 0xFF;
+			mask |= static_cast<std::uint64_t>(bits ^ flip) << i;
+		}
+		return mask | TailMask<Op>(keys, operand, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_X86
+
+
+	/// Equal or NotEqual mask of a non-empty block of up to 64 keys.
+	template <CompareOp Op, class T>
+	std::uint64_t	KernelEqualityMask(const StridedSpan<T>& keys, const T& operand)
+	{
+		return KernelCompareMask<Op>(keys, operand);
+	}
+
+	// narrow integers: SSE2 on x86 - compilers vectorize the scalar loop well elsewhere
+	template <CompareOp Op>
+	std::uint64_t	KernelEqualityMask(const StridedSpan<std::int8_t>& keys, std::int8_t operand)
+	{
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() >= SimdLevel::Sse2 && keys.IsContiguous())
+			return EqualityMaskSse2<Op>(keys, operand);
+#endif
+		return CompareMaskScalar<Op>(keys, operand);
+	}
+
+	template <CompareOp Op>
+	std::uint64_t	KernelEqualityMask(const StridedSpan<std::int16_t>& keys, std::int16_t operand)
+	{
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() >= SimdLevel::Sse2 && keys.IsContiguous())
+			return EqualityMaskSse2<Op>(keys, operand);
+#endif
+		return CompareMaskScalar<Op>(keys, operand);
+	}
+
+
+	/// Index of the first key satisfying Op (Equal or NotEqual) - or count if none. Exits early by blocks.
+	template <CompareOp Op, class T>
+	size_t	FindByMask(const StridedSpan<T>& keys, const T& operand)
+	{
+		constexpr size_t blockSize = 64;
+
+		for (size_t start = 0; start < keys.count; start += blockSize) {
+			const std::uint64_t mask = KernelEqualityMask<Op>(keys.Slice(start, (std::min)(blockSize, keys.count - start)), operand);
+			if (mask != 0)
+				return start + LowestSetBit(mask);
+		}
+		return keys.count;
+	}
+
+
+	template <CompareOp Op, class T>
+	size_t	KernelFind(const StridedSpan<T>& keys, const T& operand)
+	{
+		return FindByMask<Op>(keys, operand);
+	}
+
+	// bytes: memchr is the fastest search available
+	template <CompareOp Op>
+	size_t	KernelFind(const StridedSpan<std::int8_t>& keys, std::int8_t operand)
+	{
+		if (Op != CompareOp::Equal || !keys.IsContiguous() || keys.count == 0)
+			return FindByMask<Op>(keys, operand);
+
+		const void* found = std::memchr(keys.first, static_cast<unsigned char>(operand), keys.count);
+		return found != nullptr ? static_cast<size_t>(static_cast<const char*>(found) - keys.first)
+								: keys.count;
+	}
+
+
+
+	/// Index of the first value satisfying Op (Equal or NotEqual) with the operand - or count if none.
+	template <CompareOp Op, class T>
+	size_t	VectorFind(const StridedSpan<T>& values, const T& operand)
+	{
+		using TKernel = EqualityKernelValueT<T>;
+		return KernelFind<Op>(values.template As<TKernel>(), BitCast<TKernel>(operand));
+	}
+
+
+	template <class T>
+	size_t	VectorCount(const StridedSpan<T>& values, const T& operand)
+	{
+		using TKernel = EqualityKernelValueT<T>;
+
+		constexpr size_t blockSize = 64;
+
+		const auto	  keys = values.template As<TKernel>();
+		const TKernel key  = BitCast<TKernel>(operand);
+		size_t		  n	   = 0;
+		for (size_t start = 0; start < keys.count; start += blockSize) {
+			const std::uint64_t mask = KernelEqualityMask<CompareOp::Equal>(keys.Slice(start, (std::min)(blockSize, keys.count - start)), key);
+			n += std::bitset<64>(mask).count();
+		}
+		return n;
+	}
+
+#pragma endregion
+
+
+
+#pragma region Neighbor kernels
+
+	enum class ArithmeticOp : char { None, Plus, Minus, Divides };
+
+
+	/// Standard arithmetic functors recognized by the kernels.
+	template <class F>	struct ArithmeticOpOf					: std::integral_constant<ArithmeticOp, ArithmeticOp::None>	  {};
+	template <class X>	struct ArithmeticOpOf<std::plus<X>>		: std::integral_constant<ArithmeticOp, ArithmeticOp::Plus>	  {};
+	template <class X>	struct ArithmeticOpOf<std::minus<X>>	: std::integral_constant<ArithmeticOp, ArithmeticOp::Minus>	  {};
+	template <class X>	struct ArithmeticOpOf<std::divides<X>>	: std::integral_constant<ArithmeticOp, ArithmeticOp::Divides> {};
+
+
+	/// F is recognized arithmetic on kernel values of T, yielding T again.
+	/// Integer operands are reinterpreted as signed: equivalent for wrapping addition and subtraction.
+	template <class F, class T, class = void>
+	struct IsKernelArithmetic : std::false_type {};
+
+	template <class F, class T>
+	struct IsKernelArithmetic<F, T, enable_if_t<ArithmeticOpOf<F>::value != ArithmeticOp::None && std::is_arithmetic<T>::value>> {
+		static constexpr ArithmeticOp op = ArithmeticOpOf<F>::value;
+
+		static constexpr bool value = HasCompareKernel<KernelValueT<T>>::value && (sizeof(T) == 4 || sizeof(T) == 8)
+								   && (op != ArithmeticOp::Divides || std::is_floating_point<T>::value)
+								   && is_same<decay_t<CombinedT<const T&, const T&, F>>, T>::value;
+	};
+
+
+#if ENUMERABLES_SIMD_X86
+
+	// Each kernel writes out[i] = values[i] op values[i + 1] by shifted loads while whole vectors fit,
+	// returning the number of results written.
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsSse2(const StridedSpan<double>& values, double* out)
+	{
+		const double* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 3 <= values.count; i += 2) {
+			const __m128d a = _mm_loadu_pd(p + i);
+			const __m128d b = _mm_loadu_pd(p + i + 1);
+			_mm_storeu_pd(out + i, Op == ArithmeticOp::Plus	 ? _mm_add_pd(a, b)
+								 : Op == ArithmeticOp::Minus ? _mm_sub_pd(a, b)
+								 :							   _mm_div_pd(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsSse2(const StridedSpan<float>& values, float* out)
+	{
+		const float* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 5 <= values.count; i += 4) {
+			const __m128 a = _mm_loadu_ps(p + i);
+			const __m128 b = _mm_loadu_ps(p + i + 1);
+			_mm_storeu_ps(out + i, Op == ArithmeticOp::Plus	 ? _mm_add_ps(a, b)
+								 : Op == ArithmeticOp::Minus ? _mm_sub_ps(a, b)
+								 :							   _mm_div_ps(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsSse2(const StridedSpan<std::int32_t>& values, std::int32_t* out)
+	{
+		const std::int32_t* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 5 <= values.count; i += 4) {
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 1));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Op == ArithmeticOp::Plus ? _mm_add_epi32(a, b) : _mm_sub_epi32(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsSse2(const StridedSpan<std::int64_t>& values, std::int64_t* out)
+	{
+		const std::int64_t* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 3 <= values.count; i += 2) {
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 1));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), Op == ArithmeticOp::Plus ? _mm_add_epi64(a, b) : _mm_sub_epi64(a, b));
+		}
+		return i;
+	}
+
+
+
+	template <ArithmeticOp Op>
+	ENUMERABLES_TARGET_AVX2
+	size_t	NeighborsAvx2(const StridedSpan<double>& values, double* out)
+	{
+		const double* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 5 <= values.count; i += 4) {
+			const __m256d a = _mm256_loadu_pd(p + i);
+			const __m256d b = _mm256_loadu_pd(p + i + 1);
+			_mm256_storeu_pd(out + i, Op == ArithmeticOp::Plus  ? _mm256_add_pd(a, b)
+									: Op == ArithmeticOp::Minus ? _mm256_sub_pd(a, b)
+									:							  _mm256_div_pd(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	ENUMERABLES_TARGET_AVX2
+	size_t	NeighborsAvx2(const StridedSpan<float>& values, float* out)
+	{
+		const float* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 9 <= values.count; i += 8) {
+			const __m256 a = _mm256_loadu_ps(p + i);
+			const __m256 b = _mm256_loadu_ps(p + i + 1);
+			_mm256_storeu_ps(out + i, Op == ArithmeticOp::Plus  ? _mm256_add_ps(a, b)
+									: Op == ArithmeticOp::Minus ? _mm256_sub_ps(a, b)
+									:							  _mm256_div_ps(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	ENUMERABLES_TARGET_AVX2
+	size_t	NeighborsAvx2(const StridedSpan<std::int32_t>& values, std::int32_t* out)
+	{
+		const std::int32_t* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 9 <= values.count; i += 8) {
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), Op == ArithmeticOp::Plus ? _mm256_add_epi32(a, b) : _mm256_sub_epi32(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	ENUMERABLES_TARGET_AVX2
+	size_t	NeighborsAvx2(const StridedSpan<std::int64_t>& values, std::int64_t* out)
+	{
+		const std::int64_t* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 5 <= values.count; i += 4) {
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), Op == ArithmeticOp::Plus ? _mm256_add_epi64(a, b) : _mm256_sub_epi64(a, b));
+		}
+		return i;
+	}
+
+#endif	// ENUMERABLES_SIMD_X86
+
+
+#if ENUMERABLES_SIMD_NEON
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsNeon(const StridedSpan<double>& values, double* out)
+	{
+		const double* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 3 <= values.count; i += 2) {
+			const float64x2_t a = vld1q_f64(p + i);
+			const float64x2_t b = vld1q_f64(p + i + 1);
+			vst1q_f64(out + i, Op == ArithmeticOp::Plus	 ? vaddq_f64(a, b)
+							 : Op == ArithmeticOp::Minus ? vsubq_f64(a, b)
+							 :							   vdivq_f64(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsNeon(const StridedSpan<float>& values, float* out)
+	{
+		const float* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 5 <= values.count; i += 4) {
+			const float32x4_t a = vld1q_f32(p + i);
+			const float32x4_t b = vld1q_f32(p + i + 1);
+			vst1q_f32(out + i, Op == ArithmeticOp::Plus	 ? vaddq_f32(a, b)
+							 : Op == ArithmeticOp::Minus ? vsubq_f32(a, b)
+							 :							   vdivq_f32(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsNeon(const StridedSpan<std::int32_t>& values, std::int32_t* out)
+	{
+		const std::int32_t* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 5 <= values.count; i += 4) {
+			const int32x4_t a = vld1q_s32(p + i);
+			const int32x4_t b = vld1q_s32(p + i + 1);
+			vst1q_s32(out + i, Op == ArithmeticOp::Plus ? vaddq_s32(a, b) : vsubq_s32(a, b));
+		}
+		return i;
+	}
+
+
+	template <ArithmeticOp Op>
+	size_t	NeighborsNeon(const StridedSpan<std::int64_t>& values, std::int64_t* out)
+	{
+		const std::int64_t* p = &values[0];
+
+		size_t i = 0;
+		for (; i + 3 <= values.count; i += 2) {
+			const int64x2_t a = vld1q_s64(p + i);
+			const int64x2_t b = vld1q_s64(p + i + 1);
+			vst1q_s64(out + i, Op == ArithmeticOp::Plus ? vaddq_s64(a, b) : vsubq_s64(a, b));
+		}
+		return i;
+	}
+
+#endif	// ENUMERABLES_SIMD_NEON
+
+
+	/// Leading results of a block written by the best available kernel - their count returned, the rest is left to the caller.
+	template <ArithmeticOp Op, class T>
+	size_t	KernelNeighbors(const StridedSpan<T>& values, T* out)
+	{
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() == SimdLevel::Avx2 && values.IsContiguous())
+			return NeighborsAvx2<Op>(values, out);
+		if (ActiveSimdLevel() >= SimdLevel::Sse2 && values.IsContiguous())
+			return NeighborsSse2<Op>(values, out);
+#elif ENUMERABLES_SIMD_NEON
+		if (ActiveSimdLevel() == SimdLevel::Neon && values.IsContiguous())
+			return NeighborsNeon<Op>(values, out);
+#endif
+		return 0;
+	}
+
+
+
+	/// Binary operations of MapNeighbors evaluated for a block of viewed values at once.
+	/// Specializations provide:
+	///		- TResult
+	///		- static void Block(const Combiner&, const StridedSpan<TValue>&, TResult* out)	- writing count - 1 results
+	template <class Combiner, class TValue, class = void>
+	struct NeighborBlock {};
+
+
+	template <class Combiner, class TValue>
+	struct NeighborBlock<Combiner, TValue, enable_if_t<IsKernelArithmetic<Combiner, TValue>::value>> {
+
+		using TResult = TValue;
+
+		static void	Block(const Combiner& binop, const StridedSpan<TValue>& values, TResult* out)
+		{
+			using TKernel = KernelValueT<TValue>;
+
+			size_t i = KernelNeighbors<ArithmeticOpOf<Combiner>::value>(values.template As<TKernel>(), reinterpret_cast<TKernel*>(out));
+			for (; i + 1 < values.count; ++i)
+				out[i] = binop(values[i], values[i + 1]);
+		}
+	};
+
+
+	/// Binary operations known to be pure: declared Elementwise or placeholder expressions.
+	template <class F>	struct IsElementwise					: Placeholders::IsExpression<F> {};
+	template <class F>	struct IsElementwise<ElementwiseOp<F>>	: std::true_type {};
+
+
+	// No dependency between the calls, unlike when enumerated - left to the compiler to vectorize.
+	template <class Combiner, class TValue>
+	struct NeighborBlock<Combiner, TValue, enable_if_t<IsElementwise<Combiner>::value
+													   && std::is_trivial<decay_t<CombinedT<const TValue&, const TValue&, Combiner>>>::value>> {
+
+		using TResult = decay_t<CombinedT<const TValue&, const TValue&, Combiner>>;
+
+		static void	Block(const Combiner& binop, const StridedSpan<TValue>& values, TResult* out)
+		{
+			for (size_t i = 0; i + 1 < values.count; ++i)
+				out[i] = binop(values[i], values[i + 1]);
+		}
+	};
+
+
+	/// Evaluates recognized operations for blocks of neighboring viewed values, appending the results at once.
+	/// Only for results storing the combined values themselves.
+	template <class Source, class Combiner>
+	struct CollectKernel<CombinerEnumerator<Source, Combiner>, void_t<typename NeighborBlock<Combiner, ViewedValueT<Source>>::TResult>> {
+
+		using TValue  = ViewedValueT<Source>;
+		using Kernel  = NeighborBlock<Combiner, TValue>;
+		using TResult = typename Kernel::TResult;
+
+		static constexpr size_t blockSize = 64;
+
+		template <class ContainerOps, class R, class Cont, enable_if_t<is_same<StorableT<R>, TResult>::value, int> = 0>
+		static bool	TryCollect(CombinerEnumerator<Source, Combiner>& etor, Cont& results)
+		{
+			const auto values = StridedView<Source>::Get(etor.Inner());
+
+			TResult combined[blockSize];
+			for (size_t start = 0; start + 1 < values.count; start += blockSize) {
+				const auto block = values.Slice(start, (std::min)(blockSize + 1, values.count - start));
+				Kernel::Block(etor.Operation(), block, combined);
+				AddRange<ContainerOps>(results, combined, combined + block.count - 1);
+			}
+			return true;
+		}
+
+		template <class ContainerOps, class R, class Cont, enable_if_t<!is_same<StorableT<R>, TResult>::value, int> = 0>
+		static bool	TryCollect(CombinerEnumerator<Source, Combiner>&, Cont&)
+		{
+			return false;
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region Expression kernels
+
+	/// Mappers evaluated for a block of viewed values at once: placeholder expressions, known to be pure.
+	/// Specializations provide:
+	///		- TResult
+	///		- static void Block(const Mapper&, const StridedSpan<TValue>&, TResult* out)
+	template <class Mapper, class TValue, class = void>
+	struct MapBlock {};
+
+
+	template <class Mapper, class TValue>
+	struct MapBlock<Mapper, TValue, enable_if_t<Placeholders::IsExpression<Mapper>::value
+												&& std::is_trivial<decay_t<InvokeResultT<const Mapper&, const TValue&>>>::value>> {
+
+		using TResult = decay_t<InvokeResultT<const Mapper&, const TValue&>>;
+
+		static void	Block(const Mapper& map, const StridedSpan<TValue>& values, TResult* out)
+		{
+			for (size_t i = 0; i < values.count; ++i)
+				out[i] = map(values[i]);
+		}
+	};
+
+
+	/// Evaluates expressions for blocks of viewed values, appending the results at once.
+	template <class Source, class Mapper>
+	struct CollectKernel<MapperEnumerator<Source, Mapper>, void_t<typename MapBlock<Mapper, ViewedValueT<Source>>::TResult>> {
+
+		using TValue  = ViewedValueT<Source>;
+		using Kernel  = MapBlock<Mapper, TValue>;
+		using TResult = typename Kernel::TResult;
+
+		static constexpr size_t blockSize = 64;
+
+		template <class ContainerOps, class R, class Cont, enable_if_t<is_same<StorableT<R>, TResult>::value, int> = 0>
+		static bool	TryCollect(MapperEnumerator<Source, Mapper>& etor, Cont& results)
+		{
+			const auto values = StridedView<Source>::Get(etor.Inner());
+
+			TResult mapped[blockSize];
+			for (size_t start = 0; start < values.count; start += blockSize) {
+				const auto block = values.Slice(start, (std::min)(blockSize, values.count - start));
+				Kernel::Block(etor.Mapping(), block, mapped);
+				AddRange<ContainerOps>(results, mapped, mapped + block.count);
+			}
+			return true;
+		}
+
+		template <class ContainerOps, class R, class Cont, enable_if_t<!is_same<StorableT<R>, TResult>::value, int> = 0>
+		static bool	TryCollect(MapperEnumerator<Source, Mapper>&, Cont&)
+		{
+			return false;
+		}
+	};
+
+
+
+	/// Sum<S> of an expression's results can be computed by blocks in a fused loop.
+	template <class S, class Etor, class = void>
+	struct IsFusedSummable : std::false_type {};
+
+	template <class S, class Source, class Mapper>
+	struct IsFusedSummable<S, MapperEnumerator<Source, Mapper>, void_t<typename MapBlock<Mapper, ViewedValueT<Source>>::TResult>>
+		: HasSumKernel<S, typename MapBlock<Mapper, ViewedValueT<Source>>::TResult> {};
+
+
+	constexpr size_t	fusedSumBlock = 256;
+
+
+	/// Sum<S> of mapped values: each block is evaluated into a buffer, then summed by a kernel.
+	/// @pre	IsFusedSummable<S, MapperEnumerator<Source, Mapper>>, @p et is in initial state.
+	template <class S, class Source, class Mapper, enable_if_t<std::is_floating_point<S>::value, int> = 0>
+	S	FusedSum(const MapperEnumerator<Source, Mapper>& et)
+	{
+		using Kernel = MapBlock<Mapper, ViewedValueT<Source>>;
+
+		const auto values = StridedView<Source>::Get(et.Inner());
+
+		S					mapped[fusedSumBlock];
+		CompensatedSum<S>	total;
+		for (size_t start = 0; start < values.count; start += fusedSumBlock) {
+			const auto block = values.Slice(start, (std::min)(fusedSumBlock, values.count - start));
+			Kernel::Block(et.Mapping(), block, mapped);
+
+			const CompensatedSum<S> partial = KernelSum(StridedSpan<S> { reinterpret_cast<const char*>(mapped), sizeof(S), block.count });
+			total.Add(partial.sum);
+			total.Add(partial.err);
+		}
+		return total.Total();
+	}
+
+
+	template <class S, class Source, class Mapper, enable_if_t<std::is_integral<S>::value, int> = 0>
+	S	FusedSum(const MapperEnumerator<Source, Mapper>& et)
+	{
+		using Kernel  = MapBlock<Mapper, ViewedValueT<Source>>;
+		using TResult = typename Kernel::TResult;
+		using TKernel = KernelValueT<TResult>;
+
+		const auto values = StridedView<Source>::Get(et.Inner());
+
+		TResult		  mapped[fusedSumBlock];
+		std::uint64_t total = 0;
+		for (size_t start = 0; start < values.count; start += fusedSumBlock) {
+			const auto block = values.Slice(start, (std::min)(fusedSumBlock, values.count - start));
+			Kernel::Block(et.Mapping(), block, mapped);
+
+			total += KernelSum(StridedSpan<TKernel> { reinterpret_cast<const char*>(mapped), sizeof(TResult), block.count });
+		}
+		return static_cast<S>(total);
+	}
+
+#pragma endregion
+
+
+
+#pragma region Dot kernels
+
+	/// Zippers multiplying their arguments: std::multiplies, or _1 * _2 in either order.
+	template <class Zipper>	struct IsProductOp											: std::false_type {};
+	template <class X>		struct IsProductOp<std::multiplies<X>>						: std::true_type  {};
+	template <class F>		struct IsProductOp<ElementwiseOp<F>>						: IsProductOp<F>  {};
+	template <>				struct IsProductOp<Placeholders::Binary<std::multiplies<>, Placeholders::Arg<1>, Placeholders::Arg<2>>>
+																						: std::true_type  {};
+	template <>				struct IsProductOp<Placeholders::Binary<std::multiplies<>, Placeholders::Arg<2>, Placeholders::Arg<1>>>
+																						: std::true_type  {};
+
+
+	/// Zipper is a product of arithmetic T values, yielding T again.
+	template <class Zipper, class T, class = void>
+	struct IsProductZipper : std::false_type {};
+
+	template <class Zipper, class T>
+	struct IsProductZipper<Zipper, T, enable_if_t<IsProductOp<Zipper>::value && std::is_arithmetic<T>::value>>
+		: is_same<decay_t<CombinedT<const T&, const T&, Zipper>>, T> {};
+
+
+	/// Sum<S> of zipped products can be computed in a single pass over both sources - e.g. Zip(_1 * _2).Sum().
+	template <class S, class Etor>
+	struct IsDotSummable : std::false_type {};
+
+	template <class S, class Source1, class Source2, class Zipper>
+	struct IsDotSummable<S, ZipperEnumerator<Source1, Source2, Zipper, void>>
+		: std::integral_constant<bool, is_same<ViewedValueT<Source1>, ViewedValueT<Source2>>::value
+									&& IsProductZipper<Zipper, ViewedValueT<Source1>>::value
+									&& HasSumKernel<S, ViewedValueT<Source1>>::value> {};
+
+
+
+	template <class T, size_t L>
+	CompensatedSum<T>	MergeDotLanes(const T (&sums)[L], const T (&errs)[L], const StridedSpan<T>& a, const StridedSpan<T>& b, size_t tail)
+	{
+		CompensatedSum<T> total;
+		for (size_t l = 0; l < L; ++l) {
+			total.Add(sums[l]);
+			total.err += errs[l];
+		}
+		for (size_t i = tail; i < a.count; ++i)
+			total.Add(a[i] * b[i]);
+
+		return total;
+	}
+
+
+	// Products are rounded before accumulation (no FMA), exactly as the zipped elements would be.
+
+	template <class T, enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	CompensatedSum<T>	DotScalar(const StridedSpan<T>& a, const StridedSpan<T>& b)
+	{
+		CompensatedSum<T> total;
+		for (size_t i = 0; i < a.count; ++i)
+			total.Add(a[i] * b[i]);
+
+		return total;
+	}
+
+
+	// Wrapping products of kernel values, summed as by KernelSum. Contiguous loops are left to the compiler to vectorize.
+	template <class T, enable_if_t<std::is_integral<T>::value, int> = 0>
+	std::uint64_t		DotScalar(const StridedSpan<T>& a, const StridedSpan<T>& b)
+	{
+		using U = std::make_unsigned_t<T>;
+
+		std::uint64_t total = 0;
+		if (a.count > 0 && a.IsContiguous() && b.IsContiguous()) {
+			const T* pa = &a[0];
+			const T* pb = &b[0];
+			for (size_t i = 0; i < a.count; ++i) {
+				const T product = static_cast<T>(static_cast<U>(pa[i]) * static_cast<U>(pb[i]));
+				total += static_cast<std::uint64_t>(static_cast<std::int64_t>(product));
+			}
+			return total;
+		}
+
+		for (size_t i = 0; i < a.count; ++i) {
+			const T product = static_cast<T>(static_cast<U>(a[i]) * static_cast<U>(b[i]));
+			total += static_cast<std::uint64_t>(static_cast<std::int64_t>(product));
+		}
+		return total;
+	}
+
+
+#if ENUMERABLES_SIMD_X86
+
+	inline CompensatedSum<double>	DotSse2(const StridedSpan<double>& a, const StridedSpan<double>& b)
+	{
+		const double*	pa		 = &a[0];
+		const double*	pb		 = &b[0];
+		const __m128d	signMask = _mm_set1_pd(-0.0);
+		__m128d			sum		 = _mm_setzero_pd();
+		__m128d			err		 = _mm_setzero_pd();
+
+		size_t i = 0;
+		for (; i + 2 <= a.count; i += 2) {
+			const __m128d x		 = _mm_mul_pd(_mm_loadu_pd(pa + i), _mm_loadu_pd(pb + i));
+			const __m128d s0	 = sum;
+			sum = _mm_add_pd(s0, x);
+
+			const __m128d bigger = _mm_cmpge_pd(_mm_andnot_pd(signMask, s0), _mm_andnot_pd(signMask, x));
+			const __m128d diffX	 = _mm_sub_pd(x, _mm_sub_pd(sum, s0));
+			const __m128d diffS	 = _mm_sub_pd(s0, _mm_sub_pd(sum, x));
+			err = _mm_add_pd(err, _mm_or_pd(_mm_and_pd(bigger, diffX), _mm_andnot_pd(bigger, diffS)));
+		}
+
+		double sums[2], errs[2];
+		_mm_storeu_pd(sums, sum);
+		_mm_storeu_pd(errs, err);
+		return MergeDotLanes(sums, errs, a, b, i);
+	}
+
+
+	inline CompensatedSum<float>	DotSse2(const StridedSpan<float>& a, const StridedSpan<float>& b)
+	{
+		const float*	pa		 = &a[0];
+		const float*	pb		 = &b[0];
+		const __m128	signMask = _mm_set1_ps(-0.0f);
+		__m128			sum		 = _mm_setzero_ps();
+		__m128			err		 = _mm_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 4 <= a.count; i += 4) {
+			const __m128 x		= _mm_mul_ps(_mm_loadu_ps(pa + i), _mm_loadu_ps(pb + i));
+			const __m128 s0		= sum;
+			sum = _mm_add_ps(s0, x);
+
+			const __m128 bigger = _mm_cmpge_ps(_mm_andnot_ps(signMask, s0), _mm_andnot_ps(signMask, x));
+			const __m128 diffX	= _mm_sub_ps(x, _mm_sub_ps(sum, s0));
+			const __m128 diffS	= _mm_sub_ps(s0, _mm_sub_ps(sum, x));
+			err = _mm_add_ps(err, _mm_or_ps(_mm_and_ps(bigger, diffX), _mm_andnot_ps(bigger, diffS)));
+		}
+
+		float sums[4], errs[4];
+		_mm_storeu_ps(sums, sum);
+		_mm_storeu_ps(errs, err);
+		return MergeDotLanes(sums, errs, a, b, i);
+	}
+
+
+	ENUMERABLES_TARGET_AVX2
+	inline __m256d	LoadAvx2(const StridedSpan<double>& span, size_t i, __m128i offsets)
+	{
+		const double* p = &span[i];
+		return span.IsContiguous() ? _mm256_loadu_pd(p)
+								   : _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, offsets, _mm256_castsi256_pd(_mm256_set1_epi32(-1)), 1);
+	}
+
+
+	ENUMERABLES_TARGET_AVX2
+	inline __m256	LoadAvx2(const StridedSpan<float>& span, size_t i, __m256i offsets)
+	{
+		const float* p = &span[i];
+		return span.IsContiguous() ? _mm256_loadu_ps(p)
+								   : _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, offsets, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 1);
+	}
+
+
+	ENUMERABLES_TARGET_AVX2
+	inline CompensatedSum<double>	DotAvx2(const StridedSpan<double>& a, const StridedSpan<double>& b)
+	{
+		const int		strideA	 = static_cast<int>(a.stride);
+		const int		strideB	 = static_cast<int>(b.stride);
+		const __m128i	offsetsA = _mm_setr_epi32(0, strideA, 2 * strideA, 3 * strideA);
+		const __m128i	offsetsB = _mm_setr_epi32(0, strideB, 2 * strideB, 3 * strideB);
+		const __m256d	signMask = _mm256_set1_pd(-0.0);
+		__m256d			sum		 = _mm256_setzero_pd();
+		__m256d			err		 = _mm256_setzero_pd();
+
+		size_t i = 0;
+		for (; i + 4 <= a.count; i += 4) {
+			const __m256d x		 = _mm256_mul_pd(LoadAvx2(a, i, offsetsA), LoadAvx2(b, i, offsetsB));
+			const __m256d s0	 = sum;
+			sum = _mm256_add_pd(s0, x);
+
+			const __m256d bigger = _mm256_cmp_pd(_mm256_andnot_pd(signMask, s0), _mm256_andnot_pd(signMask, x), _CMP_GE_OQ);
+			const __m256d diffX	 = _mm256_sub_pd(x, _mm256_sub_pd(sum, s0));
+			const __m256d diffS	 = _mm256_sub_pd(s0, _mm256_sub_pd(sum, x));
+			err = _mm256_add_pd(err, _mm256_blendv_pd(diffS, diffX, bigger));
+		}
+
+		double sums[4], errs[4];
+		_mm256_storeu_pd(sums, sum);
+		_mm256_storeu_pd(errs, err);
+		return MergeDotLanes(sums, errs, a, b, i);
+	}
+
+
+	ENUMERABLES_TARGET_AVX2
+	inline CompensatedSum<float>	DotAvx2(const StridedSpan<float>& a, const StridedSpan<float>& b)
+	{
+		const __m256i	lanes	 = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		const __m256i	offsetsA = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(static_cast<int>(a.stride)));
+		const __m256i	offsetsB = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(static_cast<int>(b.stride)));
+		const __m256	signMask = _mm256_set1_ps(-0.0f);
+		__m256			sum		 = _mm256_setzero_ps();
+		__m256			err		 = _mm256_setzero_ps();
+
+		size_t i = 0;
+		for (; i + 8 <= a.count; i += 8) {
+			const __m256 x		= _mm256_mul_ps(LoadAvx2(a, i, offsetsA), LoadAvx2(b, i, offsetsB));
+			const __m256 s0		= sum;
+			sum = _mm256_add_ps(s0, x);
+
+			const __m256 bigger = _mm256_cmp_ps(_mm256_andnot_ps(signMask, s0), _mm256_andnot_ps(signMask, x), _CMP_GE_OQ);
+			const __m256 diffX	= _mm256_sub_ps(x, _mm256_sub_ps(sum, s0));
+			const __m256 diffS	= _mm256_sub_ps(s0, _mm256_sub_ps(sum, x));
+			err = _mm256_add_ps(err, _mm256_blendv_ps(diffS, diffX, bigger));
+		}
+
+		float sums[8], errs[8];
+		_mm256_storeu_ps(sums, sum);
+		_mm256_storeu_ps(errs, err);
+		return MergeDotLanes(sums, errs, a, b, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_X86
+
+
+#if ENUMERABLES_SIMD_NEON
+
+	inline CompensatedSum<double>	DotNeon(const StridedSpan<double>& a, const StridedSpan<double>& b)
+	{
+		const double* pa  = &a[0];
+		const double* pb  = &b[0];
+		float64x2_t	  sum = vdupq_n_f64(0.0);
+		float64x2_t	  err = vdupq_n_f64(0.0);
+
+		size_t i = 0;
+		for (; i + 2 <= a.count; i += 2) {
+			const float64x2_t x		 = vmulq_f64(vld1q_f64(pa + i), vld1q_f64(pb + i));
+			const float64x2_t s0	 = sum;
+			sum = vaddq_f64(s0, x);
+
+			const uint64x2_t  bigger = vcgeq_f64(vabsq_f64(s0), vabsq_f64(x));
+			const float64x2_t diffX	 = vsubq_f64(x, vsubq_f64(sum, s0));
+			const float64x2_t diffS	 = vsubq_f64(s0, vsubq_f64(sum, x));
+			err = vaddq_f64(err, vbslq_f64(bigger, diffX, diffS));
+		}
+
+		double sums[2], errs[2];
+		vst1q_f64(sums, sum);
+		vst1q_f64(errs, err);
+		return MergeDotLanes(sums, errs, a, b, i);
+	}
+
+
+	inline CompensatedSum<float>	DotNeon(const StridedSpan<float>& a, const StridedSpan<float>& b)
+	{
+		const float* pa	 = &a[0];
+		const float* pb	 = &b[0];
+		float32x4_t	 sum = vdupq_n_f32(0.0f);
+		float32x4_t	 err = vdupq_n_f32(0.0f);
+
+		size_t i = 0;
+		for (; i + 4 <= a.count; i += 4) {
+			const float32x4_t x		 = vmulq_f32(vld1q_f32(pa + i), vld1q_f32(pb + i));
+			const float32x4_t s0	 = sum;
+			sum = vaddq_f32(s0, x);
+
+			const uint32x4_t  bigger = vcgeq_f32(vabsq_f32(s0), vabsq_f32(x));
+			const float32x4_t diffX	 = vsubq_f32(x, vsubq_f32(sum, s0));
+			const float32x4_t diffS	 = vsubq_f32(s0, vsubq_f32(sum, x));
+			err = vaddq_f32(err, vbslq_f32(bigger, diffX, diffS));
+		}
+
+		float sums[4], errs[4];
+		vst1q_f32(sums, sum);
+		vst1q_f32(errs, err);
+		return MergeDotLanes(sums, errs, a, b, i);
+	}
+
+#endif	// ENUMERABLES_SIMD_NEON
+
+
+	/// Compensated sum of the products of paired values by the best kernel available for the spans.
+	/// @pre	a.count == b.count
+	template <class T, enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	CompensatedSum<T>	KernelDot(const StridedSpan<T>& a, const StridedSpan<T>& b)
+	{
+		if (a.count == 0)
+			return DotScalar(a, b);
+
+#if ENUMERABLES_SIMD_X86
+		if (ActiveSimdLevel() == SimdLevel::Avx2 && a.IsGatherable() && b.IsGatherable())
+			return DotAvx2(a, b);
+		if (ActiveSimdLevel() >= SimdLevel::Sse2 && a.IsContiguous() && b.IsContiguous())
+			return DotSse2(a, b);
+#elif ENUMERABLES_SIMD_NEON
+		if (ActiveSimdLevel() == SimdLevel::Neon && a.IsContiguous() && b.IsContiguous())
+			return DotNeon(a, b);
+#endif
+		return DotScalar(a, b);
+	}
+
+
+	/// Modular 64-bit sum of the wrapping products of paired values.
+	/// @pre	a.count == b.count
+	template <class T, enable_if_t<std::is_integral<T>::value, int> = 0>
+	std::uint64_t		KernelDot(const StridedSpan<T>& a, const StridedSpan<T>& b)
+	{
+		return DotScalar(a, b);
+	}
+
+
+
+	/// Sum<S> of zipped products, both sources read directly - as far as the shorter one lasts.
+	/// @pre	IsDotSummable<S, ZipperEnumerator<Source1, Source2, Zipper>>, @p et is in initial state.
+	template <class S, class Source1, class Source2, class Zipper, enable_if_t<std::is_floating_point<S>::value, int> = 0>
+	S	DotSum(const ZipperEnumerator<Source1, Source2, Zipper>& et)
+	{
+		const auto	 a = StridedView<Source1>::Get(et.Inner1());
+		const auto	 b = StridedView<Source2>::Get(et.Inner2());
+		const size_t n = (std::min)(a.count, b.count);
+
+		return KernelDot(a.Slice(0, n), b.Slice(0, n)).Total();
+	}
+
+
+	template <class S, class Source1, class Source2, class Zipper, enable_if_t<std::is_integral<S>::value, int> = 0>
+	S	DotSum(const ZipperEnumerator<Source1, Source2, Zipper>& et)
+	{
+		using TKernel = KernelValueT<ViewedValueT<Source1>>;
+
+		const auto	 a = StridedView<Source1>::Get(et.Inner1()).template As<TKernel>();
+		const auto	 b = StridedView<Source2>::Get(et.Inner2()).template As<TKernel>();
+		const size_t n = (std::min)(a.count, b.count);
+
+		return static_cast<S>(KernelDot(a.Slice(0, n), b.Slice(0, n)));
+	}
+
+#pragma endregion
+
+
+}	// namespace Def
+
+
+	using Def::SimdLevel;
+
+}	// namespace Enumerables
+
+
+#endif	// ENUMERABLES_SIMD_HPP
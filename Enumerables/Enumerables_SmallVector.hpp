@@ -0,0 +1,430 @@
+#ifndef ENUMERABLES_SMALLVECTOR_HPP
+#define ENUMERABLES_SMALLVECTOR_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the default SmallList type - bound by Enumerables_ConfigDefaults.hpp:	  *
+	 *		- SmallVector:	contiguous list keeping its first N elements inline, then heap-allocated  *
+	 *																								  *
+	 *  Included by Enumerables_ConfigDefaults.hpp - not to be used directly.						  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	/// Contiguous list with room for @p N elements inline: stays allocation-free until exceeding that.
+	/// Interface follows std::vector (as far as the library and usual clients need it).
+	/// @remarks
+	///		Unlike std::vector, moving an inline instance moves its elements one by one (invalidating iterators).
+	///		Growth beyond N moves the elements to a buffer of the allocator - and they stay there until destruction.
+	template <class T, size_t N, class Alloc = std::allocator<T>>
+	class SmallVector {
+		using Traits = std::allocator_traits<Alloc>;
+
+		static_assert (std::is_same<typename Traits::value_type, T>::value, "Allocator of SmallVector must allocate T.");
+
+		static constexpr size_t InlineCapacity = N > 0 ? N : 1;
+
+		// Allocator gets empty-base optimized
+		struct Storage : Alloc {
+			T*		first;
+			size_t	count;
+			size_t	capacity;
+
+			Storage(const Alloc& alloc, T* inlineFirst) : Alloc { alloc }, first { inlineFirst }, count { 0 }, capacity { N }
+			{
+			}
+
+			Alloc&			Allocator()			{ return *this; }
+			const Alloc&	Allocator() const	{ return *this; }
+		};
+
+		Storage		storage;
+		alignas(T)	unsigned char	inlineBytes[InlineCapacity * sizeof(T)];
+
+
+		T*		InlineFirst()			{ return reinterpret_cast<T*>(inlineBytes); }
+		bool	IsInline()		const	{ return storage.first == reinterpret_cast<const T*>(inlineBytes); }
+
+
+		void	DestroyAll()
+		{
+			for (size_t i = 0; i < storage.count; ++i)
+				Traits::destroy(storage.Allocator(), storage.first + i);
+			storage.count = 0;
+		}
+
+		void	ReleaseBuffer()
+		{
+			if (!IsInline())
+				Traits::deallocate(storage.Allocator(), storage.first, storage.capacity);
+
+			storage.first	 = InlineFirst();
+			storage.capacity = N;
+		}
+
+		/// Move the elements into @p buffer of @p capacity, which replaces the current one.
+		void	Adopt(T* buffer, size_t capacity)
+		{
+			Alloc&	alloc = storage.Allocator();
+			size_t	moved = 0;
+			try {
+				for (; moved < storage.count; ++moved)
+					Traits::construct(alloc, buffer + moved, std::move_if_noexcept(storage.first[moved]));
+			}
+			catch (...) {
+				for (size_t i = 0; i < moved; ++i)
+					Traits::destroy(alloc, buffer + i);
+				throw;
+			}
+
+			DestroyAll();
+			ReleaseBuffer();
+			storage.first	 = buffer;
+			storage.count	 = moved;
+			storage.capacity = capacity;
+		}
+
+		void	Reallocate(size_t capacity)
+		{
+			T* buffer = Traits::allocate(storage.Allocator(), capacity);
+			try {
+				Adopt(buffer, capacity);
+			}
+			catch (...) {
+				Traits::deallocate(storage.Allocator(), buffer, capacity);
+				throw;
+			}
+		}
+
+		/// Grow, constructing the new last element from @p args first - they may refer to an old element.
+		template <class... Args>
+		void	ReallocateEmplacing(Args&&... args)
+		{
+			Alloc&		 alloc	  = storage.Allocator();
+			const size_t capacity = GrownCapacity(storage.count + 1);
+			const size_t index	  = storage.count;
+			T*			 buffer	  = Traits::allocate(alloc, capacity);
+			try {
+				Traits::construct(alloc, buffer + index, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				Traits::deallocate(alloc, buffer, capacity);
+				throw;
+			}
+			try {
+				Adopt(buffer, capacity);
+			}
+			catch (...) {
+				Traits::destroy(alloc, buffer + index);
+				Traits::deallocate(alloc, buffer, capacity);
+				throw;
+			}
+			++storage.count;
+		}
+
+		size_t	GrownCapacity(size_t required) const
+		{
+			return (std::max)(required, 2 * storage.capacity);
+		}
+
+		/// Take the contents of @p src: its buffer if allocated, or its inline elements one by one.
+		void	TakeContents(SmallVector& src)
+		{
+			if (src.IsInline()) {
+				for (T* p = src.storage.first; p != src.storage.first + src.storage.count; ++p)
+					emplace_back(std::move(*p));
+				src.DestroyAll();
+			}
+			else {
+				storage.first	 = src.storage.first;
+				storage.count	 = src.storage.count;
+				storage.capacity = src.storage.capacity;
+
+				src.storage.first	 = src.InlineFirst();
+				src.storage.count	 = 0;
+				src.storage.capacity = N;
+			}
+		}
+
+		void	PropagateAllocator(const SmallVector& src, std::true_type)	{ storage.Allocator() = src.storage.Allocator(); }
+		void	PropagateAllocator(const SmallVector&,	   std::false_type)	{}
+
+		template <class It>
+		void	AppendRange(It first, It last, std::input_iterator_tag)
+		{
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+
+		template <class It>
+		void	AppendRange(It first, It last, std::forward_iterator_tag)
+		{
+			reserve(storage.count + static_cast<size_t>(std::distance(first, last)));
+			for (; first != last; ++first) {
+				Traits::construct(storage.Allocator(), storage.first + storage.count, *first);
+				++storage.count;
+			}
+		}
+
+	public:
+		using value_type			 = T;
+		using allocator_type		 = Alloc;
+		using size_type				 = size_t;
+		using difference_type		 = std::ptrdiff_t;
+		using reference				 = T&;
+		using const_reference		 = const T&;
+		using pointer				 = T*;
+		using const_pointer			 = const T*;
+		using iterator				 = T*;
+		using const_iterator		 = const T*;
+		using reverse_iterator		 = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+		SmallVector() : SmallVector(Alloc {})
+		{
+		}
+
+		explicit SmallVector(const Alloc& alloc) : storage { alloc, InlineFirst() }
+		{
+		}
+
+		SmallVector(std::initializer_list<T> init, const Alloc& alloc = Alloc {}) : SmallVector(alloc)
+		{
+			AppendRange(init.begin(), init.end(), std::forward_iterator_tag {});
+		}
+
+		template <class It, class = typename std::iterator_traits<It>::iterator_category>
+		SmallVector(It first, It last, const Alloc& alloc = Alloc {}) : SmallVector(alloc)
+		{
+			AppendRange(first, last, typename std::iterator_traits<It>::iterator_category {});
+		}
+
+		SmallVector(const SmallVector& src) : SmallVector(Traits::select_on_container_copy_construction(src.get_allocator()))
+		{
+			AppendRange(src.begin(), src.end(), std::forward_iterator_tag {});
+		}
+
+		SmallVector(SmallVector&& src) noexcept(std::is_nothrow_move_constructible<T>::value)
+			: SmallVector(src.get_allocator())
+		{
+			TakeContents(src);
+		}
+
+		~SmallVector()
+		{
+			DestroyAll();
+			ReleaseBuffer();
+		}
+
+
+		SmallVector&	operator =(const SmallVector& rhs)
+		{
+			if (this != &rhs) {
+				clear();
+				AppendRange(rhs.begin(), rhs.end(), std::forward_iterator_tag {});
+			}
+			return *this;
+		}
+
+		SmallVector&	operator =(SmallVector&& rhs)
+		{
+			if (this == &rhs)
+				return *this;
+
+			DestroyAll();
+			if (Traits::propagate_on_container_move_assignment::value || storage.Allocator() == rhs.storage.Allocator()) {
+				ReleaseBuffer();
+				PropagateAllocator(rhs, typename Traits::propagate_on_container_move_assignment {});
+				TakeContents(rhs);
+			}
+			else {
+				// keep own allocator: elements get moved one by one
+				for (T& e : rhs)
+					emplace_back(std::move(e));
+				rhs.clear();
+			}
+			return *this;
+		}
+
+		SmallVector&	operator =(std::initializer_list<T> init)
+		{
+			clear();
+			AppendRange(init.begin(), init.end(), std::forward_iterator_tag {});
+			return *this;
+		}
+
+
+		allocator_type	get_allocator()	const	{ return storage.Allocator(); }
+
+		iterator		begin()					{ return storage.first; }
+		iterator		end()					{ return storage.first + storage.count; }
+		const_iterator	begin()			const	{ return storage.first; }
+		const_iterator	end()			const	{ return storage.first + storage.count; }
+		const_iterator	cbegin()		const	{ return begin(); }
+		const_iterator	cend()			const	{ return end(); }
+
+		reverse_iterator		rbegin()		{ return reverse_iterator { end() }; }
+		reverse_iterator		rend()			{ return reverse_iterator { begin() }; }
+		const_reverse_iterator	rbegin() const	{ return const_reverse_iterator { end() }; }
+		const_reverse_iterator	rend()	 const	{ return const_reverse_iterator { begin() }; }
+
+		T*				data()					{ return storage.first; }
+		const T*		data()			const	{ return storage.first; }
+		size_t			size()			const	{ return storage.count; }
+		size_t			capacity()		const	{ return storage.capacity; }
+		bool			empty()			const	{ return storage.count == 0; }
+		size_t			max_size()		const	{ return Traits::max_size(storage.Allocator()); }
+
+		T&				operator [](size_t i)		{ return storage.first[i]; }
+		const T&		operator [](size_t i) const	{ return storage.first[i]; }
+		T&				front()						{ return storage.first[0]; }
+		const T&		front()				  const	{ return storage.first[0]; }
+		T&				back()						{ return storage.first[storage.count - 1]; }
+		const T&		back()				  const	{ return storage.first[storage.count - 1]; }
+
+		T&				at(size_t i)
+		{
+			if (i >= storage.count)
+				throw std::out_of_range("SmallVector index out of range.");
+			return storage.first[i];
+		}
+
+		const T&		at(size_t i) const
+		{
+			return const_cast<SmallVector&>(*this).at(i);
+		}
+
+
+		void	reserve(size_t capacity)
+		{
+			if (capacity > storage.capacity)
+				Reallocate(capacity);
+		}
+
+		template <class... Args>
+		T&		emplace_back(Args&&... args)
+		{
+			if (storage.count == storage.capacity)
+				ReallocateEmplacing(std::forward<Args>(args)...);
+			else {
+				Traits::construct(storage.Allocator(), storage.first + storage.count, std::forward<Args>(args)...);
+				++storage.count;				// only once constructed: a throwing ctor leaves the size intact
+			}
+
+			return back();
+		}
+
+		void	push_back(const T& value)	{ emplace_back(value); }
+		void	push_back(T&& value)		{ emplace_back(std::move(value)); }
+
+		void	pop_back()
+		{
+			Traits::destroy(storage.Allocator(), storage.first + --storage.count);
+		}
+
+		/// Destroy all elements, keeping capacity.
+		void	clear()
+		{
+			DestroyAll();
+		}
+
+		void	resize(size_t count)
+		{
+			while (storage.count > count)
+				pop_back();
+
+			reserve(count);
+			while (storage.count < count)
+				emplace_back();
+		}
+
+		void	resize(size_t count, const T& value)
+		{
+			while (storage.count > count)
+				pop_back();
+
+			// value may be an element: growth by emplace_back keeps it valid
+			while (storage.count < count)
+				emplace_back(value);
+		}
+
+
+		template <class It, class = typename std::iterator_traits<It>::iterator_category>
+		iterator	insert(const_iterator pos, It first, It last)
+		{
+			const size_t index = static_cast<size_t>(pos - begin());
+			const size_t count = storage.count;
+			AppendRange(first, last, typename std::iterator_traits<It>::iterator_category {});
+
+			std::rotate(begin() + index, begin() + count, end());
+			return begin() + index;
+		}
+
+		iterator	insert(const_iterator pos, const T& value)
+		{
+			const size_t index = static_cast<size_t>(pos - begin());
+			emplace_back(value);
+
+			std::rotate(begin() + index, end() - 1, end());
+			return begin() + index;
+		}
+
+		iterator	erase(const_iterator first, const_iterator last)
+		{
+			iterator trgFirst = begin() + (first - begin());
+			iterator removed  = std::move(begin() + (last - begin()), end(), trgFirst);
+			while (end() != removed)
+				pop_back();
+
+			return trgFirst;
+		}
+
+		iterator	erase(const_iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+
+		friend void	swap(SmallVector& lhs, SmallVector& rhs)
+		{
+			SmallVector tmp = std::move(lhs);
+			lhs = std::move(rhs);
+			rhs = std::move(tmp);
+		}
+
+		friend bool	operator ==(const SmallVector& lhs, const SmallVector& rhs)
+		{
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+
+		friend bool	operator !=(const SmallVector& lhs, const SmallVector& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+
+
+}	// namespace Def
+
+
+using Def::SmallVector;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_SMALLVECTOR_HPP
@@ -0,0 +1,831 @@
+#ifndef ENUMERABLES_SORTEDFLATMAP_HPP
+#define ENUMERABLES_SORTEDFLATMAP_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains contiguous dictionaries for small, read-mostly results,					  *
+	 *  selectable by the FlatBinding of Enumerables_ConfigDefaults.hpp:							  *
+	 *		- SortedFlatMap:	key-value pairs in a sorted array, found by binary search			  *
+	 *		- AdaptiveMap:		a SortedFlatMap up to ENUMERABLES_SORTED_DICTIONARY_MAX elements,	  *
+	 *							a FlatHashMap beyond that											  *
+	 *																								  *
+	 *  Both can be filled by append_unsorted() calls, then sorted at once by sort_appended().		  *
+	 *  Included by Enumerables_ConfigDefaults.hpp - not to be used directly.						  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include "Enumerables_FlatHash.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	/// Dictionary of key-value pairs stored contiguously, sorted by key.
+	/// Interface follows std::map (as far as the library and usual clients need it), with C++14 heterogeneous lookup.
+	/// @remarks
+	///		Insertion by try_emplace or operator[] shifts the subsequent elements: meant for building by
+	///		append_unsorted() calls, then sort_appended() once - which keeps the first of equal keys.
+	///		Lookups remain correct meanwhile: appended elements are searched linearly until sorted,
+	///		though size() and iteration include appended duplicates too.
+	///		Any insertion or erasure invalidates iterators and references to subsequent elements - or all on growth.
+	template <class K, class V, class Less = std::less<K>, class Alloc = std::allocator<std::pair<const K, V>>>
+	class SortedFlatMap {
+	public:
+		using key_type			= K;
+		using mapped_type		= V;
+		using value_type		= std::pair<const K, V>;
+		using size_type			= size_t;
+		using difference_type	= std::ptrdiff_t;
+		using key_compare		= Less;
+		using allocator_type	= Alloc;
+		using reference			= value_type&;
+		using const_reference	= const value_type&;
+		using iterator			= value_type*;
+		using const_iterator	= const value_type*;
+
+	private:
+		using Traits		= std::allocator_traits<Alloc>;
+		using IndexAlloc	= typename Traits::template rebind_alloc<size_t>;
+		using IndexTraits	= std::allocator_traits<IndexAlloc>;
+		using Relocator		= FlatHashDetails::MapPolicy<K, V>;
+
+		static_assert (std::is_same<typename Traits::value_type, value_type>::value, "Allocator of SortedFlatMap must allocate its value_type.");
+
+		// Allocator gets empty-base optimized
+		struct Storage : Alloc {
+			value_type*	first		= nullptr;
+			size_t		count		= 0;
+			size_t		capacity	= 0;
+			size_t		sortedCount	= 0;		// elements before are sorted and unique, the rest are appended
+
+			explicit Storage(const Alloc& alloc) : Alloc { alloc }
+			{
+			}
+
+			Alloc&			Allocator()			{ return *this; }
+			const Alloc&	Allocator() const	{ return *this; }
+		};
+
+		Storage	storage;
+		Less	less;
+
+
+		/// Branchless binary search among the sorted elements.
+		template <class Key>
+		const value_type*	LowerBound(const Key& key) const
+		{
+			const value_type* base = storage.first;
+			size_t			  n	   = storage.sortedCount;
+			while (n > 1) {
+				const size_t half = n / 2;
+				base = less(base[half - 1].first, key) ? base + half : base;
+				n   -= half;
+			}
+			return base + (n == 1 && less(base->first, key));
+		}
+
+		template <class Key>
+		bool				Equivalent(const K& stored, const Key& key) const
+		{
+			return !less(stored, key) && !less(key, stored);
+		}
+
+		/// Index of @p key - or size() if not contained.
+		template <class Key>
+		size_t				FindIndex(const Key& key) const
+		{
+			const value_type* bound = LowerBound(key);
+			if (bound != storage.first + storage.sortedCount && !less(key, bound->first))
+				return static_cast<size_t>(bound - storage.first);
+
+			for (size_t i = storage.sortedCount; i < storage.count; ++i) {
+				if (Equivalent(storage.first[i].first, key))
+					return i;
+			}
+			return storage.count;
+		}
+
+
+		void	DestroyAll()
+		{
+			for (size_t i = 0; i < storage.count; ++i)
+				Traits::destroy(storage.Allocator(), storage.first + i);
+
+			storage.count		= 0;
+			storage.sortedCount	= 0;
+		}
+
+		void	ReleaseAll()
+		{
+			DestroyAll();
+			if (storage.first != nullptr)
+				Traits::deallocate(storage.Allocator(), storage.first, storage.capacity);
+
+			storage.first	 = nullptr;
+			storage.capacity = 0;
+		}
+
+		/// Relocate the elements into @p buffer of @p capacity, which replaces the current one.
+		void	Adopt(value_type* buffer, size_t capacity)
+		{
+			Alloc&	alloc = storage.Allocator();
+			size_t	moved = 0;
+			try {
+				for (; moved < storage.count; ++moved)
+					Relocator::Relocate(alloc, buffer + moved, storage.first[moved]);
+			}
+			catch (...) {
+				for (size_t i = 0; i < moved; ++i)
+					Traits::destroy(alloc, buffer + i);
+				throw;
+			}
+
+			const size_t sorted = storage.sortedCount;
+			ReleaseAll();
+			storage.first		= buffer;
+			storage.count		= moved;
+			storage.capacity	= capacity;
+			storage.sortedCount	= sorted;
+		}
+
+		void	Reallocate(size_t capacity)
+		{
+			value_type* buffer = Traits::allocate(storage.Allocator(), capacity);
+			try {
+				Adopt(buffer, capacity);
+			}
+			catch (...) {
+				Traits::deallocate(storage.Allocator(), buffer, capacity);
+				throw;
+			}
+		}
+
+		/// Append without ordering - @p args may refer to an element, hence constructed first on growth.
+		template <class... Args>
+		void	EmplaceBack(Args&&... args)
+		{
+			Alloc& alloc = storage.Allocator();
+			if (storage.count < storage.capacity) {
+				Traits::construct(alloc, storage.first + storage.count, std::forward<Args>(args)...);
+				++storage.count;
+				return;
+			}
+
+			alignas(value_type) unsigned char	bytes[sizeof(value_type)];
+			value_type*							pending = reinterpret_cast<value_type*>(bytes);
+
+			Traits::construct(alloc, pending, std::forward<Args>(args)...);
+			try {
+				Reallocate((std::max)(size_t(8), 2 * storage.capacity));
+				Relocator::Relocate(alloc, storage.first + storage.count, *pending);
+			}
+			catch (...) {
+				Traits::destroy(alloc, pending);
+				throw;
+			}
+			Traits::destroy(alloc, pending);
+			++storage.count;
+		}
+
+		/// Insert at the sorted position @p pos - expects no appended elements.
+		template <class... Args>
+		iterator	EmplaceAt(size_t pos, Args&&... args)
+		{
+			EmplaceBack(std::forward<Args>(args)...);
+
+			// rotate the new last element into pos
+			Alloc&		 alloc = storage.Allocator();
+			value_type*	 first = storage.first;
+			const size_t last  = storage.count - 1;
+			if (pos < last) {
+				alignas(value_type) unsigned char	bytes[sizeof(value_type)];
+				value_type*							inserted = reinterpret_cast<value_type*>(bytes);
+
+				Relocator::Relocate(alloc, inserted, first[last]);
+				Traits::destroy(alloc, first + last);
+				for (size_t i = last; i > pos; --i) {
+					Relocator::Relocate(alloc, first + i, first[i - 1]);
+					Traits::destroy(alloc, first + i - 1);
+				}
+				Relocator::Relocate(alloc, first + pos, *inserted);
+				Traits::destroy(alloc, inserted);
+			}
+			storage.sortedCount = storage.count;
+			return first + pos;
+		}
+
+		template <class Key, class... Args>
+		std::pair<iterator, bool>	TryEmplace(Key&& key, Args&&... args)
+		{
+			sort_appended();
+
+			const size_t pos = static_cast<size_t>(LowerBound(key) - storage.first);
+			if (pos < storage.count && !less(key, storage.first[pos].first))
+				return { storage.first + pos, false };
+
+			iterator inserted = EmplaceAt(pos, std::piecewise_construct, std::forward_as_tuple(std::forward<Key>(key)),
+																		 std::forward_as_tuple(std::forward<Args>(args)...));
+			return { inserted, true };
+		}
+
+		/// Take the buffer of @p src - allocated by an allocator equal to this one's.
+		void	TakeContents(SortedFlatMap& src)
+		{
+			storage.first		= src.storage.first;
+			storage.count		= src.storage.count;
+			storage.capacity	= src.storage.capacity;
+			storage.sortedCount	= src.storage.sortedCount;
+
+			src.storage.first		= nullptr;
+			src.storage.count		= 0;
+			src.storage.capacity	= 0;
+			src.storage.sortedCount	= 0;
+		}
+
+		void	AppendAll(const SortedFlatMap& src)
+		{
+			reserve(storage.count + src.size());
+			for (const value_type& e : src)
+				EmplaceBack(e);
+			storage.sortedCount = src.storage.sortedCount;
+		}
+
+		void	PropagateAllocator(const SortedFlatMap& src, std::true_type)	{ storage.Allocator() = src.storage.Allocator(); }
+		void	PropagateAllocator(const SortedFlatMap&,	 std::false_type)	{}
+
+		void	SwapAllocator(SortedFlatMap& other, std::true_type)				{ using std::swap; swap(storage.Allocator(), other.storage.Allocator()); }
+		void	SwapAllocator(SortedFlatMap&,		std::false_type)			{}
+
+		template <class Key>
+		using TransparentKey = std::enable_if_t<FlatHashDetails::IsTransparent<Less>::value && !std::is_same<Key, K>::value>;
+
+	public:
+		SortedFlatMap() : SortedFlatMap(Less {}, Alloc {})
+		{
+		}
+
+		explicit SortedFlatMap(const Alloc& alloc) : SortedFlatMap(Less {}, alloc)
+		{
+		}
+
+		explicit SortedFlatMap(const Less& less, const Alloc& alloc = Alloc {}) : storage { alloc }, less { less }
+		{
+		}
+
+		SortedFlatMap(std::initializer_list<value_type> init, const Less& less = Less {}, const Alloc& alloc = Alloc {}) : SortedFlatMap(less, alloc)
+		{
+			insert(init.begin(), init.end());
+		}
+
+		template <class It, class = typename std::iterator_traits<It>::iterator_category>
+		SortedFlatMap(It first, It last, const Less& less = Less {}, const Alloc& alloc = Alloc {}) : SortedFlatMap(less, alloc)
+		{
+			insert(first, last);
+		}
+
+		SortedFlatMap(const SortedFlatMap& src, const Alloc& alloc) : SortedFlatMap(src.less, alloc)
+		{
+			AppendAll(src);
+		}
+
+		SortedFlatMap(const SortedFlatMap& src) : SortedFlatMap(src, Traits::select_on_container_copy_construction(src.get_allocator()))
+		{
+		}
+
+		SortedFlatMap(SortedFlatMap&& src) noexcept : storage { src.storage.Allocator() }, less { src.less }
+		{
+			TakeContents(src);
+		}
+
+		~SortedFlatMap()
+		{
+			ReleaseAll();
+		}
+
+
+		SortedFlatMap&	operator =(const SortedFlatMap& rhs)
+		{
+			if (this == &rhs)
+				return *this;
+
+			constexpr bool propagate = Traits::propagate_on_container_copy_assignment::value;
+
+			SortedFlatMap copy (rhs, propagate ? rhs.get_allocator() : get_allocator());
+			ReleaseAll();
+			PropagateAllocator(rhs, typename Traits::propagate_on_container_copy_assignment {});
+			less = rhs.less;
+			TakeContents(copy);
+			return *this;
+		}
+
+		SortedFlatMap&	operator =(SortedFlatMap&& rhs)
+		{
+			if (this == &rhs)
+				return *this;
+
+			ReleaseAll();
+			less = rhs.less;
+			if (Traits::propagate_on_container_move_assignment::value || storage.Allocator() == rhs.storage.Allocator()) {
+				PropagateAllocator(rhs, typename Traits::propagate_on_container_move_assignment {});
+				TakeContents(rhs);
+			}
+			else {
+				// keep own allocator: elements get moved one by one
+				reserve(rhs.size());
+				for (value_type& e : rhs)
+					Relocator::Relocate(storage.Allocator(), storage.first + storage.count++, e);
+				storage.sortedCount = rhs.storage.sortedCount;
+				rhs.clear();
+			}
+			return *this;
+		}
+
+
+		allocator_type	get_allocator()	const	{ return storage.Allocator(); }
+		key_compare		key_comp()		const	{ return less; }
+
+		/// Iteration follows key order - only after sort_appended() if elements were appended.
+		iterator		begin()					{ return storage.first; }
+		iterator		end()					{ return storage.first + storage.count; }
+		const_iterator	begin()			const	{ return storage.first; }
+		const_iterator	end()			const	{ return storage.first + storage.count; }
+		const_iterator	cbegin()		const	{ return begin(); }
+		const_iterator	cend()			const	{ return end(); }
+
+		size_t			size()			const	{ return storage.count; }
+		bool			empty()			const	{ return storage.count == 0; }
+		size_t			capacity()		const	{ return storage.capacity; }
+		size_t			max_size()		const	{ return Traits::max_size(storage.Allocator()); }
+		bool			is_sorted()		const	{ return storage.sortedCount == storage.count; }
+
+
+		void	reserve(size_t capacity)
+		{
+			if (capacity > storage.capacity)
+				Reallocate(capacity);
+		}
+
+		/// Destroy all elements, keeping capacity.
+		void	clear()
+		{
+			DestroyAll();
+		}
+
+
+		/// Add an element without ordering or checking its key: it gets sorted by sort_appended() or the next insertion.
+		template <class... Args>
+		void	append_unsorted(Args&&... args)
+		{
+			EmplaceBack(std::forward<Args>(args)...);
+		}
+
+		/// Sort all appended elements at once, keeping only the first one of each key.
+		void	sort_appended()
+		{
+			if (storage.sortedCount == storage.count)
+				return;
+
+			// typical for enumerations of ordered sources: nothing to do
+			value_type* first	  = storage.first;
+			size_t		ascending = (std::max)(storage.sortedCount, size_t(1));
+			while (ascending < storage.count && less(first[ascending - 1].first, first[ascending].first))
+				++ascending;
+
+			if (ascending == storage.count) {
+				storage.sortedCount = storage.count;
+				return;
+			}
+
+			// otherwise sort indices - earlier ones first among equal keys - then relocate in that order
+			Alloc&		alloc = storage.Allocator();
+			IndexAlloc	indexAlloc { alloc };
+			size_t*		order = IndexTraits::allocate(indexAlloc, storage.count);
+			value_type*	buffer;
+			try {
+				buffer = Traits::allocate(alloc, storage.capacity);
+			}
+			catch (...) {
+				IndexTraits::deallocate(indexAlloc, order, storage.count);
+				throw;
+			}
+
+			size_t kept = 0;
+			try {
+				for (size_t i = 0; i < storage.count; ++i)
+					order[i] = i;
+
+				std::sort(order, order + storage.count, [this, first](size_t l, size_t r) {
+					return less(first[l].first, first[r].first) || (!less(first[r].first, first[l].first) && l < r);
+				});
+
+				for (size_t i = 0; i < storage.count; ++i) {
+					value_type& elem = first[order[i]];
+					if (kept == 0 || less(buffer[kept - 1].first, elem.first)) {
+						Relocator::Relocate(alloc, buffer + kept, elem);
+						++kept;
+					}
+				}
+			}
+			catch (...) {
+				for (size_t i = 0; i < kept; ++i)
+					Traits::destroy(alloc, buffer + i);
+				Traits::deallocate(alloc, buffer, storage.capacity);
+				IndexTraits::deallocate(indexAlloc, order, storage.count);
+				throw;
+			}
+			IndexTraits::deallocate(indexAlloc, order, storage.count);
+
+			const size_t capacity = storage.capacity;
+			ReleaseAll();
+			storage.first		= buffer;
+			storage.count		= kept;
+			storage.capacity	= capacity;
+			storage.sortedCount	= kept;
+		}
+
+
+		iterator		find(const K& key)				{ return storage.first + FindIndex(key); }
+		const_iterator	find(const K& key)		const	{ return storage.first + FindIndex(key); }
+		bool			contains(const K& key)	const	{ return FindIndex(key) != storage.count; }
+		size_t			count(const K& key)		const	{ return contains(key) ? 1 : 0; }
+
+		/// Heterogeneous lookup: only if Less declares is_transparent.
+		template <class Key, class = TransparentKey<Key>>
+		iterator		find(const Key& key)			{ return storage.first + FindIndex(key); }
+		template <class Key, class = TransparentKey<Key>>
+		const_iterator	find(const Key& key)	const	{ return storage.first + FindIndex(key); }
+		template <class Key, class = TransparentKey<Key>>
+		bool			contains(const Key& key) const	{ return FindIndex(key) != storage.count; }
+		template <class Key, class = TransparentKey<Key>>
+		size_t			count(const Key& key)	const	{ return contains(key) ? 1 : 0; }
+
+
+		template <class... Args>
+		std::pair<iterator, bool>	try_emplace(const K& key, Args&&... args)	{ return TryEmplace(key, std::forward<Args>(args)...); }
+
+		template <class... Args>
+		std::pair<iterator, bool>	try_emplace(K&& key, Args&&... args)		{ return TryEmplace(std::move(key), std::forward<Args>(args)...); }
+
+		std::pair<iterator, bool>	insert(const value_type& value)				{ return TryEmplace(value.first, value.second); }
+
+		template <class It>
+		void	insert(It first, It last)
+		{
+			for (; first != last; ++first)
+				append_unsorted(*first);
+			sort_appended();
+		}
+
+
+		V&			operator [](const K& key)	{ return try_emplace(key).first->second; }
+		V&			operator [](K&& key)		{ return try_emplace(std::move(key)).first->second; }
+
+		V&			at(const K& key)
+		{
+			const size_t i = FindIndex(key);
+			if (i == storage.count)
+				throw std::out_of_range("SortedFlatMap has no such key.");
+			return storage.first[i].second;
+		}
+
+		const V&	at(const K& key) const
+		{
+			return const_cast<SortedFlatMap&>(*this).at(key);
+		}
+
+
+		iterator	erase(const_iterator pos)
+		{
+			Alloc&		 alloc = storage.Allocator();
+			const size_t i	   = static_cast<size_t>(pos - storage.first);
+			Traits::destroy(alloc, storage.first + i);
+			for (size_t j = i + 1; j < storage.count; ++j) {
+				Relocator::Relocate(alloc, storage.first + j - 1, storage.first[j]);
+				Traits::destroy(alloc, storage.first + j);
+			}
+			--storage.count;
+			if (i < storage.sortedCount)
+				--storage.sortedCount;
+
+			return storage.first + i;
+		}
+
+		size_t		erase(const K& key)
+		{
+			sort_appended();		// drops appended duplicates too
+
+			const size_t i = FindIndex(key);
+			if (i == storage.count)
+				return 0;
+
+			erase(storage.first + i);
+			return 1;
+		}
+
+
+		void	swap(SortedFlatMap& other)
+		{
+			using std::swap;
+			swap(storage.first,		  other.storage.first);
+			swap(storage.count,		  other.storage.count);
+			swap(storage.capacity,	  other.storage.capacity);
+			swap(storage.sortedCount, other.storage.sortedCount);
+			swap(less, other.less);
+			SwapAllocator(other, typename Traits::propagate_on_container_swap {});
+		}
+
+		friend void	swap(SortedFlatMap& lhs, SortedFlatMap& rhs)
+		{
+			lhs.swap(rhs);
+		}
+
+		friend bool	operator ==(const SortedFlatMap& lhs, const SortedFlatMap& rhs)
+		{
+			if (lhs.size() != rhs.size())
+				return false;
+
+			for (const value_type& e : lhs) {
+				const size_t i = rhs.FindIndex(e.first);
+				if (i == rhs.storage.count || !(rhs.storage.first[i].second == e.second))
+					return false;
+			}
+			return true;
+		}
+
+		friend bool	operator !=(const SortedFlatMap& lhs, const SortedFlatMap& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+
+
+
+	/// Dictionary choosing its representation by size: a SortedFlatMap up to ENUMERABLES_SORTED_DICTIONARY_MAX elements
+	/// (binary search over a compact array), a FlatHashMap beyond that (constant time lookups).
+	/// Interface follows std::unordered_map (as far as the library and usual clients need it).
+	/// @remarks
+	///		Keys have to support both std::less and Hash.
+	///		The choice is made by the capacity reserved, then by the number of distinct keys - once hashed, stays hashed.
+	template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>, class Alloc = std::allocator<std::pair<const K, V>>>
+	class AdaptiveMap {
+		using Sorted = SortedFlatMap<K, V, std::less<K>, Alloc>;
+		using Hashed = FlatHashMap<K, V, Hash, KeyEqual, Alloc>;
+
+		template <class Ref, class SortedIt, class HashedIt>
+		class Iterator {
+			friend class AdaptiveMap;
+			template <class, class, class>	friend class Iterator;
+
+			SortedIt	sortedIt {};
+			HashedIt	hashedIt {};
+			bool		isHashed = false;
+
+			explicit Iterator(SortedIt it) : sortedIt { it }
+			{
+			}
+
+			explicit Iterator(HashedIt it) : hashedIt { it }, isHashed { true }
+			{
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type		= std::pair<const K, V>;
+			using difference_type	= std::ptrdiff_t;
+			using reference			= Ref;
+			using pointer			= std::remove_reference_t<Ref>*;
+
+			Iterator() = default;
+
+			template <class R, class S, class H, class = std::enable_if_t<!std::is_same<R, Ref>::value && std::is_convertible<R, Ref>::value>>
+			Iterator(const Iterator<R, S, H>& src) : sortedIt { src.sortedIt }, hashedIt { src.hashedIt }, isHashed { src.isHashed }
+			{
+			}
+
+			reference	operator *()	const	{ return isHashed ? *hashedIt : *sortedIt; }
+			pointer		operator ->()	const	{ return &**this; }
+
+			Iterator&	operator ++()
+			{
+				if (isHashed)
+					++hashedIt;
+				else
+					++sortedIt;
+				return *this;
+			}
+
+			Iterator	operator ++(int)
+			{
+				Iterator prev = *this;
+				++*this;
+				return prev;
+			}
+
+			friend bool	operator ==(const Iterator& lhs, const Iterator& rhs)	{ return lhs.isHashed ? lhs.hashedIt == rhs.hashedIt : lhs.sortedIt == rhs.sortedIt; }
+			friend bool	operator !=(const Iterator& lhs, const Iterator& rhs)	{ return !(lhs == rhs); }
+		};
+
+	public:
+		using key_type			= K;
+		using mapped_type		= V;
+		using value_type		= std::pair<const K, V>;
+		using size_type			= size_t;
+		using difference_type	= std::ptrdiff_t;
+		using hasher			= Hash;
+		using key_equal			= KeyEqual;
+		using allocator_type	= Alloc;
+		using reference			= value_type&;
+		using const_reference	= const value_type&;
+		using iterator			= Iterator<value_type&,		  typename Sorted::iterator,	   typename Hashed::iterator>;
+		using const_iterator	= Iterator<const value_type&, typename Sorted::const_iterator, typename Hashed::const_iterator>;
+
+		static constexpr size_t SortedMax = ENUMERABLES_SORTED_DICTIONARY_MAX;
+
+	private:
+		Sorted	sorted;
+		Hashed	hashed;
+		bool	isHashed = false;
+
+
+		/// Move all elements to the hashed representation - earlier ones win among equal keys, as by sort_appended().
+		void	SwitchToHashed()
+		{
+			hashed.reserve(sorted.size() + 1);
+			for (value_type& e : sorted)
+				hashed.try_emplace(std::move(const_cast<K&>(e.first)), std::move(e.second));
+
+			sorted	 = Sorted { sorted.get_allocator() };
+			isHashed = true;
+		}
+
+		void	GrowTo(size_t count)
+		{
+			if (!isHashed && count > SortedMax)
+				SwitchToHashed();
+		}
+
+	public:
+		AdaptiveMap() : AdaptiveMap(0u)
+		{
+		}
+
+		explicit AdaptiveMap(size_t capacity, const Hash& hash = Hash {}, const KeyEqual& equal = KeyEqual {}, const Alloc& alloc = Alloc {})
+			: sorted { alloc }, hashed { 0u, hash, equal, alloc }
+		{
+			reserve(capacity);
+		}
+
+		AdaptiveMap(size_t capacity, const Alloc& alloc) : AdaptiveMap(capacity, Hash {}, KeyEqual {}, alloc)
+		{
+		}
+
+		AdaptiveMap(size_t capacity, const Hash& hash, const Alloc& alloc) : AdaptiveMap(capacity, hash, KeyEqual {}, alloc)
+		{
+		}
+
+		explicit AdaptiveMap(const Alloc& alloc) : AdaptiveMap(0u, Hash {}, KeyEqual {}, alloc)
+		{
+		}
+
+
+		allocator_type	get_allocator()	const	{ return sorted.get_allocator(); }
+		hasher			hash_function()	const	{ return hashed.hash_function(); }
+		key_equal		key_eq()		const	{ return hashed.key_eq(); }
+		bool			is_hashed()		const	{ return isHashed; }
+
+		iterator		begin()					{ return isHashed ? iterator { hashed.begin() } : iterator { sorted.begin() }; }
+		iterator		end()					{ return isHashed ? iterator { hashed.end() }	: iterator { sorted.end() }; }
+		const_iterator	begin()			const	{ return const_cast<AdaptiveMap&>(*this).begin(); }
+		const_iterator	end()			const	{ return const_cast<AdaptiveMap&>(*this).end(); }
+		const_iterator	cbegin()		const	{ return begin(); }
+		const_iterator	cend()			const	{ return end(); }
+
+		size_t			size()			const	{ return isHashed ? hashed.size()  : sorted.size(); }
+		bool			empty()			const	{ return isHashed ? hashed.empty() : sorted.empty(); }
+
+
+		void	reserve(size_t count)
+		{
+			GrowTo(count);
+			if (isHashed)
+				hashed.reserve(count);
+			else
+				sorted.reserve(count);
+		}
+
+		/// Destroy all elements, keeping the representation.
+		void	clear()
+		{
+			sorted.clear();
+			hashed.clear();
+		}
+
+
+		/// Add an element with no check for its key while sorted - see SortedFlatMap::append_unsorted.
+		/// Appended duplicates are dropped by sorting once twice the limit is reached, only then is switched to hashing.
+		template <class Kin, class Vin>
+		void	append_unsorted(Kin&& key, Vin&& value)
+		{
+			if (isHashed) {
+				hashed.try_emplace(std::forward<Kin>(key), std::forward<Vin>(value));
+			}
+			else {
+				sorted.append_unsorted(std::forward<Kin>(key), std::forward<Vin>(value));
+				if (sorted.size() > 2 * SortedMax)
+					sort_appended();
+			}
+		}
+
+		void	sort_appended()
+		{
+			if (!isHashed) {
+				sorted.sort_appended();
+				GrowTo(sorted.size());
+			}
+		}
+
+
+		iterator		find(const K& key)				{ return isHashed ? iterator { hashed.find(key) } : iterator { sorted.find(key) }; }
+		const_iterator	find(const K& key)		const	{ return const_cast<AdaptiveMap&>(*this).find(key); }
+		bool			contains(const K& key)	const	{ return isHashed ? hashed.contains(key) : sorted.contains(key); }
+		size_t			count(const K& key)		const	{ return contains(key) ? 1 : 0; }
+
+
+		template <class... Args>
+		std::pair<iterator, bool>	try_emplace(const K& key, Args&&... args)
+		{
+			GrowTo(size() + 1);
+			if (isHashed) {
+				auto res = hashed.try_emplace(key, std::forward<Args>(args)...);
+				return { iterator { res.first }, res.second };
+			}
+			auto res = sorted.try_emplace(key, std::forward<Args>(args)...);
+			return { iterator { res.first }, res.second };
+		}
+
+		template <class... Args>
+		std::pair<iterator, bool>	try_emplace(K&& key, Args&&... args)
+		{
+			GrowTo(size() + 1);
+			if (isHashed) {
+				auto res = hashed.try_emplace(std::move(key), std::forward<Args>(args)...);
+				return { iterator { res.first }, res.second };
+			}
+			auto res = sorted.try_emplace(std::move(key), std::forward<Args>(args)...);
+			return { iterator { res.first }, res.second };
+		}
+
+		std::pair<iterator, bool>	insert(const value_type& value)		{ return try_emplace(value.first, value.second); }
+
+
+		V&			operator [](const K& key)	{ return try_emplace(key).first->second; }
+		V&			operator [](K&& key)		{ return try_emplace(std::move(key)).first->second; }
+
+		V&			at(const K& key)			{ return isHashed ? hashed.at(key) : sorted.at(key); }
+		const V&	at(const K& key)	const	{ return isHashed ? hashed.at(key) : sorted.at(key); }
+
+		size_t		erase(const K& key)			{ return isHashed ? hashed.erase(key) : sorted.erase(key); }
+
+
+		friend bool	operator ==(const AdaptiveMap& lhs, const AdaptiveMap& rhs)
+		{
+			if (lhs.size() != rhs.size())
+				return false;
+
+			for (const value_type& e : lhs) {
+				const auto found = rhs.find(e.first);
+				if (found == rhs.end() || !(found->second == e.second))
+					return false;
+			}
+			return true;
+		}
+
+		friend bool	operator !=(const AdaptiveMap& lhs, const AdaptiveMap& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+
+
+}	// namespace Def
+
+
+using Def::SortedFlatMap;
+using Def::AdaptiveMap;
+
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_SORTEDFLATMAP_HPP
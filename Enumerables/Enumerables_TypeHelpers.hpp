@@ -439,6 +439,22 @@ namespace TypeHelpers {
 
 
 
+	// ==== Comparison by property ==================================================================
+
+	/// Compares objects by a property of them - unlike a lambda, recognizable by optimized algorithms.
+	template <class CP, class Prop>
+	struct PropertyComparator {
+		Prop prop;
+
+		// convention: Enumerators accept const-callables only
+		bool  operator ()(CP lhs, CP rhs) const
+		{
+			return prop(lhs) < prop(rhs);
+		}
+	};
+
+
+
 	// ==== Return type conversion ==================================================================
 
 	/// Applies a specific return type - forcing conversion.
@@ -0,0 +1,730 @@
+#ifndef ENUMERABLES_VECTORIZED_HPP
+#define ENUMERABLES_VECTORIZED_HPP
+
+	/*  --------------------------------------------------------------------------------------------  *
+	 *  Part of Enumerables for C++.																  *
+	 *																								  *
+	 *  This file contains the block-at-a-time evaluation behind AutoEnumerable::Vectorized().		  *
+	 *  Included by Enumerables_Implementation.hpp - not to be used directly.						  *
+	 *																								  *
+	 *  --------------------------------------------------------------------------------------------  *
+	 *	Concept:																					  *
+	 *		VectorizedEnumerable records Where and Select as a Pipeline of block stages, then		  *
+	 *		terminal operations pull RowBlocks of up to ENUMERABLES_VECTORIZED_BLOCK rows through	  *
+	 *		the Cursors opened by the stages:														  *
+	 *			- sources provide a column:		viewed in place for contiguous ranges (and fields	  *
+	 *											of them), otherwise filled by enumerating the source  *
+	 *			- Where:						refines a selection vector of row indices, values	  *
+	 *											stay in place - simple predicates use Simd kernels	  *
+	 *			- Select of data members:		projects the column in place, keeping the selection	  *
+	 *			- Select otherwise:				maps the selected rows into a dense column			  *
+	 *		Terminal operations consume whole blocks, AsSequential() enumerates their rows.			  *
+	 *  --------------------------------------------------------------------------------------------  */
+
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+
+namespace Enumerables {
+namespace Def {
+
+	using std::size_t;
+
+
+#pragma region Blocks
+
+	constexpr size_t	vectorizedBlock = ENUMERABLES_VECTORIZED_BLOCK;
+
+	/// Index of a row within a block.
+	using BlockRow = std::uint16_t;
+
+	static_assert (vectorizedBlock > 0 && vectorizedBlock <= 65536, "ENUMERABLES_VECTORIZED_BLOCK must fit selection vectors.");
+
+
+	/// Rows of a column, some of them selected.
+	template <class T>
+	struct RowBlock {
+		StridedSpan<T>	column;
+		const BlockRow*	selection;		// ascending indices of the selected rows, nullptr: all rows of column are selected
+		size_t			count;			// of selected rows
+
+		size_t		Row(size_t i)			const	{ return selection != nullptr ? selection[i] : i; }
+		const T&	operator [](size_t i)	const	{ return column[Row(i)]; }
+	};
+
+
+	/// Calls @p f with an accessor of the i-th selected row - instantiated separately for selected, contiguous and strided blocks.
+	template <class T, class F>
+	decltype(auto)	WithRows(const RowBlock<T>& block, F&& f)
+	{
+		if (block.selection != nullptr) {
+			const BlockRow* selection = block.selection;
+			return f([&block, selection](size_t i) -> const T& { return block.column[selection[i]]; });
+		}
+		if (block.column.IsContiguous()) {
+			const T* values = &block.column[0];
+			return f([values](size_t i) -> const T& { return values[i]; });
+		}
+		return f([&block](size_t i) -> const T& { return block.column[i]; });
+	}
+
+
+	/// Dense column of values computed by a stage - assigned in place when trivial.
+	template <class T, bool = std::is_trivially_copyable<T>::value && std::is_trivially_default_constructible<T>::value>
+	class ColumnBuffer {
+		std::unique_ptr<T[]>	values { new T[vectorizedBlock] };
+		size_t					size = 0;
+
+	public:
+		StridedSpan<T>	Span()		const	{ return { reinterpret_cast<const char*>(values.get()), sizeof(T), size }; }
+		bool			IsFull()	const	{ return size == vectorizedBlock; }
+
+		void			Clear()			{ size = 0; }
+
+		template <class V>
+		void			Add(V&& value)	{ values[size++] = forward<V>(value); }
+
+		/// Replace contents by @p valueAt(i) for i < n.
+		template <class ValueAt>
+		StridedSpan<T>	Fill(size_t n, const ValueAt& valueAt)
+		{
+			T* out = values.get();
+			for (size_t i = 0; i < n; ++i)
+				out[i] = valueAt(i);
+
+			size = n;
+			return Span();
+		}
+	};
+
+
+	template <class T>
+	class ColumnBuffer<T, false> {
+		std::vector<T>	values;
+
+	public:
+		ColumnBuffer()					{ values.reserve(vectorizedBlock); }
+
+		StridedSpan<T>	Span()		const	{ return { reinterpret_cast<const char*>(values.data()), sizeof(T), values.size() }; }
+		bool			IsFull()	const	{ return values.size() == vectorizedBlock; }
+
+		void			Clear()			{ values.clear(); }
+
+		template <class V>
+		void			Add(V&& value)	{ values.emplace_back(forward<V>(value)); }
+
+		template <class ValueAt>
+		StridedSpan<T>	Fill(size_t n, const ValueAt& valueAt)
+		{
+			values.clear();
+			for (size_t i = 0; i < n; ++i)
+				values.emplace_back(valueAt(i));
+
+			return Span();
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region Cursors
+
+	// Cursors produce the blocks of a stage by pulling from their inner Cursor. They provide:
+	//		- TValue
+	//		- static constexpr bool inPlace		- rows refer to the memory of the source
+	//		- bool Next(RowBlock<TValue>&)		- false when exhausted, otherwise a block of at least 1 selected row
+	// Column of a dense block holds the selected rows only, hence selecting all of them keeps it dense.
+
+
+	/// Column blocks of a source query - filled by enumerating it.
+	template <class Source, class Etor = typename Source::TEnumerator, class = void>
+	class BlockSource {
+	public:
+		using TValue = decay_t<EnumeratedT<Etor>>;
+
+		static constexpr bool inPlace = false;
+
+	private:
+		Etor					etor;
+		ColumnBuffer<TValue>	column;
+		bool					exhausted = false;
+
+	public:
+		explicit BlockSource(const Source& source) : etor { source.GetEnumeratorNoDebug() }
+		{
+		}
+
+		bool	Next(RowBlock<TValue>& block)
+		{
+			column.Clear();
+			while (!exhausted && !column.IsFull()) {
+				if (etor.FetchNext())
+					column.Add(etor.Current());
+				else
+					exhausted = true;
+			}
+
+			block = { column.Span(), nullptr, column.Span().count };
+			return block.count > 0;
+		}
+	};
+
+
+	/// Column blocks of viewable sources - sliced in place.
+	template <class Source, class Etor>
+	class BlockSource<Source, Etor, void_t<typename StridedView<Etor>::TValue>> {
+	public:
+		using TValue = typename StridedView<Etor>::TValue;
+
+		static constexpr bool inPlace = true;
+
+	private:
+		Etor				etor;
+		StridedSpan<TValue>	values;
+		size_t				position = 0;
+
+	public:
+		explicit BlockSource(const Source& source) :
+			etor   { source.GetEnumeratorNoDebug() },
+			values { StridedView<Etor>::Get(etor) }
+		{
+		}
+
+		bool	Next(RowBlock<TValue>& block)
+		{
+			const size_t n = (std::min)(vectorizedBlock, values.count - position);
+			block = { values.Slice(position, n), nullptr, n };
+			position += n;
+			return n > 0;
+		}
+	};
+
+
+
+	template <class Pred, class T, class = void>
+	struct HasPredicateMask : std::false_type {};
+
+	template <class Pred, class T>
+	struct HasPredicateMask<Pred, T, void_t<decltype(&PredicateMask<Pred, T>::Mask)>> : std::true_type {};
+
+
+	/// Rows of @p block satisfying @p pred, written ascending to @p selection - by a branchless loop.
+	/// @returns	number of rows selected
+	template <class Pred, class T>
+	size_t	SelectEachRow(const Pred& pred, const RowBlock<T>& block, BlockRow* selection)
+	{
+		size_t n = 0;
+		if (block.selection != nullptr) {
+			for (size_t i = 0; i < block.count; ++i) {
+				const BlockRow row = block.selection[i];
+				selection[n] = row;
+				n += pred(block.column[row]) ? 1 : 0;
+			}
+		}
+		else {
+			for (size_t i = 0; i < block.count; ++i) {
+				selection[n] = static_cast<BlockRow>(i);
+				n += pred(block.column[i]) ? 1 : 0;
+			}
+		}
+		return n;
+	}
+
+
+	template <class Pred, class T, enable_if_t<!HasPredicateMask<Pred, T>::value, int> = 0>
+	size_t	SelectRows(const Pred& pred, const RowBlock<T>& block, BlockRow* selection)
+	{
+		return SelectEachRow(pred, block, selection);
+	}
+
+
+	// Simple predicates are evaluated for 64 rows of dense blocks at once.
+	template <class Pred, class T, enable_if_t<HasPredicateMask<Pred, T>::value, int> = 0>
+	size_t	SelectRows(const Pred& pred, const RowBlock<T>& block, BlockRow* selection)
+	{
+		if (block.selection != nullptr)
+			return SelectEachRow(pred, block, selection);
+
+		size_t n = 0;
+		for (size_t start = 0; start < block.count; start += 64) {
+			const auto	  part = block.column.Slice(start, (std::min)(size_t { 64 }, block.count - start));
+			const std::uint64_t mask = PredicateMask<Pred, T>::Mask(pred, part);
+			for (size_t i = 0; i < part.count; ++i) {
+				selection[n] = static_cast<BlockRow>(start + i);
+				n += (mask >> i) & 1;
+			}
+		}
+		return n;
+	}
+
+
+	/// Blocks of the rows satisfying a predicate - selected in place. Blocks without any are skipped.
+	template <class Inner, class Pred>
+	class FilterCursor {
+	public:
+		using TValue = typename Inner::TValue;
+
+		static constexpr bool inPlace = Inner::inPlace;
+
+	private:
+		Inner			inner;
+		Pred			pred;
+		BlockRow		selection[vectorizedBlock];
+
+	public:
+		FilterCursor(Inner&& inner, const Pred& pred) : inner { move(inner) }, pred { pred }
+		{
+		}
+
+		bool	Next(RowBlock<TValue>& block)
+		{
+			RowBlock<TValue> in;
+			while (inner.Next(in)) {
+				const size_t n = SelectRows(pred, in, selection);
+				if (n == in.column.count) {
+					block = { in.column, nullptr, n };		// kept dense for kernels
+					return true;
+				}
+				if (n > 0) {
+					block = { in.column, selection, n };
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+
+	/// Blocks of mapped values of the selected rows - computed into a dense column.
+	template <class Inner, class Mapper, class = void>
+	class SelectCursor {
+		using TInner = typename Inner::TValue;
+
+	public:
+		using TValue = decay_t<InvokeResultT<const Mapper&, const TInner&>>;
+
+		static constexpr bool inPlace = false;
+
+	private:
+		Inner					inner;
+		Mapper					map;
+		ColumnBuffer<TValue>	column;
+
+	public:
+		SelectCursor(Inner&& inner, const Mapper& map) : inner { move(inner) }, map { map }
+		{
+		}
+
+		bool	Next(RowBlock<TValue>& block)
+		{
+			RowBlock<TInner> in;
+			if (!inner.Next(in))
+				return false;
+
+			const auto mapped = WithRows(in, [this, &in](const auto& rowAt) {
+				return column.Fill(in.count, [this, &rowAt](size_t i) -> decltype(auto) { return map(rowAt(i)); });
+			});
+			block = { mapped, nullptr, in.count };
+			return true;
+		}
+	};
+
+
+	/// Blocks of data members of the selected rows - projected in place, keeping the selection.
+	template <class Inner, class Mapper>
+	class SelectCursor<Inner, Mapper, enable_if_t<is_same<typename FieldSelector<Mapper>::TOwner, typename Inner::TValue>::value>> {
+		using TInner = typename Inner::TValue;
+
+	public:
+		using TValue = std::remove_cv_t<typename FieldSelector<Mapper>::TField>;
+
+		static constexpr bool inPlace = Inner::inPlace;
+
+	private:
+		Inner			inner;
+		Mapper			map;
+
+	public:
+		SelectCursor(Inner&& inner, const Mapper& map) : inner { move(inner) }, map { map }
+		{
+		}
+
+		bool	Next(RowBlock<TValue>& block)
+		{
+			RowBlock<TInner> in;
+			if (!inner.Next(in))
+				return false;
+
+			block = { FieldSpan(in.column, FieldSelector<Mapper>::Member(map)), in.selection, in.count };
+			return true;
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region Pipeline
+
+	/// Stage of Where - opens a FilterCursor.
+	template <class Pred>
+	struct FilterStage {
+		Pred	pred;
+
+		template <class Inner>
+		FilterCursor<Inner, Pred>	operator ()(Inner&& inner) const	{ return { move(inner), pred }; }
+	};
+
+
+	/// Stage of Select - opens a SelectCursor.
+	template <class Mapper>
+	struct SelectStage {
+		Mapper	map;
+
+		template <class Inner>
+		SelectCursor<Inner, Mapper>	operator ()(Inner&& inner) const	{ return { move(inner), map }; }
+	};
+
+
+	/// Enumerates the selected rows of the blocks of a Cursor - the boundary back to element-wise evaluation.
+	/// @remarks	References rows of the source when in place, copies of them otherwise.
+	template <class Cursor>
+	class BlockRowEnumerator final : public IEnumerator<conditional_t<Cursor::inPlace, const typename Cursor::TValue&, typename Cursor::TValue>> {
+	public:
+		using typename BlockRowEnumerator::IEnumerator::TElem;
+
+	private:
+		using TValue = typename Cursor::TValue;
+
+		std::unique_ptr<Cursor>	cursor;			// stable for the selection of block
+		RowBlock<TValue>		block	{ { nullptr, sizeof(TValue), 0 }, nullptr, 0 };
+		size_t					next	= 0;	// index in block after the current row
+
+	public:
+		bool FetchNext() override
+		{
+			if (next < block.count) {
+				++next;
+				return true;
+			}
+			next = 1;
+			if (cursor->Next(block))
+				return true;
+
+			block.count = 0;
+			return false;
+		}
+
+
+		TElem Current() override
+		{
+			ENUMERABLES_ETOR_USAGE_ASSERT (0 < next && next <= block.count, NotFetchedError);
+			return block[next - 1];
+		}
+
+
+		SizeInfo Measure() const override
+		{
+			return { Boundedness::Unknown };
+		}
+
+
+		IEnumerator<TElem>*	MoveTo(void* mem) override
+		{
+			return MoveToAligned(mem, this);
+		}
+
+
+		explicit BlockRowEnumerator(Cursor&& cursor) : cursor { new Cursor { move(cursor) } }
+		{
+		}
+	};
+
+#pragma endregion
+
+
+
+#pragma region VectorizedEnumerable
+
+	/// Query over a source evaluated block-at-a-time by terminal operations.
+	/// @remarks
+	///		Only Where and Select can be chained, the rest of the
+	///		AutoEnumerable interface is available via AsSequential().
+	///		Callables receive const references, and each stage is invoked for a whole block
+	///		before the next one - so they must not rely on the interleaving of sequential evaluation.
+	template <class TSource, class TPipeline>
+	class VectorizedEnumerable {
+		template <class, class>	friend class VectorizedEnumerable;
+
+		using TSourceCursor = BlockSource<TSource>;
+		using TCursor		= decltype(declval<const TPipeline&>()(declval<TSourceCursor>()));
+
+		TSource		source;
+		TPipeline	pipeline;
+
+	public:
+		using TElemDecayed = typename TCursor::TValue;
+
+		/// Elements enumerated by AsSequential(): references for rows remaining in the memory of the source.
+		using TElem		   = conditional_t<TCursor::inPlace, const TElemDecayed&, TElemDecayed>;
+
+
+		VectorizedEnumerable(TSource&& source, TPipeline&& pipeline) :
+			source	 { move(source) },
+			pipeline { move(pipeline) }
+		{
+		}
+
+
+	private:
+		template <class Pred>
+		using PredicateT = BaseT<decltype(LambdaCreators::Predicate<const TElemDecayed&>(declval<Pred>()))>;
+
+		template <class S, class TSelected>
+		using SelectorT	 = LambdaCreators::SelectorT<const TElemDecayed&, S, TSelected>;
+
+
+		template <class Stage>
+		auto Then(Stage&& stage) const &
+		{
+			using Result = VectorizedEnumerable<TSource, ComposedStage<TPipeline, decay_t<Stage>>>;
+			return Result { TSource { source }, { pipeline, forward<Stage>(stage) } };
+		}
+
+		template <class Stage>
+		auto Then(Stage&& stage) &&
+		{
+			using Result = VectorizedEnumerable<TSource, ComposedStage<TPipeline, decay_t<Stage>>>;
+			return Result { move(source), { move(pipeline), forward<Stage>(stage) } };
+		}
+
+
+		/// Cursor of the final stage, with copies of the callables of this query.
+		TCursor	Open() const	{ return pipeline(TSourceCursor { source }); }
+
+
+	public:
+		// =========== Chaining block stages =========================================================================================
+
+		template <class Pred>
+		auto Where(Pred&& p) const &	{ return		   Then(FilterStage<PredicateT<Pred>> { LambdaCreators::Predicate<const TElemDecayed&>(forward<Pred>(p)) }); }
+		template <class Pred>
+		auto Where(Pred&& p) &&			{ return move(*this).Then(FilterStage<PredicateT<Pred>> { LambdaCreators::Predicate<const TElemDecayed&>(forward<Pred>(p)) }); }
+
+		template <class TSelected = void, class S>
+		auto Select(S&& s) const &		{ return		   Then(SelectStage<SelectorT<S, TSelected>> { LambdaCreators::Selector<const TElemDecayed&, TSelected>(forward<S>(s)) }); }
+		template <class TSelected = void, class S>
+		auto Select(S&& s) &&			{ return move(*this).Then(SelectStage<SelectorT<S, TSelected>> { LambdaCreators::Selector<const TElemDecayed&, TSelected>(forward<S>(s)) }); }
+
+
+		/// Continue as a regular AutoEnumerable, enumerating the rows of the blocks.
+		auto AsSequential() const &		{ return WrapFactory([query = *this]()		 { return BlockRowEnumerator<TCursor> { query.Open() }; }); }
+		auto AsSequential() &&			{ return WrapFactory([query = move(*this)]() { return BlockRowEnumerator<TCursor> { query.Open() }; }); }
+
+
+		// =========== Terminal operations ===========================================================================================
+
+		size_t	Count()	const;
+		bool	Any()	const;
+
+		template <class Comp = std::less<>>	Optional<TElemDecayed>	Min(const Comp& isLess = {}) const	{ return AsSequential().Min(isLess); }
+		template <class Comp = std::less<>>	Optional<TElemDecayed>	Max(const Comp& isLess = {}) const	{ return AsSequential().Max(isLess); }
+
+		/// Sum of elements - compensated for floating-point, dense blocks of arithmetic values summed by Simd kernels.
+		template <class S = TElemDecayed>	S						Sum() const;
+		template <class S = TElemDecayed>	Optional<S>				Avg() const;
+
+		/// Form a List, appending whole dense blocks at once.
+		template <class... Options>
+		ListType<TElemDecayed, Options...>	ToList()	const;
+	};
+
+
+
+	template <class TSource, class TPipeline>
+	size_t	VectorizedEnumerable<TSource, TPipeline>::Count() const
+	{
+		TCursor cursor = Open();
+
+		size_t					 count = 0;
+		RowBlock<TElemDecayed>	 block;
+		while (cursor.Next(block))
+			count += block.count;
+
+		return count;
+	}
+
+
+	template <class TSource, class TPipeline>
+	bool	VectorizedEnumerable<TSource, TPipeline>::Any() const
+	{
+		TCursor cursor = Open();
+
+		RowBlock<TElemDecayed> block;
+		return cursor.Next(block);
+	}
+
+
+
+	template <class S, class T, enable_if_t<HasSumKernel<S, T>::value, int> = 0>
+	void	AddBlock(CompensatedSum<S>& total, const RowBlock<T>& block)
+	{
+		if (block.selection == nullptr) {
+			const CompensatedSum<S> partial = KernelSum(block.column);
+			total.Add(partial.sum);
+			total.Add(partial.err);
+			return;
+		}
+		for (size_t i = 0; i < block.count; ++i)
+			total.Add(block.column[block.selection[i]]);
+	}
+
+
+	template <class S, class T, enable_if_t<!HasSumKernel<S, T>::value, int> = 0>
+	void	AddBlock(CompensatedSum<S>& total, const RowBlock<T>& block)
+	{
+		WithRows(block, [&total, &block](const auto& rowAt) {
+			for (size_t i = 0; i < block.count; ++i)
+				total.Add(static_cast<S>(rowAt(i)));
+		});
+	}
+
+
+	// integers as by KernelSum: modular sum of the values reinterpreted as signed
+	template <class T>
+	void	AddBlock(std::uint64_t& total, const RowBlock<T>& block)
+	{
+		using TKernel = KernelValueT<T>;
+
+		const auto column = block.column.template As<TKernel>();
+		if (block.selection == nullptr) {
+			total += KernelSum(column);
+			return;
+		}
+		for (size_t i = 0; i < block.count; ++i)
+			total += static_cast<std::uint64_t>(static_cast<std::int64_t>(column[block.selection[i]]));
+	}
+
+
+
+	template <class S, class Cursor, enable_if_t<std::is_floating_point<S>::value, int> = 0>
+	S	SumBlocks(Cursor& cursor)
+	{
+		CompensatedSum<S>					total;
+		RowBlock<typename Cursor::TValue>	block;
+		while (cursor.Next(block))
+			AddBlock(total, block);
+
+		return total.Total();
+	}
+
+
+	template <class S, class Cursor, enable_if_t<!std::is_floating_point<S>::value && HasSumKernel<S, typename Cursor::TValue>::value, int> = 0>
+	S	SumBlocks(Cursor& cursor)
+	{
+		std::uint64_t						total = 0;
+		RowBlock<typename Cursor::TValue>	block;
+		while (cursor.Next(block))
+			AddBlock(total, block);
+
+		return static_cast<S>(total);
+	}
+
+
+	template <class S, class Cursor, enable_if_t<!std::is_floating_point<S>::value && !HasSumKernel<S, typename Cursor::TValue>::value, int> = 0>
+	S	SumBlocks(Cursor& cursor)
+	{
+		S									sum {};
+		RowBlock<typename Cursor::TValue>	block;
+		while (cursor.Next(block)) {
+			WithRows(block, [&sum, &block](const auto& rowAt) {
+				for (size_t i = 0; i < block.count; ++i)
+					sum += rowAt(i);
+			});
+		}
+		return sum;
+	}
+
+
+	template <class TSource, class TPipeline>
+	template <class S>
+	S		VectorizedEnumerable<TSource, TPipeline>::Sum() const
+	{
+		TCursor cursor = Open();
+		return SumBlocks<S>(cursor);
+	}
+
+
+	template <class TSource, class TPipeline>
+	template <class S>
+	Optional<S>	VectorizedEnumerable<TSource, TPipeline>::Avg() const
+	{
+		static_assert (std::is_floating_point<S>::value, "Intended for floating-point operations.");
+
+		TCursor cursor = Open();
+
+		size_t					count = 0;
+		CompensatedSum<S>		total;
+		RowBlock<TElemDecayed>	block;
+		while (cursor.Next(block)) {
+			count += block.count;
+			AddBlock(total, block);
+		}
+		return CompensatedAverage(total, count);
+	}
+
+
+	template <class TSource, class TPipeline>
+	template <class... Options>
+	auto	VectorizedEnumerable<TSource, TPipeline>::ToList() const -> ListType<TElemDecayed, Options...>
+	{
+		using List = ListType<TElemDecayed, Options...>;
+
+		TCursor cursor = Open();
+
+		List					results = ListOperations::Init<List>(0, Options {}...);
+		RowBlock<TElemDecayed>	block;
+		while (cursor.Next(block)) {
+			if (block.selection == nullptr && block.column.IsContiguous()) {
+				const TElemDecayed* first = &block.column[0];
+				AddRange<ListOperations>(results, first, first + block.count);
+				continue;
+			}
+			WithRows(block, [&results, &block](const auto& rowAt) {
+				for (size_t i = 0; i < block.count; ++i)
+					ListOperations::Add(results, rowAt(i));
+			});
+		}
+		return results;
+	}
+
+#pragma endregion
+
+
+
+#pragma region Vectorized
+
+	template <class TFactory>
+	auto AutoEnumerable<TFactory>::Vectorized() const &
+	{
+		return VectorizedEnumerable<AutoEnumerable, IdentityStage> { AutoEnumerable { *this }, IdentityStage {} };
+	}
+
+
+	template <class TFactory>
+	auto AutoEnumerable<TFactory>::Vectorized() &&
+	{
+		return VectorizedEnumerable<AutoEnumerable, IdentityStage> { move(*this), IdentityStage {} };
+	}
+
+#pragma endregion
+
+}	// namespace Def
+}	// namespace Enumerables
+
+#endif	// ENUMERABLES_VECTORIZED_HPP
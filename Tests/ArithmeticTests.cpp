@@ -3,8 +3,12 @@
 #include "TestUtils.hpp"
 #include "Enumerables.hpp"
 #include <bitset>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <string>
 #include <memory>
+#include <vector>
 
 #ifdef __clang__
 #	pragma clang diagnostic ignored "-Wold-style-cast"
@@ -166,6 +170,290 @@ namespace EnumerableTests {
 
 
 
+	// Sum and Avg of contiguous sources run vectorized kernels - check each instruction set available.
+	static void VectorizedSummation()
+	{
+		using Enumerables::SimdLevel;
+		using Enumerables::Def::ActiveSimdLevel;
+
+		struct Record {
+			int		key;
+			double	value;
+		};
+
+		std::vector<int>		  ints;
+		std::vector<unsigned>	  unsigneds;
+		std::vector<long long>	  longs;
+		std::vector<float>		  floats;
+		std::vector<double>		  doubles;
+		std::vector<Record>		  records;
+		for (int i = 0; i < 1003; ++i) {
+			ints.push_back(i % 7 == 0 ? -i * 1000000 : i * 3000000);
+			unsigneds.push_back(4000000000u - static_cast<unsigned>(i));
+			longs.push_back((i % 2 ? -1ll : 1ll) << (i % 60));
+			floats.push_back(static_cast<float>(i % 13) * 0.1f);
+			doubles.push_back(i % 5 ? 0.1 * i : -1e10);
+			records.push_back({ i - 500, 1.0 / (i + 1) });
+		}
+
+		// opaque to the kernels
+		auto sequential = [](auto& v) { return Enumerate(v).Where(FUN(x, true)); };
+
+		const SimdLevel detected = ActiveSimdLevel();
+		for (SimdLevel level : { detected, SimdLevel::Sse2, SimdLevel::Scalar }) {
+			if (level > detected)
+				continue;
+
+			ActiveSimdLevel() = level;
+
+			// wrapping integer sums match exactly
+			ASSERT_EQ (sequential(ints).Sum(),					Enumerate(ints).Sum());
+			ASSERT_EQ (sequential(ints).Sum<long long>(),		Enumerate(ints).Sum<long long>());
+			ASSERT_EQ (sequential(unsigneds).Sum(),				Enumerate(unsigneds).Sum());
+			ASSERT_EQ (sequential(longs).Sum(),					Enumerate(longs).Sum());
+			ASSERT_EQ (sequential(records).Select(&Record::key).Sum<long long>(),
+					   Enumerate(records).Select(&Record::key).Sum<long long>());
+
+			// compensated sums may differ in rounding only
+			ASSERT (std::abs(sequential(doubles).Sum() - Enumerate(doubles).Sum()) < 1e-6);
+			ASSERT (std::abs(sequential(floats).Sum()  - Enumerate(floats).Sum())  < 1e-3f);
+			ASSERT (std::abs(sequential(records).Select(&Record::value).Sum() - Enumerate(records).Select(&Record::value).Sum()) < 1e-12);
+			ASSERT (std::abs(*sequential(doubles).Avg() - *Enumerate(doubles).Avg()) < 1e-9);
+
+			// tails and empty sources
+			ASSERT_EQ (ints[0] + ints[1] + ints[2],	Enumerate(ints.data(), ints.data() + 3).Sum());
+			ASSERT_EQ (0,							Enumerate(ints.data(), ints.data()).Sum());
+			ASSERT	  (!Enumerate(doubles.data(), doubles.data()).Avg().HasValue());
+
+			double edgeCase[] = { 1.0, 1e100, 1.0, -1e100, 1.0, 1e100, 1.0, -1e100, 1.0 };
+			ASSERT_EQ (5.0, Enumerate(edgeCase).Sum());
+		}
+		ActiveSimdLevel() = detected;
+	}
+
+
+	// Min, Max, Minimums and Maximums of contiguous sources run vectorized kernels - must pick the same elements as sequential search.
+	static void VectorizedExtremes()
+	{
+		using Enumerables::SimdLevel;
+		using Enumerables::AreEqual;
+		using Enumerables::Def::ActiveSimdLevel;
+
+		struct Record {
+			int		key;
+			double	value;
+		};
+
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+
+		std::vector<int>		  ints;
+		std::vector<long long>	  longs;
+		std::vector<float>		  floats;
+		std::vector<double>		  doubles;
+		std::vector<Record>		  records;
+		for (int i = 0; i < 1203; ++i) {
+			ints.push_back(i % 97 - 40);
+			longs.push_back((i % 2 ? -1ll : 1ll) << (i % 60));
+			floats.push_back(static_cast<float>(i % 13) * 0.1f);
+			doubles.push_back(std::abs(std::sin(i)) + 0.5);
+			records.push_back({ 600 - i % 601, 1.0 / (i % 300 + 1) });
+		}
+		doubles[3]	  = 0.0;
+		doubles[1100] = -0.0;		// equivalent, but not the first
+
+		std::vector<double> nanFirst = doubles;
+		std::vector<double> nanLater = doubles;
+		nanFirst[0]	  = nan;
+		nanLater[700] = nan;
+
+		// opaque to the kernels
+		auto sequential = [](auto& v) { return Enumerate(v).Where(FUN(x, true)); };
+		auto addresses  = [](const auto& q) { return q.Select(FUN(x, &x)); };
+
+		const SimdLevel detected = ActiveSimdLevel();
+		for (SimdLevel level : { detected, SimdLevel::Sse2, SimdLevel::Scalar }) {
+			if (level > detected)
+				continue;
+
+			ActiveSimdLevel() = level;
+
+			ASSERT_EQ (-40,						Enumerate(ints).Min());
+			ASSERT_EQ (56,						Enumerate(ints).Max());
+			ASSERT_EQ (*sequential(longs).Min(),	Enumerate(longs).Min());
+			ASSERT_EQ (*sequential(longs).Max(),	Enumerate(longs).Max());
+			ASSERT_EQ (0.0f,					Enumerate(floats).Min());
+			ASSERT_EQ (1.2f,					Enumerate(floats).Max());
+
+			// signed zero of the first occurrence
+			ASSERT_EQ (0.0, Enumerate(doubles).Min());
+			ASSERT	  (!std::signbit(*Enumerate(doubles).Min()));
+			ASSERT	  (std::isnan(*Enumerate(nanFirst).Min()));
+			ASSERT_EQ (0.0, Enumerate(nanLater).Min());
+
+			ASSERT (AreEqual(addresses(sequential(ints).Minimums()),	addresses(Enumerate(ints).Minimums())));
+			ASSERT (AreEqual(addresses(sequential(ints).Maximums()),	addresses(Enumerate(ints).Maximums())));
+			ASSERT (AreEqual(addresses(sequential(longs).Minimums()),	addresses(Enumerate(longs).Minimums())));
+			ASSERT (AreEqual(addresses(sequential(floats).Maximums()),	addresses(Enumerate(floats).Maximums())));
+			ASSERT (AreEqual(addresses(sequential(doubles).Minimums()), addresses(Enumerate(doubles).Minimums())));
+			ASSERT (AreEqual(addresses(sequential(nanFirst).Minimums()), addresses(Enumerate(nanFirst).Minimums())));
+			ASSERT (AreEqual(addresses(sequential(nanLater).Maximums()), addresses(Enumerate(nanLater).Maximums())));
+			ASSERT_EQ (13, Enumerate(ints).Minimums().Count());
+
+			// by data member
+			ASSERT (AreEqual(addresses(sequential(records).MinimumsBy(&Record::key)),	 addresses(Enumerate(records).MinimumsBy(&Record::key))));
+			ASSERT (AreEqual(addresses(sequential(records).MaximumsBy(&Record::value)), addresses(Enumerate(records).MaximumsBy(&Record::value))));
+			ASSERT (AreEqual(addresses(sequential(records).Select(&Record::key).Maximums()),
+							 addresses(Enumerate(records).Select(&Record::key).Maximums())));
+			ASSERT_EQ (2, Enumerate(records).MinimumsBy(&Record::key).Count());
+
+			// tails and empty sources
+			ASSERT_EQ (-40,	Enumerate(ints.data(), ints.data() + 3).Min());
+			ASSERT_EQ (-38,	Enumerate(ints.data(), ints.data() + 3).Max());
+			ASSERT	  (!Enumerate(ints.data(), ints.data()).Min().HasValue());
+			ASSERT	  (!Enumerate(doubles.data(), doubles.data()).Minimums().Any());
+		}
+		ActiveSimdLevel() = detected;
+	}
+
+
+
+	// MapNeighbors of contiguous sources runs block kernels for standard arithmetic and elementwise lambdas when collected.
+	static void VectorizedNeighbors()
+	{
+		using Enumerables::SimdLevel;
+		using Enumerables::AreEqual;
+		using Enumerables::Elementwise;
+		using Enumerables::Def::ActiveSimdLevel;
+
+		struct Record {
+			int		key;
+			double	value;
+		};
+
+		std::vector<int>		  ints;
+		std::vector<unsigned>	  unsigneds;
+		std::vector<long long>	  longs;
+		std::vector<float>		  floats;
+		std::vector<double>		  doubles;
+		std::vector<Record>		  records;
+		for (int i = 0; i < 1203; ++i) {
+			ints.push_back(i * i % 97 - 40);
+			unsigneds.push_back(static_cast<unsigned>(i % 7));
+			longs.push_back((i % 2 ? -1ll : 1ll) << (i % 60));
+			floats.push_back(static_cast<float>(i % 13) * 0.1f);
+			doubles.push_back(std::sin(i));
+			records.push_back({ i % 10, 1.0 / (i + 1) });
+		}
+
+		// opaque to the kernels
+		auto sequential = [](auto& v) { return Enumerate(v).Where(FUN(x, true)); };
+
+		const SimdLevel detected = ActiveSimdLevel();
+		for (SimdLevel level : { detected, SimdLevel::Sse2, SimdLevel::Scalar }) {
+			if (level > detected)
+				continue;
+
+			ActiveSimdLevel() = level;
+
+			ASSERT (AreEqual(sequential(ints).MapNeighbors(FUN(p, n,  p - n)),			Enumerate(ints).MapNeighbors(std::minus<>()).ToList()));
+			ASSERT (AreEqual(sequential(ints).MapNeighbors(FUN(p, n,  p + n)),			Enumerate(ints).MapNeighbors(std::plus<int>()).ToList()));
+			ASSERT (AreEqual(sequential(longs).MapNeighbors(FUN(p, n,  p - n)),			Enumerate(longs).MapNeighbors(std::minus<>()).ToList()));
+			ASSERT (AreEqual(sequential(floats).MapNeighbors(FUN(p, n,  p + n)),		Enumerate(floats).MapNeighbors(std::plus<>()).ToList()));
+			ASSERT (AreEqual(sequential(doubles).MapNeighbors(FUN(p, n,  p / n)),		Enumerate(doubles).MapNeighbors(std::divides<>()).ToList()));
+
+			// wrapping, as signed
+			ASSERT (AreEqual(sequential(unsigneds).MapNeighbors(FUN(p, n,  p - n)),		Enumerate(unsigneds).MapNeighbors(std::minus<>()).ToList()));
+
+			// declared elementwise, even with conversion
+			ASSERT (AreEqual(sequential(ints).MapNeighbors(FUN(p, n,  n - p)),			Enumerate(ints).MapNeighbors(Elementwise(FUN(p, n,  n - p))).ToList()));
+			ASSERT (AreEqual(sequential(ints).MapNeighbors(FUN(p, n,  p < n)),			Enumerate(ints).MapNeighbors(Elementwise(FUN(p, n,  p < n))).ToList()));
+			ASSERT (AreEqual(sequential(doubles).MapNeighbors(FUN(p, n,  n * 0.5 - p)),	Enumerate(doubles).MapNeighbors(Elementwise(FUN(p, n,  n * 0.5 - p))).ToList()));
+
+			// by data member
+			ASSERT (AreEqual(sequential(records).Select(&Record::value).MapNeighbors(FUN(p, n,  p - n)),
+							 Enumerate(records).Select(&Record::value).MapNeighbors(std::minus<>()).ToList()));
+
+			// tails and empty sources
+			ASSERT (AreEqual({ -1, -3 },	Enumerate(ints.data(), ints.data() + 3).MapNeighbors(std::minus<>()).ToList()));
+			ASSERT (Enumerate(ints.data(), ints.data() + 1).MapNeighbors(std::minus<>()).ToList().empty());
+			ASSERT (Enumerate(ints.data(), ints.data()).MapNeighbors(std::minus<>()).ToList().empty());
+		}
+		ActiveSimdLevel() = detected;
+	}
+
+
+	// Sums of zipped products over contiguous sources run a single fused pass - Dot or Zip(mul).Sum().
+	static void VectorizedDot()
+	{
+		using Enumerables::SimdLevel;
+		using Enumerables::Def::ActiveSimdLevel;
+		using namespace Enumerables::Placeholders;
+
+		struct Record {
+			int		key;
+			double	value;
+		};
+
+		std::vector<int>		  ints;
+		std::vector<unsigned>	  unsigneds;
+		std::vector<long long>	  longs;
+		std::vector<float>		  floats;
+		std::vector<double>		  doubles;
+		std::vector<double>		  weights;
+		std::vector<Record>		  records;
+		for (int i = 0; i < 1003; ++i) {
+			ints.push_back(i % 7 == 0 ? -i * 100 : i * 300);
+			unsigneds.push_back(4000000000u - static_cast<unsigned>(i));
+			longs.push_back((i % 2 ? -1ll : 1ll) << (i % 30));
+			floats.push_back(static_cast<float>(i % 13) * 0.1f);
+			doubles.push_back(i % 5 ? 0.1 * i : -1e10);
+			weights.push_back(1.0 / (i + 1));
+			records.push_back({ i - 500, std::sin(i) });
+		}
+
+		// opaque to the kernels
+		auto sequential = [](auto& v) { return Enumerate(v).Where(FUN(x, true)); };
+		auto product	= [](auto x, auto y) { return x * y; };
+
+		const SimdLevel detected = ActiveSimdLevel();
+		for (SimdLevel level : { detected, SimdLevel::Sse2, SimdLevel::Scalar }) {
+			if (level > detected)
+				continue;
+
+			ActiveSimdLevel() = level;
+
+			// wrapping integer sums match exactly
+			ASSERT_EQ (sequential(ints).Zip(ints, product).Sum(),					Enumerate(ints).Dot(ints));
+			ASSERT_EQ (sequential(ints).Zip(ints, product).Sum<long long>(),		Enumerate(ints).Dot<long long>(ints));
+			ASSERT_EQ (sequential(unsigneds).Zip(unsigneds, product).Sum(),			Enumerate(unsigneds).Dot(unsigneds));
+			ASSERT_EQ (sequential(longs).Zip(longs, product).Sum(),					Enumerate(longs).Zip(longs, _1 * _2).Sum());
+			ASSERT_EQ (sequential(records).Select(&Record::key).Zip(ints, product).Sum(),
+					   Enumerate(records).Select(&Record::key).Zip(ints, std::multiplies<>()).Sum());
+
+			// compensated sums may differ in rounding only
+			ASSERT (std::abs(sequential(doubles).Zip(weights, product).Sum() - Enumerate(doubles).Dot(weights)) < 1e-6);
+			ASSERT (std::abs(sequential(floats).Zip(floats, product).Sum()	 - Enumerate(floats).Zip(floats, _2 * _1).Sum()) < 1e-2f);
+			ASSERT (std::abs(sequential(records).Select(&Record::value).Zip(weights, product).Sum()
+							 - Enumerate(records).Select(&Record::value).Dot(weights)) < 1e-12);
+			ASSERT (std::abs(sequential(records).Select(&Record::value).Zip(Enumerate(records).Select(&Record::value), product).Sum()
+							 - Enumerate(records).Select(&Record::value).Zip(Enumerate(records).Select(&Record::value), _1 * _2).Sum()) < 1e-12);
+
+			// the shorter source determines the length
+			ASSERT_EQ (ints[0] * ints[0] + ints[1] * ints[1] + ints[2] * ints[2],	Enumerate(ints).Dot(Enumerate(ints.data(), ints.data() + 3)));
+			ASSERT_EQ (ints[0] * ints[0] + ints[1] * ints[1] + ints[2] * ints[2],	Enumerate(ints.data(), ints.data() + 3).Dot(ints));
+			ASSERT_EQ (0,															Enumerate(ints.data(), ints.data()).Dot(ints));
+			ASSERT_EQ (0.0,															Enumerate(doubles).Dot(Enumerate(weights.data(), weights.data())));
+
+			double edgeCase[] = { 1.0, 1e100, 1.0, -1e100, 1.0, 1e100, 1.0, -1e100, 1.0 };
+			double ones[]	  = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+			ASSERT_EQ (5.0, Enumerate(edgeCase).Dot(ones));
+		}
+		ActiveSimdLevel() = detected;
+	}
+
+
+
+
 	static void CopyAvoidance()
 	{
 		int numsArr[] = { 5, -5, 7, 8, 7, 8, -1 };
@@ -599,6 +887,10 @@ namespace EnumerableTests {
 
 		Orderings();
 		Summation();
+		VectorizedSummation();
+		VectorizedExtremes();
+		VectorizedNeighbors();
+		VectorizedDot();
 		CopyAvoidance();
 		Aggregation();
 	}
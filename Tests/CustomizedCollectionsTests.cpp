@@ -3,6 +3,16 @@
 #include "TestUtils.hpp"
 #include "TestAllocator.hpp"
 #include "Enumerables.hpp"
+#include "Enumerables_HugePages.hpp"
+#include <cstring>
+
+// std::pmr is C++17: tested only if available
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 201703L
+#	define TEST_PMR		true
+#	include <memory_resource>
+#else
+#	define TEST_PMR		false
+#endif
 
 
 
@@ -343,6 +353,282 @@ namespace EnumerableTests {
 	}
 
 
+	// Short lists kept inline by SmallVector - bound as the default of ToList<N>() and internal SmallLists
+	static void SmallLists()
+	{
+		const int nums[] = { 5, 3, 8, 1, 9, 2, 7 };
+
+		// fits inline buffer
+		{
+			auto small = Enumerate(nums).Where(FUN(x, x > 4));
+
+			NO_MORE_HEAP;
+
+			auto fiveUp = small.ToList<4>();
+			ASSERT_TYPE (Enumerables::SmallVector<int COMMA 4>, fiveUp);
+			ASSERT_EQ	(4, fiveUp.size());
+			ASSERT_EQ	(5, fiveUp.front());
+			ASSERT_EQ	(7, fiveUp.back());
+
+			// moved element by element
+			auto moved = std::move(fiveUp);
+			ASSERT_EQ (4, moved.size());
+			ASSERT	  (fiveUp.empty());
+
+			// ReplayEnumerator keeps the head inline
+			auto closed = Enumerate(nums).CloseWithFirst(1).ToList<8>();
+			ASSERT_EQ (8, closed.size());
+			ASSERT_EQ (5, closed.back());
+		}
+
+		// grows to the heap
+		{
+			AllocationCounter allocations;
+
+			auto all = Enumerate(nums).ToList<2>();
+			allocations.AssertFreshCount(1);
+
+			auto copy  = all;
+			auto moved = std::move(all);
+			allocations.AssertFreshCount(1);		// for the copy, buffer gets passed by move
+
+			ASSERT	  (copy == moved);
+			ASSERT	  (all.empty());
+			ASSERT_EQ (Enumerate(nums).ToList(), std::vector<int>(moved.begin(), moved.end()));
+
+			moved.erase(moved.begin() + 1, moved.end() - 1);
+			ASSERT_EQ (2, moved.size());
+			ASSERT_EQ (5, moved.front());
+			ASSERT_EQ (7, moved.back());
+			ASSERT_EQ (7, moved.capacity());
+		}
+
+		// a throwing copy leaves the elements constructed so far
+		{
+			struct Fragile {
+				int value;
+
+				Fragile(int v) : value { v }							{}
+				Fragile(const Fragile& src) : value { src.value }
+				{
+					if (value < 0)
+						throw std::runtime_error("negative");
+				}
+			};
+
+			const Fragile sources[] = { 1, 2, -3, 4 };
+
+			Enumerables::SmallVector<Fragile, 8> list;
+			list.emplace_back(0);
+			ASSERT_THROW (std::runtime_error, list.insert(list.end(), std::begin(sources), std::end(sources)));
+			ASSERT_EQ	 (3, list.size());
+			ASSERT_EQ	 (2, list.back().value);
+		}
+	}
+
+
+
+	// Open-addressing containers - bound via ENUMERABLES_SET_BINDING / ENUMERABLES_DICTIONARY_BINDING if desired
+	static void FlatHashes()
+	{
+		using Enumerables::FlatHashSet;
+		using Enumerables::FlatHashMap;
+		using SetOps  = Enumerables::FlatBinding::SetOperations;
+		using DictOps = Enumerables::FlatBinding::DictionaryOperations;
+
+		// hashes std::string and literals alike
+		struct StringHash {
+			using is_transparent = void;
+
+			static size_t Hash(const char* s, size_t length)
+			{
+				size_t h = 0;
+				for (size_t i = 0; i < length; ++i)
+					h = 31 * h + static_cast<unsigned char>(s[i]);
+				return h;
+			}
+
+			size_t operator ()(const std::string& s) const	{ return Hash(s.data(), s.size()); }
+			size_t operator ()(const char* s)		 const	{ return Hash(s, std::strlen(s)); }
+		};
+
+		std::vector<int> nums;
+		for (int i = 0; i < 1000; ++i)
+			nums.push_back(i * 7 % 500);
+
+		// reserved as measured by the query
+		{
+			using Set = SetOps::Container<int>;
+
+			AllocationCounter allocations;
+
+			Set set = SetOps::Init<Set>(Enumerate(nums).Count());
+			ASSERT_TYPE (FlatHashSet<int>, set);
+			allocations.AssertFreshCount(2);		// control bytes + slots
+
+			const size_t capacity = set.bucket_count();
+			for (int n : nums)
+				SetOps::Add(set, n);
+
+			allocations.AssertFreshCount(0);
+			ASSERT_EQ (capacity, set.bucket_count());
+			ASSERT_EQ (500, set.size());
+			ASSERT	  (SetOps::Contains(set, 21));
+			ASSERT	  (!SetOps::Contains(set, 500));
+
+			// erasure leaves tombstones, then reused
+			for (int i = 0; i < 500; i += 2)
+				set.erase(i);
+
+			ASSERT_EQ (250, set.size());
+			ASSERT	  (set.contains(499));
+			ASSERT	  (!set.contains(498));
+			ASSERT_EQ (250 * 250, Enumerate(set).Sum());
+
+			for (int n : nums)
+				set.insert(n);
+
+			allocations.AssertFreshCount(0);
+			ASSERT_EQ (500, set.size());
+			ASSERT	  (set == Set(nums.begin(), nums.end()));
+		}
+
+		// heterogeneous lookup by transparent Hash and KeyEqual
+		{
+			FlatHashSet<std::string, StringHash, std::equal_to<>> names { "Aldo Montgomery", "Charlie Bucket", "Dave Lister" };
+			FlatHashMap<std::string, int, StringHash, std::equal_to<>> ages;
+			DictOps::Add(ages, "Aldo Montgomery", 23);
+			DictOps::Add(ages, "Charlie Bucket", 42);
+			DictOps::Add(ages, "Charlie Bucket", 11);		// keeps first
+
+			NO_MORE_HEAP;
+
+			ASSERT	  (names.contains("Dave Lister"));
+			ASSERT	  (!names.contains("Dorothy Gale"));
+			ASSERT	  (SetOps::Contains(names, "Charlie Bucket"));
+			ASSERT_EQ (42, ages.find("Charlie Bucket")->second);
+			ASSERT_EQ (2,  ages.count("Aldo Montgomery") + ages.count("Charlie Bucket"));
+			ASSERT_EQ (65, Enumerate(ages).Select(FUN(kv, kv.second)).Sum());
+		}
+
+		// many elements, growing
+		{
+			auto dict = DictOps::Init<DictOps::Container<int, std::string>>(0);
+			for (int i = 0; i < 5000; ++i)
+				DictOps::Add(dict, i, std::to_string(i));
+
+			ASSERT_EQ (5000,   dict.size());
+			ASSERT_EQ ("4321", DictOps::Access(dict, 4321));
+			ASSERT_EQ ("17",   dict.at(17));
+			ASSERT_EQ ("42",   *DictOps::Find(dict, 42));
+			ASSERT	  (DictOps::Find(dict, 5000) == nullptr);
+			ASSERT_THROW (std::out_of_range, dict.at(5000));
+
+			auto moved = std::move(dict);
+			ASSERT	  (dict.empty());
+			ASSERT_EQ (5000, Enumerate(moved).Count(FUN(kv, std::to_string(kv.first) == kv.second)));
+		}
+	}
+
+
+
+	// Contiguous dictionaries for small results - bound via ENUMERABLES_DICTIONARY_BINDING if desired
+	static void SortedDictionaries()
+	{
+		using Enumerables::SortedFlatMap;
+		using Enumerables::AdaptiveMap;
+		using SortedOps = Enumerables::FlatBinding::SortedDictionaryOperations;
+		using AutoOps	= Enumerables::FlatBinding::AutoDictionaryOperations;
+
+		// appended as enumerated, sorted once at the end
+		{
+			using Dict = SortedOps::Container<int, std::string>;
+
+			AllocationCounter allocations;
+
+			using Expected = SortedFlatMap<int, std::string>;
+
+			Dict dict = SortedOps::Init<Dict>(6);
+			ASSERT_TYPE (Expected, dict);
+			allocations.AssertFreshCount(1);
+
+			for (int n : { 5, 3, 8, 3, 1, 5 })
+				SortedOps::Add(dict, n, std::to_string(n * 10 + (int)dict.size()));
+
+			allocations.AssertFreshCount(0);
+			ASSERT	  (!dict.is_sorted());
+			ASSERT	  (SortedOps::Contains(dict, 8));			// found while unsorted too
+			ASSERT	  (!SortedOps::Contains(dict, 4));
+
+			SortedOps::Finalize(dict);
+
+			ASSERT	  (dict.is_sorted());
+			ASSERT_EQ (4, dict.size());
+			ASSERT	  ((Enumerate(dict).Select(FUN(kv, kv.first)).ToList() == std::vector<int> { 1, 3, 5, 8 }));
+			ASSERT_EQ ("31", dict.at(3));							// keeps first
+			ASSERT_EQ ("50", SortedOps::Access(dict, 5));
+			ASSERT_EQ ("82", *SortedOps::Find(dict, 8));
+			ASSERT	  (SortedOps::Find(dict, 4) == nullptr);
+			ASSERT_THROW (std::out_of_range, dict.at(4));
+
+			dict[4] = "inserted";
+			dict.erase(1);
+			ASSERT	  ((Enumerate(dict).Select(FUN(kv, kv.first)).ToList() == std::vector<int> { 3, 4, 5, 8 }));
+			ASSERT	  ((dict == Dict { { 8, "82" }, { 5, "50" }, { 4, "inserted" }, { 3, "31" } }));
+		}
+
+		// ordered input needs no sorting
+		{
+			SortedFlatMap<std::string, int, std::less<>> ages;
+			SortedOps::Add(ages, "Aldo Montgomery", 23);
+			SortedOps::Add(ages, "Charlie Bucket", 42);
+			SortedOps::Add(ages, "Dave Lister", 11);
+
+			AllocationCounter allocations;
+			SortedOps::Finalize(ages);
+			allocations.AssertFreshCount(0);
+
+			NO_MORE_HEAP;
+
+			ASSERT_EQ (42, ages.find("Charlie Bucket")->second);
+			ASSERT	  (!ages.contains("Dorothy Gale"));
+			ASSERT_EQ (76, Enumerate(ages).Select(FUN(kv, kv.second)).Sum());
+		}
+
+		// chosen by size
+		{
+			using Dict	   = AutoOps::Container<int, int>;
+			using Expected = AdaptiveMap<int, int>;
+			constexpr int max = ENUMERABLES_SORTED_DICTIONARY_MAX;
+
+			Dict small = AutoOps::Init<Dict>(max);
+			Dict large = AutoOps::Init<Dict>(max + 1);
+			ASSERT_TYPE (Expected, small);
+			ASSERT	  (!small.is_hashed());
+			ASSERT	  (large.is_hashed());
+
+			// duplicates do not count
+			for (int i = 3 * max; i > 0; --i) {
+				AutoOps::Add(small, i % max, i);
+				AutoOps::Add(large, i % max, i);
+			}
+			AutoOps::Finalize(small);
+			AutoOps::Finalize(large);
+			ASSERT	  (!small.is_hashed());
+			ASSERT_EQ (max, small.size());
+			ASSERT	  (small == large);
+			ASSERT_EQ (3 * max, small.at(0));
+			ASSERT_EQ (0, Enumerate(small).Select(FUN(kv, kv.first)).First());
+
+			AutoOps::Access(small, -1) = -1;
+			ASSERT	  (small.is_hashed());
+			ASSERT_EQ (max + 1, small.size());
+			ASSERT_EQ (3 * max, small.at(0));
+			ASSERT_EQ (-1, small.at(-1));
+		}
+	}
+
+
 	// Similar to CustomHashes(), but a more complicated terminal operator
 	static void CustomDictionaries()
 	{
@@ -557,13 +843,296 @@ namespace EnumerableTests {
 	}
 
 
+#if TEST_PMR
+
+	// std::pmr containers by explicit allocators - bound for all containers via ENUMERABLES_USE_PMR if desired
+	static void PmrAllocators()
+	{
+		// counts allocations, delegating to the heap
+		class CountingResource : public std::pmr::memory_resource {
+			void* do_allocate(size_t bytes, size_t align) override				{ ++Count; return std::pmr::new_delete_resource()->allocate(bytes, align); }
+			void  do_deallocate(void* p, size_t bytes, size_t align) override	{ std::pmr::new_delete_resource()->deallocate(p, bytes, align); }
+			bool  do_is_equal(const memory_resource& rhs) const noexcept override	{ return this == &rhs; }
+
+		public:
+			size_t Count = 0;
+		};
+
+		using Alloc		= std::pmr::polymorphic_allocator<int>;
+		using DictAlloc	= std::pmr::polymorphic_allocator<std::pair<const int, int>>;
+
+		const std::vector<int> nums { 5, 3, 8, 1, 9, 2, 7 };
+
+		CountingResource resource;
+
+		auto list = Enumerate<int>(nums).Where(FUN(x, x > 1)).Order().ToList(0, Alloc { &resource });
+		ASSERT_TYPE (std::pmr::vector<int>, list);
+		ASSERT_EQ	(&resource, list.get_allocator().resource());
+		ASSERT_EQ	(6, list.size());
+		ASSERT		(std::is_sorted(list.begin(), list.end()));
+		ASSERT		(resource.Count > 0);
+
+		auto set = Enumerate(nums).ToSet(0, std::hash<int> {}, std::equal_to<int> {}, Alloc { &resource });
+		ASSERT_TYPE (std::pmr::unordered_set<int>, set);
+		ASSERT_EQ	(&resource, set.get_allocator().resource());
+		ASSERT_EQ	(nums.size(), set.size());
+
+		auto dict = Enumerate(nums).ToDictionary(FUN(x, x * 10), 0, std::hash<int> {}, std::equal_to<int> {}, DictAlloc { &resource });
+		ASSERT_TYPE (std::pmr::unordered_map<int COMMA int>, dict);
+		ASSERT_EQ	(&resource, dict.get_allocator().resource());
+		ASSERT_EQ	(8, dict[80]);
+
+		// SmallVector over polymorphic_allocator: the allocator is not propagated by move-assignment
+		{
+			using Small = Enumerables::SmallVector<int, 2, Alloc>;
+
+			std::pmr::monotonic_buffer_resource monotonic;
+
+			Small grown  { { 4, 3, 2, 1 }, Alloc { &resource } };
+			Small target { Alloc { &monotonic } };
+			target = std::move(grown);
+			ASSERT_EQ (&monotonic, target.get_allocator().resource());
+			ASSERT_EQ (4,		   target.size());
+			ASSERT_EQ (1,		   target.back());
+			ASSERT	  (grown.empty());
+
+			Small sameResource { Alloc { &monotonic } };
+			sameResource = std::move(target);
+			ASSERT_EQ (4, sameResource.size());
+		}
+	}
+
+#endif
+
+
+#if ENUMERABLES_USE_PMR
+
+	static void PmrResources()
+	{
+		// counts allocations, delegating to the heap
+		class CountingResource : public std::pmr::memory_resource {
+			void* do_allocate(size_t bytes, size_t align) override				{ ++Count; return std::pmr::new_delete_resource()->allocate(bytes, align); }
+			void  do_deallocate(void* p, size_t bytes, size_t align) override	{ std::pmr::new_delete_resource()->deallocate(p, bytes, align); }
+			bool  do_is_equal(const memory_resource& rhs) const noexcept override	{ return this == &rhs; }
+
+		public:
+			size_t Count = 0;
+		};
+
+		const std::vector<int> nums { 5, 3, 8, 1, 9, 2, 7 };
+
+		CountingResource resource;
+
+		// the cache of Order gets allocated from resource, then passed as the result
+		auto ordered = Enumerate(nums).Copy().Where(FUN(x, x > 1)).Order();
+		{
+			AllocationCounter allocations;
+
+			std::pmr::vector<int> list = ordered.ToList(&resource);
+			ASSERT_EQ (&resource, list.get_allocator().resource());
+			ASSERT	  (ordered.ToList() == list);
+			ASSERT	  (resource.Count > 0);
+
+			resource.Count = 0;
+			allocations.Reset();
+			std::pmr::vector<int> again = ordered.ToList(&resource);
+			ASSERT_EQ (0, allocations.Count());		// AllocationCounter sees operator new only, not the pool
+			ASSERT	  (resource.Count > 0);
+		}
+
+		auto set = Enumerate(nums).ToSet(&resource);
+		ASSERT_TYPE (std::pmr::unordered_set<int>, set);
+		ASSERT_EQ	(&resource, set.get_allocator().resource());
+		ASSERT_EQ	(nums.size(), set.size());
+
+		auto dict = Enumerate(nums).ToDictionary(FUN(x, x * 10), &resource);
+		ASSERT_EQ (&resource, dict.get_allocator().resource());
+		ASSERT_EQ (8, dict[80]);
+
+		// default resource outside the call
+		auto list = Enumerate(nums).Copy().Order().ToList();
+		ASSERT_EQ (std::pmr::get_default_resource(), list.get_allocator().resource());
+
+		// monotonic buffer for the whole query
+		std::pmr::monotonic_buffer_resource monotonic;
+		auto minimums = Enumerate(nums).Copy().Except(Enumerate({ 8 })).MinimumsBy(FUN(x, x % 2)).ToList(&monotonic);
+		ASSERT	  (std::vector<int>({ 2 }) == std::vector<int>(minimums.begin(), minimums.end()));
+	}
+
+#endif
+
+
+
+	template <class F>
+	static Enumerables::TypeHelpers::IsConcurrencySafe<F>	ConcurrencySafetyOf(const Enumerables::Def::AutoEnumerable<F>&);
+
+
+	static void ArenaCaches()
+	{
+		// Arena itself
+		{
+			Enumerables::Arena arena { 64 };
+			void* a = arena.Allocate(3, 1);
+			void* b = arena.Allocate(sizeof(double), alignof(double));
+			ASSERT_EQ (0u,		   reinterpret_cast<uintptr_t>(b) % alignof(double));
+			ASSERT	  (static_cast<char*>(b) >= static_cast<char*>(a) + 3);
+			ASSERT_EQ (1u,		   arena.BlockCount());
+
+			arena.Allocate(1000);
+			ASSERT_EQ (2u,		   arena.BlockCount());
+			arena.Release();
+			ASSERT_EQ (0u,		   arena.BlockCount());
+		}
+
+		std::vector<int> nums;
+		for (int i = 0; i < 200; ++i)
+			nums.push_back((i * 37) % 101);
+
+		const std::vector<int> excluded { 3, 5, 8, 13, 21, 34, 55, 89 };
+
+		auto values = Enumerate(nums).Copy();
+
+		// same results as without arena
+		{
+			alignas(std::max_align_t) char buffer[8192];
+			Enumerables::Arena arena { buffer, sizeof(buffer) };
+
+			auto ordered  = values.WithArena(arena).Order();
+			auto minimums = values.WithArena(arena).Where(FUN(x, x % 2 == 1)).MinimumsBy(FUN(x, x % 10));
+			auto except	  = values.WithArena(arena).Except(Enumerate(excluded));
+			auto closed	  = values.WithArena(arena).CloseWithFirst(3);
+
+			ASSERT_EQ (values.Order().ToList(),											  ordered.ToList());
+			ASSERT_EQ (values.Where(FUN(x, x % 2 == 1)).MinimumsBy(FUN(x, x % 10)).ToList(), minimums.ToList());
+			ASSERT_EQ (values.Except(Enumerate(excluded)).ToList(),						  except.ToList());
+			ASSERT_EQ (values.CloseWithFirst(3).ToList(),								  closed.ToList());
+			ASSERT_EQ (0u,	arena.BlockCount());
+
+			// results are not allocated from the arena
+			ASSERT_TYPE (std::vector<int>, ordered.ToList());
+			ASSERT_TYPE (std::vector<int>, except.ToList());
+		}
+
+		// caches of arena chains don't hit the heap
+		{
+			alignas(std::max_align_t) char buffer[4096];
+			Enumerables::Arena arena { buffer, sizeof(buffer) };
+
+			auto ordered = values.WithArena(arena).Where(FUN(x, x > 50)).Order();
+			auto plain	 = values.Where(FUN(x, x > 50)).Order();
+
+			AllocationCounter allocations;
+			const size_t count = ordered.Count();
+			const int	 first = ordered.First();
+			allocations.AssertFreshCount(0);
+
+			ASSERT_EQ (plain.Count(), count);
+			ASSERT_EQ (plain.First(), first);
+			ASSERT	  (allocations.Count() > 0);
+			ASSERT_EQ (0u, arena.BlockCount());
+		}
+
+		// snapshots of arena chains are cached there too
+		{
+			alignas(std::max_align_t) char buffer[4096];
+			Enumerables::Arena arena { buffer, sizeof(buffer) };
+
+			AllocationCounter allocations;
+			auto snapshot = Enumerate(nums).WithArena(arena).Where(FUN(x, x > 50)).ToSnapshot();
+			allocations.AssertFreshCount(0);
+
+			ASSERT_EQ (Enumerate(nums).Where(FUN(x, x > 50)).ToList(), snapshot.ToList());
+			ASSERT_EQ (&nums[2],										 &snapshot.First());
+			ASSERT_EQ (0u, arena.BlockCount());
+		}
+
+		// arena chains and their continuations are not shareable between threads
+		{
+			Enumerables::Arena arena { 64 };
+
+			auto plain	  = values.Where(FUN(x, x > 50)).Order();
+			auto attached = values.WithArena(arena);
+			auto chained  = values.WithArena(arena).Where(FUN(x, x > 50)).Order();
+			auto joined	  = values.Concat(values.WithArena(arena));
+			static_assert ( decltype(ConcurrencySafetyOf(plain))::value,	"");
+			static_assert (!decltype(ConcurrencySafetyOf(attached))::value, "");
+			static_assert (!decltype(ConcurrencySafetyOf(chained))::value,	"");
+			static_assert (!decltype(ConcurrencySafetyOf(joined))::value,	"");
+		}
+
+		// without a buffer: heap blocks, kept until released
+		{
+			Enumerables::Arena arena { 256 };
+
+			auto minimums = values.WithArena(arena).MinimumsBy(FUN(x, x % 10));
+			ASSERT_EQ (values.MinimumsBy(FUN(x, x % 10)).ToList(), minimums.ToList());
+			ASSERT	  (arena.BlockCount() > 0);
+
+			arena.Release();
+			ASSERT_EQ (0u, arena.BlockCount());
+		}
+	}
+
+
+
+	// Large blocks on huge pages - bound for all lists via ENUMERABLES_USE_HUGEPAGES if desired
+	static void HugePages()
+	{
+		using Alloc	= Enumerables::HugePageAllocator<int>;
+		using List	= std::vector<int, Alloc>;
+
+		std::vector<int> nums;
+		for (int i = 0; i < 200; ++i)
+			nums.push_back((i * 37) % 101);
+
+		// small lists are served as usual
+		{
+			AllocationCounter allocations;
+
+			auto list = Enumerate<int>(nums).Order().ToList(0, Alloc {});
+			ASSERT_TYPE (List, list);
+			ASSERT_EQ (200, list.size());
+			ASSERT	  (std::is_sorted(list.begin(), list.end()));
+			ASSERT	  (allocations.Count() > 0);
+		}
+
+		// large ones get aligned to whole pages
+		{
+			const size_t count = Alloc::Threshold / sizeof(int);
+			const int	 last  = static_cast<int>(count) - 1;
+
+			auto list = Enumerables::Range<int>(0, count).Select(FUN(x, -x)).Order().ToList(count, Alloc {});
+			ASSERT_EQ (count, list.size());
+			ASSERT_EQ (-last, list.front());
+			ASSERT_EQ (0,	  list.back());
+			ASSERT_EQ (0u,	  reinterpret_cast<uintptr_t>(list.data()) % Alloc::PageSize);
+
+			List copy = list;
+			ASSERT_EQ (0u,	  reinterpret_cast<uintptr_t>(copy.data()) % Alloc::PageSize);
+			ASSERT	  (copy == list);
+		}
+	}
+
+
+
 	void TestCollectionCustomizability()
 	{
 		Greet("Custom collection parameters");
 
 		CustomHashes();
 		CustomLists();
+		SmallLists();
+		FlatHashes();
+		SortedDictionaries();
 		CustomDictionaries();
+		ArenaCaches();
+		HugePages();
+#	if TEST_PMR
+		PmrAllocators();
+#	endif
+#	if ENUMERABLES_USE_PMR
+		PmrResources();
+#	endif
 	}
 
 }	// namespace EnumerableTests
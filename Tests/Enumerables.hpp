@@ -31,8 +31,19 @@
 // #define ENUMERABLES_INTERFACED_ETOR_INLINE_SIZE	0
 
 
+// Multi-process evaluation is available on POSIX platforms.
+#if defined(__unix__) || defined(__APPLE__)
+	#define ENUMERABLES_USE_MULTIPROCESS		true
+#endif
+
+
 // Custom container bindings can be defined and set here.
 // #define ENUMERABLES_SMALLLIST_BINDING			MyBindings::SomeLibrarySmallListBinding
+// #define ENUMERABLES_USE_PMR					true
+// #define ENUMERABLES_USE_HUGEPAGES			true
+// #define ENUMERABLES_SET_BINDING				Enumerables::FlatBinding::SetOperations
+// #define ENUMERABLES_DICTIONARY_BINDING		Enumerables::FlatBinding::DictionaryOperations
+// #define ENUMERABLES_DICTIONARY_BINDING		Enumerables::FlatBinding::AutoDictionaryOperations
 
 
 
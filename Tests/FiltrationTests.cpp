@@ -2,6 +2,10 @@
 #include "Tests.hpp"
 #include "TestUtils.hpp"
 #include "Enumerables.hpp"
+#include <cmath>
+#include <limits>
+#include <list>
+#include <vector>
 
 
 
@@ -652,6 +656,172 @@ namespace EnumerableTests {
 
 
 
+	// Simple predicates filter contiguous data by vectorized kernels when collected - check each instruction set available.
+	static void SimplePredicates()
+	{
+		using namespace Enumerables::Predicates;
+		using Enumerables::SimdLevel;
+		using Enumerables::AreEqual;
+		using Enumerables::Def::ActiveSimdLevel;
+
+		struct Record {
+			int		key;
+			double	value;
+		};
+
+		std::vector<int>		  ints;
+		std::vector<long long>	  longs;
+		std::vector<float>		  floats;
+		std::vector<double>		  doubles;
+		std::vector<Record>		  records;
+		for (int i = 0; i < 1003; ++i) {
+			ints.push_back(i % 97 - 40);
+			longs.push_back((i % 2 ? -1ll : 1ll) << (i % 60));
+			floats.push_back(static_cast<float>(i % 13) * 0.1f);
+			doubles.push_back(std::sin(i));
+			records.push_back({ i % 10, 1.0 / (i + 1) });
+		}
+		doubles[100] = std::numeric_limits<double>::quiet_NaN();
+
+		// usable as ordinary callables too
+		ASSERT	  (Greater(3)(4) && !Greater(3)(3));
+		ASSERT	  ((Less(0) || GreaterEqual(10))(10));
+		ASSERT_EQ (10, Enumerate(ints).Count(Equal(0)));
+		ASSERT_EQ (52, Enumerate(ints).Where(GreaterEqual(50) && Less(53)).First(Greater(51)));
+
+		// opaque to the kernels
+		auto sequential = [](auto& v) { return Enumerate(v).Where(FUN(x, true)); };
+
+		const SimdLevel detected = ActiveSimdLevel();
+		for (SimdLevel level : { detected, SimdLevel::Sse2, SimdLevel::Scalar }) {
+			if (level > detected)
+				continue;
+
+			ActiveSimdLevel() = level;
+
+			ASSERT (AreEqual(sequential(ints).Where(FUN(x, x > 0)),							Enumerate(ints).Where(Greater(0)).ToList()));
+			ASSERT (AreEqual(sequential(ints).Where(FUN(x, x <= -3 || x == 7)),				Enumerate(ints).Where(LessEqual(-3) || Equal(7)).ToList()));
+			ASSERT (AreEqual(sequential(ints).Where(FUN(x, x >= 0 && x != 5)),				Enumerate(ints).Where(GreaterEqual(0) && NotEqual(5)).ToList()));
+			ASSERT (AreEqual(sequential(longs).Where(FUN(x, x < 1000)),						Enumerate(longs).Where(Less(1000)).ToList()));
+			ASSERT (AreEqual(sequential(floats).Where(FUN(x, x >= 0.5f)),					Enumerate(floats).Where(GreaterEqual(0.5f)).ToList()));
+			ASSERT (AreEqual(sequential(records).Select(&Record::key).Where(FUN(x, x < 3)), Enumerate(records).Select(&Record::key).Where(Less(3)).ToList()));
+			ASSERT_EQ (sequential(ints).Where(FUN(x, x < 0)).ToSet().size(),				Enumerate(ints).Where(Less(0)).ToSet().size());
+
+			// NaN satisfies only !=
+			ASSERT_EQ (sequential(doubles).Where(FUN(x, x < 0.5)).Count(),	Enumerate(doubles).Where(Less(0.5)).ToList().size());
+			ASSERT_EQ (sequential(doubles).Where(FUN(x, x != 0.5)).Count(), Enumerate(doubles).Where(NotEqual(0.5)).ToList().size());
+
+			// by data member, whole objects collected
+			auto selected = Enumerate(records).Where(Equal(&Record::key, 3) && Greater(&Record::value, 0.001)).ToList();
+			ASSERT_EQ (100, selected.size());
+			ASSERT	  (Enumerate(selected).All(FUN(r, r.key == 3)));
+
+			// tails and empty sources
+			ASSERT (AreEqual({ -40, -39 },	Enumerate(ints.data(), ints.data() + 3).Where(Less(-38)).ToList()));
+			ASSERT (Enumerate(ints.data(), ints.data()).Where(Less(0)).ToList().empty());
+		}
+		ActiveSimdLevel() = detected;
+
+		// sources without a contiguous view: evaluated elementwise
+		{
+			const std::list<int>	intList (ints.begin(), ints.end());
+			const std::list<Record>	recordList (records.begin(), records.end());
+
+			ASSERT (AreEqual(sequential(ints).Where(FUN(x, x > 2)),						Enumerate(intList).Where(Greater(2)).ToList()));
+			ASSERT (AreEqual({ 3, 4, 5, 6 },											Enumerables::Range<int>(0, 7).Where(Greater(2)).ToList()));
+			ASSERT (AreEqual(sequential(ints).Select(FUN(x, x * 2)).Where(FUN(x, x < 0)),	Enumerate(ints).Select(FUN(x, x * 2)).Where(Less(0)).ToList()));
+			ASSERT (AreEqual(sequential(ints).Where(FUN(x, x % 2 == 0 && x >= 7)),		Enumerate(ints).Where(FUN(x, x % 2 == 0)).Where(GreaterEqual(7)).ToList()));
+			ASSERT_EQ (100, Enumerate(recordList).Where(Equal(&Record::key, 3) && Greater(&Record::value, 0.001)).ToList().size());
+		}
+	}
+
+
+
+	// Equality searches compare contiguous scalars by vectorized kernels - check each instruction set available.
+	static void VectorizedEquality()
+	{
+		using Enumerables::SimdLevel;
+		using Enumerables::Def::ActiveSimdLevel;
+
+		enum class Color : short { Red, Green, Blue };
+
+		struct Record {
+			int		key;
+			double	value;
+		};
+
+		std::vector<signed char>  bytes;
+		std::vector<Color>		  colors;
+		std::vector<long long>	  longs;
+		std::vector<double>		  doubles;
+		std::vector<const int*>	  pointers;
+		std::vector<Record>		  records;
+		const int				  targets[] = { 1, 2, 3 };
+		for (int i = 0; i < 1003; ++i) {
+			bytes.push_back(static_cast<signed char>(i % 100));
+			colors.push_back(i == 700 ? Color::Blue : static_cast<Color>(i % 2));
+			longs.push_back(3ll << 40);
+			doubles.push_back(i * 0.5);
+			pointers.push_back(targets + i % 3);
+			records.push_back({ i % 10, 0.0 });
+		}
+		doubles[2]	 = std::numeric_limits<double>::quiet_NaN();
+		doubles[999] = -0.0;
+		pointers[5]	 = nullptr;
+
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+
+		// opaque to the kernels
+		auto sequential = [](auto& v) { return Enumerate(v).Where(FUN(x, true)); };
+
+		const SimdLevel detected = ActiveSimdLevel();
+		for (SimdLevel level : { detected, SimdLevel::Sse2, SimdLevel::Scalar }) {
+			if (level > detected)
+				continue;
+
+			ActiveSimdLevel() = level;
+
+			ASSERT_EQ (10,	 Enumerate(bytes).Count(static_cast<signed char>(3)));
+			ASSERT_EQ (99u,	*Enumerate(bytes).IndexOf(static_cast<signed char>(99)));
+			ASSERT	  (!Enumerate(bytes).IndexOf(static_cast<signed char>(100)).HasValue());
+			ASSERT	  (!Enumerate(bytes).Contains(static_cast<signed char>(-1)));
+
+			ASSERT_EQ (700u, *Enumerate(colors).IndexOf(Color::Blue));
+			ASSERT_EQ (sequential(colors).Count(Color::Red), Enumerate(colors).Count(Color::Red));
+			ASSERT	  (!Enumerate(colors).AllEqual());
+
+			ASSERT	  (Enumerate(longs).AllEqual());
+			ASSERT	  (Enumerate(longs).AllEqual(3ll << 40));
+			ASSERT	  (!Enumerate(longs).AllEqual(3ll << 41));
+
+			// NaN equals nothing, -0.0 equals 0.0
+			ASSERT	  (!Enumerate(doubles).Contains(nan));
+			ASSERT_EQ (0u,	 *Enumerate(doubles).IndexOf(-0.0));
+			ASSERT_EQ (2,	 Enumerate(doubles).Count(0.0));
+			ASSERT_EQ (500u, *Enumerate(doubles).IndexOf(250.0));
+			ASSERT	  (!Enumerate(doubles.data() + 2, doubles.data() + 3).AllEqual(nan));
+			ASSERT	  (Enumerate(doubles.data() + 2, doubles.data() + 3).AllEqual());
+
+			ASSERT_EQ (5u, *Enumerate(pointers).IndexOf(nullptr));
+			ASSERT_EQ (sequential(pointers).Count(pointers[3]), Enumerate(pointers).Count(pointers[3]));
+
+			// by data member
+			ASSERT_EQ (100, Enumerate(records).Select(&Record::key).Count(7));
+			ASSERT_EQ (7u, *Enumerate(records).Select(&Record::key).IndexOf(7));
+			ASSERT	  (Enumerate(records).Select(&Record::value).AllEqual(0.0));
+
+			// tails and empty sources
+			ASSERT_EQ (2u, *Enumerate(bytes.data(), bytes.data() + 3).IndexOf(static_cast<signed char>(2)));
+			ASSERT	  (Enumerate(longs.data(), longs.data() + 1).AllEqual());
+			ASSERT	  (Enumerate(longs.data(), longs.data()).AllEqual());
+			ASSERT	  (!Enumerate(doubles.data(), doubles.data()).Contains(0.0));
+			ASSERT_EQ (0, Enumerate(doubles.data(), doubles.data()).Count(0.0));
+		}
+		ActiveSimdLevel() = detected;
+	}
+
+
+
 	void TestFiltration()
 	{
 		Greet("Filtrations");
@@ -663,6 +833,8 @@ namespace EnumerableTests {
 		ConditionalSubrange();
 		TerminalOperators();
 		Shorthands();
+		SimplePredicates();
+		VectorizedEquality();
 	}
 
 }	// namespace EnumerableTests
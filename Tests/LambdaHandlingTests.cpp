@@ -2,6 +2,7 @@
 #include "Tests.hpp"
 #include "TestUtils.hpp"
 #include "Enumerables.hpp"
+#include <list>
 #include <memory>
 
 
@@ -711,6 +712,60 @@ namespace EnumerableTests {
 
 
 
+	// Placeholder expressions are ordinary callables, while the library can inspect them.
+	static void PlaceholderExpressions()
+	{
+		using namespace Enumerables::Placeholders;
+		using Enumerables::Predicates::IsSimplePredicate;
+
+		std::vector<int>		ints;
+		std::vector<double>		doubles;
+		std::vector<IntHolder>	holders;
+		for (int i = 0; i < 300; ++i) {
+			ints.push_back(i % 17 - 8);
+			doubles.push_back(i * 0.25);
+			holders.push_back({ i % 5, i });
+		}
+
+		ASSERT_EQ (19,	(_1 * _1 + 3)(4));
+		ASSERT_EQ (4,	(_2 - _1)(1, 5));
+		ASSERT_EQ (-7,	(-_1)(7));
+		ASSERT	  ((!(_1 * 2 > 5))(2));
+
+		// argument vs. value comparisons become simple predicates
+		static_assert (IsSimplePredicate<decltype(_1 > 0)>::value,							"Expected simple predicate.");
+		static_assert (IsSimplePredicate<decltype(3 <= _1 && _1->*&IntHolder::data < 2)>::value, "Expected simple predicate.");
+		static_assert (!IsSimplePredicate<decltype(_1 * 2 > 0)>::value,						"Expected generic expression.");
+
+		ASSERT (AreEqual(Enumerate(ints).Where(FUN(x,  x > 0)),						Enumerate(ints).Where(_1 > 0)));
+		ASSERT (AreEqual(Enumerate(ints).Where(FUN(x,  -2 < x && x % 2 == 0)),		Enumerate(ints).Where(-2 < _1 && _1 % 2 == 0).ToList()));
+		ASSERT (AreEqual(Enumerate(ints).Select(FUN(x,  x * x + 3)),				Enumerate(ints).Select(_1 * _1 + 3).ToList()));
+		ASSERT (AreEqual(Enumerate(ints).MapNeighbors(FUN(p, n,  n - p)),			Enumerate(ints).MapNeighbors(_2 - _1).ToList()));
+		ASSERT (AreEqual(Enumerate(holders).Where(FUN(h,  h.data == 3)).Select(FUN(h,  h.constData)),
+						 Enumerate(holders).Where(_1->*&IntHolder::data == 3).Select(_1->*&IntHolder::constData)));
+
+		ASSERT_EQ (Enumerate(ints).Select(FUN(x,  x * x + 3)).Sum(),				Enumerate(ints).Select(_1 * _1 + 3).Sum());
+		ASSERT_EQ (Enumerate(doubles).Select(FUN(x,  x / 2.0 - 1.0)).Sum(),			Enumerate(doubles).Select(_1 / 2.0 - 1.0).Sum());
+		ASSERT_EQ (Enumerate(ints).Aggregate(FUN(a, x,  a + x * 2)),				Enumerate(ints).Aggregate(_1 + _2 * 2));
+		ASSERT_EQ (Enumerate(holders).Count(FUN(h,  h.data == 4)),					Enumerate(holders).Count(_1->*&IntHolder::data == 4));
+
+		// sources without a contiguous view take the same predicates
+		const std::list<int> intList (ints.begin(), ints.end());
+
+		ASSERT (AreEqual(Enumerate(ints).Where(FUN(x,  x > 3)),						Enumerate(intList).Where(_1 > 3).ToList()));
+		ASSERT (AreEqual({ 4, 5, 6 },												Enumerables::Range<int>(0, 7).Where(_1 > 3).ToList()));
+		ASSERT (AreEqual(Enumerate(ints).Select(FUN(x,  x * 3)).Where(FUN(x,  x <= 6)),	Enumerate(ints).Select(_1 * 3).Where(_1 <= 6).ToList()));
+		ASSERT_EQ (Enumerate(holders).Count(FUN(h,  h.data == 3)),					Enumerate(holders).Where(FUN(h,  h.data > 2)).Where(_1->*&IntHolder::data == 3).Count());
+
+		// member access preserves references
+		auto datas = Enumerate(holders).Select(_1->*&IntHolder::data);
+
+		ASSERT_ELEM_TYPE (int&,	datas);
+		ASSERT_EQ		 (&holders[7].data, &datas.ElementAt(7).Value());
+	}
+
+
+
 	void TestLambdaUsage()
 	{
 		Greet("Lambda usage");
@@ -722,6 +777,7 @@ namespace EnumerableTests {
 		BinaryMappers();
 		Predicates();
 		CaptureTest();
+		PlaceholderExpressions();
 	}
 
 }	// namespace EnumerableTests
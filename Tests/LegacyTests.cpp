@@ -385,8 +385,8 @@ namespace Legacy {
 		std::cout << std::endl;
 
 		std::vector<int> list1 = numbers.ToList();
-		std::vector<int> list2 = numbers.ToList<10>();	// test SmallList fallback
-		ASSERT_EQ (list1, list2);
+		auto			 list2 = numbers.ToList<10>();	// test SmallList
+		ASSERT_EQ (list1, std::vector<int>(list2.begin(), list2.end()));
 		ASSERT_EQ (numbers.Count(), list1.size());
 		ASSERT_EQ (numbers.First(), list1.front());
 		ASSERT_EQ (numbers.Last(), list1.back());
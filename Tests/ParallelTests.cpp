@@ -0,0 +1,714 @@
+
+#include "Tests.hpp"
+#include "TestUtils.hpp"
+#include "Enumerables.hpp"
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+
+
+namespace EnumerableTests {
+
+	// sizes well above ENUMERABLES_PARALLEL_MIN_CHUNK to actually get split
+	static const size_t LongLength = 20000;
+
+	// own workers to get split regardless of the hardware
+	static Enumerables::IExecutor& TestPool()
+	{
+		static Enumerables::WorkStealingExecutor pool { 3 };
+		return pool;
+	}
+
+	template <class Eb>
+	static auto AsParallel4(Eb&& eb)
+	{
+		return std::forward<Eb>(eb).AsParallel().WithExecutor(TestPool()).WithDegreeOfParallelism(4);
+	}
+
+
+
+	// Runs tasks only on the waiting threads - submitting as many as allowed.
+	class RecordingExecutor final : public Enumerables::IExecutor {
+		std::mutex						lock;
+		std::vector<Enumerables::ITask*>	queue;
+
+	public:
+		size_t	submitted = 0;
+
+		size_t	Concurrency()	 const override	{ return 4; }
+		bool	WantsMoreTasks() const override	{ return true; }
+
+		void	Submit(Enumerables::ITask& task) override
+		{
+			std::lock_guard<std::mutex> guard { lock };
+			queue.push_back(&task);
+			++submitted;
+		}
+
+		bool	RunPendingTask() override
+		{
+			Enumerables::ITask* task = nullptr;
+			{
+				std::lock_guard<std::mutex> guard { lock };
+				if (queue.empty())
+					return false;
+
+				task = queue.back();
+				queue.pop_back();
+			}
+			task->Execute();
+			return true;
+		}
+	};
+
+
+
+	static void ParallelSources()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+
+		// random-access containers
+		{
+			auto par = Enumerate(vec).AsParallel();
+			ASSERT_EQ (LongLength, par.Count());
+			ASSERT_EQ (Enumerate(vec).Sum(), par.Sum());
+		}
+
+		// Range, RangeDown
+		{
+			auto par = AsParallel4(Enumerables::Range<long long>(1, LongLength));
+			ASSERT_EQ (LongLength,						par.Count());
+			ASSERT_EQ (LongLength * (LongLength + 1) / 2,	par.Sum());
+
+			auto down = AsParallel4(Enumerables::RangeDown<int>(-1, LongLength)).ToList();
+			ASSERT_EQ (Enumerables::RangeDown<int>(-1, LongLength).ToList(), down);
+		}
+
+		// IndexRange, IndexRangeReversed
+		{
+			auto idx = AsParallel4(Enumerables::IndexRange(vec)).ToList();
+			auto rev = AsParallel4(Enumerables::IndexRangeReversed(vec)).ToList();
+
+			ASSERT_EQ (Enumerables::IndexRange(vec).ToList(),		  idx);
+			ASSERT_EQ (Enumerables::IndexRangeReversed(vec).ToList(), rev);
+		}
+
+		// caching operation - evaluated upfront
+		{
+			auto ordered = Enumerate(vec).OrderBy(FUN(x, -x));
+			ASSERT_EQ (ordered.ToList(), AsParallel4(ordered).ToList());
+		}
+
+		// owned container
+		{
+			auto owning = AsParallel4(Enumerate(std::vector<int>(vec)));
+			ASSERT_EQ (vec, owning.ToList());
+		}
+
+		// empty and short inputs
+		{
+			std::vector<int> empty;
+			ASSERT_EQ (0, AsParallel4(Enumerate(empty)).Count());
+			ASSERT_EQ (0, AsParallel4(Enumerate(empty)).Sum());
+			ASSERT	  (!AsParallel4(Enumerate(empty)).Any());
+			ASSERT	  (!AsParallel4(Enumerate(empty)).Min().HasValue());
+			ASSERT	  (AsParallel4(Enumerate(empty)).ToList().empty());
+
+			ASSERT_EQ (10, AsParallel4(Enumerables::Range(1, 4)).Sum());
+		}
+	}
+
+
+
+	static void ParallelPipelines()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+
+		auto seqQuery = Enumerate(vec).Where(FUN(x, x % 3 == 0)).Map(FUN(x, x * 2));
+		auto parQuery = AsParallel4(Enumerate(vec)).Where(FUN(x, x % 3 == 0)).Map(FUN(x, x * 2));
+
+		ASSERT_EQ (seqQuery.Count(),  parQuery.Count());
+		ASSERT_EQ (seqQuery.Sum(),	  parQuery.Sum());
+		ASSERT_EQ (seqQuery.ToList(), parQuery.ToList());
+		ASSERT	  (EqualSets(seqQuery.ToSet(), parQuery.ToSet()));
+
+		// AsSequential continues with the same operations applied
+		ASSERT_EQ (seqQuery.ToList(), parQuery.AsSequential().ToList());
+
+		// degree of parallelism doesn't affect results
+		ASSERT_EQ (seqQuery.ToList(), parQuery.WithDegreeOfParallelism(1).ToList());
+		ASSERT_EQ (seqQuery.ToList(), parQuery.WithDegreeOfParallelism(3).ToList());
+
+		// references are preserved
+		auto addresses = AsParallel4(Enumerate(vec)).Addresses().ToList();
+		ASSERT_EQ (LongLength, addresses.size());
+		ASSERT_EQ (&vec.front(), addresses.front());
+		ASSERT_EQ (&vec.back(),  addresses.back());
+
+		// projections and conversions
+		struct Item {
+			int		id;
+			double	weight;
+		};
+		std::vector<Item> items = Enumerables::Range<int>(0, LongLength).MapTo<Item>(FUN(i, (Item { i, i * 0.5 }))).ToList();
+
+		ASSERT_EQ (Enumerate(items).Select(&Item::id).Sum(),
+				   AsParallel4(Enumerate(items)).Select(&Item::id).Sum());
+		ASSERT_EQ (Enumerate(items).Select(&Item::weight).Cast<int>().ToList(),
+				   AsParallel4(Enumerate(items)).Select(&Item::weight).Cast<int>().ToList());
+	}
+
+
+
+	static void ParallelTerminals()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).Map(FUN(x, (x * 7919) % 10007)).ToList();
+
+		// Any / All with early exit
+		auto par = AsParallel4(Enumerate(vec));
+		ASSERT	  (par.Any());
+		ASSERT	  (par.Any(FUN(x, x == 10006)));
+		ASSERT	  (!par.Any(FUN(x, x < 0)));
+		ASSERT	  (par.All(FUN(x, x >= 0)));
+		ASSERT	  (!par.All(FUN(x, x != 500)));
+
+		// Min / Max: first extreme wins, like sequentially
+		struct Entry {
+			int key;
+			int pos;
+		};
+		std::vector<Entry> entries = Enumerables::Range<int>(0, LongLength).MapTo<Entry>(FUN(i, (Entry { i % 1000, i }))).ToList();
+
+		auto byKey = FUN(a, b, a.key < b.key);
+		ASSERT_EQ (0,	AsParallel4(Enumerate(entries)).Min(byKey)->pos);
+		ASSERT_EQ (999, AsParallel4(Enumerate(entries)).Max(byKey)->pos);
+		ASSERT_EQ (Enumerate(vec).Min().Value(), par.Min().Value());
+		ASSERT_EQ (Enumerate(vec).Max().Value(), par.Max().Value());
+
+		// Avg
+		std::vector<double> fracs = Enumerables::Range<int>(1, LongLength).Map(FUN(x, 1.0 / x)).ToList();
+		double seqAvg = Enumerate(fracs).Avg().Value();
+		double parAvg = AsParallel4(Enumerate(fracs)).Avg().Value();
+		ASSERT (std::abs(seqAvg - parAvg) < 1e-15);
+		ASSERT (!AsParallel4(Enumerate(std::vector<double> {})).Avg().HasValue());
+
+		// floating-point Sum/Avg are bit-identical, however the work is split
+		{
+			std::vector<double> mixed = Enumerables::Range<int>(0, LongLength).Map(FUN(x, (x % 2 ? 1e8 : -1e-3) / (x % 7 + 1))).ToList();
+			auto query = Enumerate(mixed).AsParallel().Where(FUN(x, x != 0.5));
+
+			const double sum = query.WithExecutor(TestPool()).Sum();
+			const double avg = query.WithExecutor(TestPool()).Avg().Value();
+			for (size_t degree = 1; degree <= 4; ++degree) {
+				ASSERT (sum == query.WithExecutor(TestPool()).WithDegreeOfParallelism(degree).Sum());
+				ASSERT (avg == query.WithExecutor(TestPool()).WithDegreeOfParallelism(degree).Avg().Value());
+			}
+			RecordingExecutor recorder;
+			ASSERT (sum == query.Sum());
+			ASSERT (sum == query.WithExecutor(recorder).Sum());
+		}
+
+		// ToDictionary: on duplicated keys the first element is kept, like sequentially
+		auto seqDict = Enumerate(entries).ToDictionary(&Entry::key);
+		auto parDict = AsParallel4(Enumerate(entries)).ToDictionary(FUN(e, e.key));
+		ASSERT_EQ (seqDict.size(), parDict.size());
+		ASSERT (Enumerate(seqDict).All(FUN(kv, parDict.at(kv.first).pos == kv.second.pos)));
+
+		auto posDict = AsParallel4(Enumerate(entries)).ToDictionary(FUN(e, e.key), FUN(e, e.pos));
+		ASSERT_EQ (1000, posDict.size());
+		ASSERT_EQ (5,	 posDict.at(5));
+
+		// sharded lookups: same content, independent of the shard count
+		for (size_t shards : { 0, 1, 7 }) {
+			auto shardedDict = AsParallel4(Enumerate(entries)).ToShardedDictionary(FUN(e, e.key), FUN(e, e.pos), shards);
+			ASSERT_EQ (1000, shardedDict.Count());
+			ASSERT	  (shardedDict.Contains(999));
+			ASSERT	  (!shardedDict.Contains(1000));
+			ASSERT_EQ (5,	 shardedDict.At(5));
+			ASSERT	  (Enumerate(seqDict).All(FUN(kv, shardedDict.At(kv.first) == kv.second.pos)));
+
+			auto shardedSet = AsParallel4(Enumerate(vec)).ToShardedSet(shards);
+			ASSERT_EQ (Enumerate(vec).ToSet().size(), shardedSet.Count());
+			ASSERT	  (Enumerate(vec).All(FUN(x, shardedSet.Contains(x) && shardedSet.ShardOf(x).count(x) == 1)));
+			ASSERT	  (!shardedSet.Contains(-1));
+			ASSERT	  (EqualSets(Enumerate(vec).ToSet(), shardedSet.Merge()));
+		}
+		{
+			auto shardedDict = AsParallel4(Enumerate(entries)).ToShardedDictionary(FUN(e, e.key), FUN(e, e.pos), 16);
+			ASSERT_EQ (16, shardedDict.ShardCount());
+			ASSERT_THROW  (Enumerables::LogicException, shardedDict.At(-1));
+			ASSERT		  (!shardedDict.Contains(-1));
+
+			auto merged = std::move(shardedDict).Merge();
+			ASSERT_EQ (1000, merged.size());
+			ASSERT_EQ (999,	 merged.at(999));
+		}
+	}
+
+
+
+	static void ParallelAggregates()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).Map(FUN(x, (x * 7919) % 10007)).ToList();
+
+		// histogram
+		using Histogram = std::vector<size_t>;
+		auto count = [](Histogram&& h, int x)			{ ++h[x / 1000]; return move(h); };
+		auto merge = [](Histogram&& l, Histogram&& r)	{ for (size_t i = 0; i < l.size(); ++i) l[i] += r[i]; return move(l); };
+
+		Histogram seqHist = Enumerate(vec).Aggregate(Histogram(11), count);
+		Histogram parHist = AsParallel4(Enumerate(vec)).Aggregate(Histogram(11), count, merge);
+		ASSERT_EQ (seqHist, parHist);
+		ASSERT_EQ (LongLength, Enumerate(parHist).Sum());
+
+		// order of merged partials is kept
+		auto concat = [](std::string&& l, std::string&& r)	{ return move(l) + r; };
+		auto append = [](std::string&& s, int x)			{ return move(s) + char('a' + x % 26); };
+
+		std::string seqStr = Enumerate(vec).Aggregate(std::string {}, append);
+		ASSERT_EQ (seqStr, AsParallel4(Enumerate(vec)).Aggregate(std::string {}, append, concat));
+
+		// forced accumulator type, empty input
+		ASSERT_EQ (5.5, AsParallel4(Enumerate(std::vector<int> {})).Aggregate<double>(5.5, std::plus<>(), std::plus<>()));
+
+		// grouped statistics
+		struct Stats {
+			size_t	count = 0;
+			int		max	  = 0;
+		};
+		auto add   = [](Stats&& s, int x)		{ return Stats { s.count + 1, std::max(s.max, x) }; };
+		auto unite = [](Stats&& l, Stats&& r)	{ return Stats { l.count + r.count, std::max(l.max, r.max) }; };
+
+		auto groups = AsParallel4(Enumerate(vec)).AggregateBy(FUN(x, x % 10), Stats {}, add, unite);
+		ASSERT_EQ (10, groups.size());
+		for (auto& kv : groups) {
+			auto members = Enumerate(vec).Where(FUN(x, x % 10 == kv.first));
+			ASSERT_EQ (members.Count(),		   kv.second.count);
+			ASSERT_EQ (members.Max().Value(), kv.second.max);
+		}
+
+		// many keys, reduced per hash-partition: the order of merges is kept within each key
+		auto seqStrs = Enumerate(vec).Aggregate(std::map<int, std::string> {}, [&append](std::map<int, std::string>&& m, int x) {
+			m[x % 3000] = append(move(m[x % 3000]), x);
+			return move(m);
+		});
+		for (size_t shards : { 0, 1, 5 }) {
+			auto sharded = AsParallel4(Enumerate(vec)).ShardedAggregateBy(FUN(x, x % 3000), std::string {}, append, concat, shards);
+			ASSERT_EQ (3000, sharded.Count());
+			ASSERT	  (Enumerate(seqStrs).All(FUN(kv, sharded.At(kv.first) == kv.second)));
+		}
+		auto strs = AsParallel4(Enumerate(vec)).AggregateBy(FUN(x, x % 3000), std::string {}, append, concat);
+		ASSERT_EQ (3000, strs.size());
+		ASSERT	  (Enumerate(seqStrs).All(FUN(kv, strs.at(kv.first) == kv.second)));
+
+		// GroupBy
+		auto grouped = AsParallel4(Enumerate(vec)).GroupBy(FUN(x, x % 7));
+		ASSERT_EQ (7, grouped.size());
+		for (auto& kv : grouped)
+			ASSERT_EQ (Enumerate(vec).Where(FUN(x, x % 7 == kv.first)).ToList(), kv.second);
+
+		ASSERT (AsParallel4(Enumerate(std::vector<int> {})).GroupBy(FUN(x, x)).empty());
+	}
+
+
+
+	static void ParallelScan()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).Map(FUN(x, (x * 7919) % 10007)).ToList();
+
+		// cumulative sums
+		auto seqSums = Enumerate(vec).Scan<long long>(0ll, FUN(acc, x, acc + x)).ToList();
+		auto parSums = AsParallel4(Enumerate(vec)).Scan<long long>(std::plus<>()).ToList();
+		ASSERT_EQ (seqSums, parSums);
+
+		// order is kept for non-commutative combiners, filtered blocks may be empty
+		auto	  letters = AsParallel4(Enumerate(vec)).Where(FUN(x, x < 30)).Map(FUN(x, std::string(1, char('a' + x % 26))));
+		auto	  seqCat  = letters.AsSequential().Scan(FUN(l, r, l + r)).ToList();
+		auto	  parCat  = letters.Scan(FUN(l, r, l + r)).ToList();
+		ASSERT_EQ (seqCat, parCat);
+
+		// lazy, cached results can be partitioned again
+		auto scanned = AsParallel4(Enumerables::Range<long long>(1, LongLength)).Scan(std::plus<>());
+		ASSERT_EQ (LongLength * (LongLength + 1) / 2, scanned.Last());
+		ASSERT_EQ (scanned.Sum(), AsParallel4(scanned).Sum());
+
+		ASSERT (AsParallel4(Enumerate(std::vector<int> {})).Scan(std::plus<>()).ToList().empty());
+
+		// the enumerator owns the query, may outlive the AutoEnumerable
+		auto detached = AsParallel4(Enumerate(vec)).Scan<long long>(std::plus<>()).GetEnumerator();
+		std::vector<long long> detachedSums;
+		while (detached.FetchNext())
+			detachedSums.push_back(detached.Current());
+		ASSERT_EQ (seqSums, detachedSums);
+	}
+
+
+
+	static void ParallelExceptions()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+
+		auto throwing = AsParallel4(Enumerate(vec)).Map([](int x) -> int {
+			if (x == LongLength - 1)
+				throw std::runtime_error("last element");
+			return x;
+		});
+
+		ASSERT_THROW (std::runtime_error, throwing.Sum());
+		ASSERT_THROW (std::runtime_error, throwing.ToList());
+	}
+
+
+
+	static void BufferedStage()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+
+		// same results, references preserved
+		auto mapped = Enumerate(vec).Map(FUN(x, std::to_string(x)));
+		ASSERT_EQ (mapped.ToList(), mapped.Buffered(8).ToList());
+		ASSERT_EQ (mapped.ToList(), mapped.Buffered(1).ToList());
+		ASSERT_EQ (&vec[0],		   Enumerate(vec).Buffered(4).Addresses().First());
+		ASSERT_EQ (LongLength,	   Enumerate(vec).Buffered().Count());
+		ASSERT	  (!Enumerate(std::vector<int> {}).Buffered().Any());
+		ASSERT_EQ (vec,			   Enumerate(vec).Buffered(8, &TestPool()).ToList());
+
+		// executor without workers gets helped by the consumer, the producer pauses while the buffer is full
+		{
+			RecordingExecutor recorder;
+			ASSERT_EQ (mapped.ToList(), mapped.Buffered(16, &recorder).ToList());
+			ASSERT	  (recorder.submitted >= LongLength / 16);
+		}
+
+		// exceptions are rethrown in order
+		{
+			auto throwing = Enumerate(vec).Map([](int x) -> int {
+				if (x == 100)
+					throw std::runtime_error("element 100");
+				return x;
+			});
+			auto   et		 = throwing.Buffered(16).GetEnumerator();
+			size_t received  = 0;
+			bool   thrown	 = false;
+			try {
+				while (et.FetchNext()) {
+					ASSERT_EQ (received, et.Current());
+					++received;
+				}
+			}
+			catch (const std::runtime_error&) {
+				thrown = true;
+			}
+			ASSERT	  (thrown);
+			ASSERT_EQ (100, received);
+		}
+
+		// an abandoned infinite producer gets stopped
+		{
+			std::atomic<size_t> produced { 0 };
+			auto infinite = Enumerables::Sequence(0, FUN(x, x + 1)).Map([&produced](int x) { ++produced; return x; });
+
+			ASSERT_EQ ((std::vector<int> { 0, 1, 2, 3, 4 }), infinite.Buffered(16).Take(5).ToList());
+			ASSERT	  (produced.load() <= 5 + 16 + 1);
+		}
+	}
+
+
+
+	static void ParallelExecutors()
+	{
+		// Chase-Lev deque: each item is received exactly once by the owner or a thief
+		{
+			const size_t	   n = 100000;
+			std::vector<int>   items (n, 0);
+			std::vector<int>   received (n, 0);
+			std::atomic<bool>  done { false };
+
+			Enumerables::Def::WorkStealingDeque<int> deque { 2 };
+
+			auto receive = [&](int* item) { ++received[item - items.data()]; };
+
+			std::vector<std::thread> thieves;
+			for (int t = 0; t < 3; ++t) {
+				thieves.emplace_back([&]() {
+					std::vector<int*> stolen;
+					while (!done.load() || !deque.IsEmpty()) {
+						if (int* item = deque.Steal())
+							stolen.push_back(item);
+					}
+					static std::mutex m;
+					std::lock_guard<std::mutex> guard { m };
+					for (int* item : stolen)
+						receive(item);
+				});
+			}
+			std::vector<int*> taken;
+			for (size_t i = 0; i < n; ++i) {
+				deque.Push(&items[i]);
+				if (i % 3 == 0) {
+					if (int* item = deque.Take())
+						taken.push_back(item);
+				}
+			}
+			while (int* item = deque.Take())
+				taken.push_back(item);
+
+			done.store(true);
+			for (std::thread& t : thieves)
+				t.join();
+
+			for (int* item : taken)
+				receive(item);
+
+			ASSERT (Enumerate(received).All(FUN(r, r == 1)));
+		}
+
+		// ParallelFor covers the range with disjoint pieces
+		{
+			std::mutex						  lock;
+			std::vector<std::pair<size_t, size_t>> pieces;
+
+			Enumerables::Def::ParallelFor(TestPool(), LongLength, 100, 4, [&](size_t b, size_t e) {
+				std::lock_guard<std::mutex> guard { lock };
+				pieces.emplace_back(b, e);
+			});
+
+			std::sort(pieces.begin(), pieces.end());
+			ASSERT_EQ (0,		   pieces.front().first);
+			ASSERT_EQ (LongLength, pieces.back().second);
+			ASSERT (pieces.size() > 1);
+			ASSERT (Enumerate(pieces).MapNeighbors(FUN(a, b, a.second == b.first)).All(FUN(x, x)));
+		}
+
+		// injected executor
+		{
+			RecordingExecutor recorder;
+
+			std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+			auto parQuery = Enumerate(vec).AsParallel().WithExecutor(recorder).Where(FUN(x, x % 5 == 0));
+
+			ASSERT_EQ (Enumerate(vec).Where(FUN(x, x % 5 == 0)).ToList(), parQuery.ToList());
+			ASSERT	  (recorder.submitted > 0);
+		}
+
+		// skewed selectivity: matches concentrated at the end get rebalanced, still ordered
+		{
+			std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+			auto skewed = [](int x) {
+				if (x < static_cast<int>(LongLength * 3 / 4))
+					return false;
+
+				double acc = 0.0;
+				for (int i = 0; i < 50; ++i)
+					acc += std::sqrt(x + i);
+				return acc > 0.0;
+			};
+
+			ASSERT_EQ (Enumerate(vec).Where(skewed).ToList(), AsParallel4(Enumerate(vec)).Where(skewed).ToList());
+			ASSERT_EQ (Enumerate(vec).Where(skewed).ToList(), Enumerate(vec).AsParallel().Where(skewed).ToList());
+		}
+	}
+
+
+
+	static void FlattenParallelStage()
+	{
+		std::vector<std::vector<int>> nested;
+		for (int i = 0; i < 40; ++i)
+			nested.push_back(Enumerables::Range<int>(i * 1000, i * 37 % 500).ToList());
+		nested.emplace_back();
+
+		auto flat	  = Enumerate(nested).Flatten().ToList();
+		auto expanded = Enumerate(nested).Map(FUN(v, Enumerate(v).Map(FUN(x, 2 * x))));
+
+		// preserved order: same as Flatten, references preserved
+		ASSERT_EQ (flat, Enumerate(nested).FlattenParallel(4).ToList());
+		ASSERT_EQ (flat, Enumerate(nested).FlattenParallel(1, Enumerables::FlattenOrder::Preserved, &TestPool()).ToList());
+		ASSERT_EQ (&nested[1][0], Enumerate(nested).FlattenParallel(3).Addresses().First());
+		ASSERT_EQ (expanded.Flatten().ToList(), expanded.FlattenParallel(8, Enumerables::FlattenOrder::Preserved, &TestPool()).ToList());
+
+		// first-come: same elements, each nested sequence in order
+		{
+			auto firstCome = Enumerate(nested).FlattenParallel(6, Enumerables::FlattenOrder::FirstCome, &TestPool()).ToList();
+			ASSERT_EQ (flat.size(), firstCome.size());
+
+			std::vector<int> sorted = firstCome;
+			std::sort(sorted.begin(), sorted.end());
+			ASSERT_EQ (flat, sorted);
+			ASSERT (Enumerate(firstCome).Where(FUN(x, x / 1000 == 7)).MapNeighbors(FUN(a, b, a < b)).All(FUN(x, x)));
+		}
+
+		// executor without workers gets helped by the consumer
+		{
+			RecordingExecutor recorder;
+			ASSERT_EQ (flat, Enumerate(nested).FlattenParallel(4, Enumerables::FlattenOrder::Preserved, &recorder).ToList());
+			ASSERT	  (recorder.submitted >= nested.size());
+		}
+
+		// exceptions surface at the position of the failing sequence
+		{
+			auto throwing = Enumerables::Range<int>(0, 10).Map([](int i) {
+				return Enumerables::Range<int>(i * 10, 10).Map([i](int x) -> int {
+					if (i == 6 && x == 63)
+						throw std::runtime_error("element 63");
+					return x;
+				});
+			});
+			auto   et		= throwing.FlattenParallel(3, Enumerables::FlattenOrder::Preserved, &TestPool()).GetEnumerator();
+			int	   received = 0;
+			bool   thrown	= false;
+			try {
+				while (et.FetchNext()) {
+					ASSERT_EQ (received, et.Current());
+					++received;
+				}
+			}
+			catch (const std::runtime_error&) {
+				thrown = true;
+			}
+			ASSERT	  (thrown);
+			ASSERT_EQ (63, received);
+		}
+
+		// abandoned infinite sequences get cancelled
+		{
+			auto infinite = Enumerables::Range<int>(0, 3).Map([](int i) { return Enumerables::Sequence(std::move(i), FUN(x, x + 3)); });
+
+			ASSERT_EQ (5, infinite.FlattenParallel(3, Enumerables::FlattenOrder::FirstCome, &TestPool()).Take(5).Count());
+			ASSERT_EQ ((std::vector<int> { 0, 3, 6 }), infinite.FlattenParallel(2).Take(3).ToList());
+		}
+	}
+
+
+
+	template <class F>
+	static Enumerables::TypeHelpers::IsConcurrencySafe<F>	ConcurrencySafetyOf(const Enumerables::Def::AutoEnumerable<F>&);
+
+
+	static void SharedEnumeration()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+
+		auto query	  = Enumerate(vec).Where(FUN(x, x % 3 == 0)).Map(FUN(x, 2 * x)).Shareable();
+		auto expected = query.ToList();
+
+		// chains are composed of verified parts, type-erasure is not verifiable
+		Enumerables::Enumerable<int> interfaced = query;
+
+		auto naturals = Enumerables::Sequence(1, FUN(x, x + 1));
+		auto mixed	  = query.Concat(interfaced);
+		static_assert ( decltype(ConcurrencySafetyOf(query))::value,	  "");
+		static_assert ( decltype(ConcurrencySafetyOf(naturals))::value,	  "");
+		static_assert (!decltype(ConcurrencySafetyOf(interfaced))::value, "");
+		static_assert (!decltype(ConcurrencySafetyOf(mixed))::value,	  "");
+
+		// mutable callables are not safe to share
+		struct Counter {
+			int  n = 0;
+			bool operator ()(int) { return ++n % 2 == 0; }
+		};
+		auto counting = [n = 0](int) mutable { return ++n % 2 == 0; };
+		auto checking = [](int x) { return x % 2 == 0; };
+		static_assert (!Enumerables::TypeHelpers::IsConcurrencySafe<decltype(counting)>::value, "");
+		static_assert (!Enumerables::TypeHelpers::IsConcurrencySafe<Counter>::value,			  "");
+		static_assert ( Enumerables::TypeHelpers::IsConcurrencySafe<decltype(checking)>::value, "");
+		static_assert ( Enumerables::TypeHelpers::IsConcurrencySafe<bool (*)(int)>::value,	  "");
+
+		// the same object enumerated and chained from several threads - incl. its debug ResultsView
+		std::atomic<size_t>		 mismatches { 0 };
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t) {
+			threads.emplace_back([&]() {
+				for (int i = 0; i < 20; ++i) {
+					if (query.ToList() != expected)
+						++mismatches;
+
+					size_t n = 0;
+					for (int x : query)
+						n += (x % 6 == 0);
+					if (n != expected.size() || query.Skip(1).Count() != expected.size() - 1)
+						++mismatches;
+				}
+			});
+		}
+		for (std::thread& t : threads)
+			t.join();
+
+		ASSERT_EQ (0, mismatches.load());
+	}
+
+
+
+#if ENUMERABLES_USE_MULTIPROCESS
+
+	static void MultiProcessEvaluation()
+	{
+		std::vector<int> vec = Enumerables::Range<int>(0, LongLength).ToList();
+
+		auto query	  = Enumerate(vec).AsParallel().Where(FUN(x, x % 3 != 1)).Map(FUN(x, x * 0.5));
+		auto expected = Enumerate(vec).Where(FUN(x, x % 3 != 1)).Map(FUN(x, x * 0.5)).ToList();
+
+		for (size_t processes : { 0, 1, 3 }) {
+			auto results = query.ToSharedMemoryList(processes);
+			ASSERT_EQ (expected.size(), results.size());
+			ASSERT_EQ (expected,		Enumerate(results).ToList());
+		}
+		ASSERT_EQ (0, Enumerate(std::vector<int> {}).AsParallel().ToSharedMemoryList(4).size());
+		ASSERT_EQ (2, Enumerate(std::vector<int> { 1, 2 }).AsParallel().ToSharedMemoryList(8).size());
+
+		// expanding stages outgrow a slot per source element: all results are kept
+		auto tripled   = Enumerate(vec).AsParallel().Map(FUN(x, Enumerables::Range<int>(3 * x, 3))).Flatten();
+		auto skewed    = Enumerate(vec).AsParallel().Map(FUN(x, Enumerables::Range<int>(x, x < 100 ? 50 : x % 2))).Flatten();
+		auto expected3 = Enumerables::Range<int>(0, 3 * LongLength).ToList();
+		auto expectedS = Enumerate(vec).Map(FUN(x, Enumerables::Range<int>(x, x < 100 ? 50 : x % 2))).Flatten().ToList();
+		for (size_t processes : { 1, 3 }) {
+			ASSERT_EQ (expected3, Enumerate(tripled.ToSharedMemoryList(processes)).ToList());
+			ASSERT_EQ (expectedS, Enumerate(skewed.ToSharedMemoryList(processes)).ToList());
+		}
+
+		// failing or crashing workers are reported, the caller stays intact
+		auto throwing = Enumerate(vec).AsParallel().Map([](int x) -> int {
+			if (x == 12345)
+				throw std::runtime_error("element 12345");
+			return x;
+		});
+		auto crashing = Enumerate(vec).AsParallel().Map([](int x) -> int {
+			if (x == 777)
+				std::raise(SIGKILL);
+			return x;
+		});
+		ASSERT_THROW (Enumerables::LogicException, throwing.ToSharedMemoryList(3));
+		ASSERT_THROW (Enumerables::LogicException, crashing.ToSharedMemoryList(3));
+		ASSERT_EQ	 (LongLength, Enumerate(vec).AsParallel().ToSharedMemoryList(3).size());
+	}
+
+#endif
+
+
+
+	void TestParallel()
+	{
+		Greet("Parallel");
+
+		ParallelSources();
+		ParallelPipelines();
+		ParallelTerminals();
+		ParallelAggregates();
+		ParallelScan();
+		ParallelExceptions();
+		ParallelExecutors();
+		BufferedStage();
+		FlattenParallelStage();
+		SharedEnumeration();
+#	if ENUMERABLES_USE_MULTIPROCESS
+		MultiProcessEvaluation();
+#	endif
+	}
+
+}	// namespace EnumerableTests
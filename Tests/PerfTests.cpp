@@ -2,6 +2,7 @@
 #include "Tests.hpp"
 #include "TestUtils.hpp"
 #include "Enumerables.hpp"
+#include "Enumerables_HugePages.hpp"
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
@@ -21,9 +22,11 @@ namespace EnumerableTests {
 #ifdef _DEBUG
 	constexpr char	   GreetTxt[]    = "Performance [Debug]";
 	constexpr unsigned DefaultCycles = 10;
+	constexpr size_t   HugeSortSize  = size_t(1) << 20;
 #else
 	constexpr char	   GreetTxt[]    = "Performance [Release]";
 	constexpr unsigned DefaultCycles = 2000;
+	constexpr size_t   HugeSortSize  = size_t(1) << 25;		// 128 MB of ints
 #endif
 
 
@@ -360,7 +363,8 @@ namespace EnumerableTests {
 
 		static auto CreateQuery(const std::vector<N>& in)
 		{
-			return Enumerate(in).MapNeighbors(FUN(p,n,  n - p));
+			// declared elementwise: block kernel instead of per-element calls
+			return Enumerate(in).MapNeighbors(Enumerables::Elementwise(FUN(p,n,  n - p)));
 		}
 	};
 
@@ -1333,6 +1337,65 @@ namespace EnumerableTests {
 	}
 
 
+	// Sorts of caches far beyond TLB reach: 4 kB pages vs 2 MB huge pages
+	static void RunHugePageSorts(size_t elements, unsigned tries = 3)
+	{
+		using namespace std::chrono;
+		using Enumerables::HugePageAllocator;
+
+		std::cout << "    Complexity: " << std::setw(10) << std::left << elements
+				  << " Cache: " << elements * sizeof(int) / (1 << 20) << " MB" << std::endl;
+
+		TableWriter<4> tb { std::cout, 5, 35, 18, 20 };
+
+		std::cout << std::right;
+		tb.PutRow("", "std::allocator", "HugePageAllocator");
+
+		std::srand(56);
+		const std::vector<int> input = ScalarTestBase<int>::GenerateInput(elements);
+		volatile int		   sink  = 0;
+
+		auto sortCopy = [&](auto alloc) {
+			return [&, alloc]() {
+				const auto startTime = high_resolution_clock::now();
+
+				std::vector<int, decltype(alloc)> res (input.begin(), input.end(), alloc);
+				std::sort(res.begin(), res.end());
+				sink = res[res.size() / 2];
+
+				return PerfResult { duration_cast<Microseconds>(high_resolution_clock::now() - startTime) };
+			};
+		};
+
+		// the cache of Order() is allocated by the bound ListOperations
+		auto orderedList = [&]() {
+			const auto startTime = high_resolution_clock::now();
+
+			auto res = Enumerate<int>(input).Order().ToList();
+			sink = res[res.size() / 2];
+
+			return PerfResult { duration_cast<Microseconds>(high_resolution_clock::now() - startTime) };
+		};
+
+		std::cout << std::left;
+		tb.PutCell("Sorted copy of ints");
+		std::cout << std::right;
+		MeasureBest(tries, tb, sortCopy(std::allocator<int> {}));
+		MeasureBest(tries, tb, sortCopy(HugePageAllocator<int> {}));
+
+		std::cout << std::left;
+		tb.PutCell("Order().ToList() [bound list]");
+		std::cout << std::right;
+#if ENUMERABLES_USE_HUGEPAGES
+		tb.PutCell('-');
+		MeasureBest(tries, tb, orderedList);
+#else
+		MeasureBest(tries, tb, orderedList);
+		tb.PutCell('-');
+#endif
+	}
+
+
 	void NewPerfTests(const CmdOption& summarizeTimes,
 					  const CmdOption& summarizeOverheads)
 	{
@@ -1351,6 +1414,10 @@ namespace EnumerableTests {
 		auto results2 = RunAllWith(10, DefaultComplexity / 50 * DefaultCycles);
 		std::cout << std::endl;
 
+		SectionBreak("  Huge caches...", 90);
+		RunHugePageSorts(HugeSortSize);
+		std::cout << std::endl;
+
 		SectionBreak("  Long sequences summary:", printTimes || printOvrhd ? 104 : 90, '=');
 		SummarizeOnScreen(printTimes, printOvrhd, results1);
 		std::cout << std::endl;
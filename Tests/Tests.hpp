@@ -37,5 +37,7 @@ namespace EnumerableTests {
 	void TestArithmetics();
 	void TestMisc();
 	void TestCollectionCustomizability();
+	void TestParallel();
+	void TestVectorized();
 
 }
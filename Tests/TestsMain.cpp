@@ -27,6 +27,8 @@ namespace EnumerableTests {
 		TestArithmetics();
 		TestMisc();
 		TestCollectionCustomizability();
+		TestParallel();
+		TestVectorized();
 
 		if (!quick) {
 			NewPerfTests(summarizeTimes, summarizeOverheads);
@@ -0,0 +1,144 @@
+
+#include "Tests.hpp"
+#include "TestUtils.hpp"
+#include "Enumerables.hpp"
+#include <cmath>
+#include <list>
+#include <string>
+
+
+
+namespace EnumerableTests {
+
+	// spans several blocks, with a partial one at the end
+	static const size_t VectorizedLength = 2500;
+
+
+	struct Measurement {
+		int		sensor;
+		double	value;
+		bool	valid;
+	};
+
+
+	static std::vector<Measurement> Measurements()
+	{
+		std::vector<Measurement> results;
+		for (size_t i = 0; i < VectorizedLength; ++i)
+			results.push_back({ static_cast<int>(i % 7), std::sin(static_cast<double>(i)), i % 5 != 0 });
+
+		return results;
+	}
+
+
+
+	static void VectorizedPipelines()
+	{
+		const std::vector<Measurement> data = Measurements();
+
+		auto seqQuery = Enumerate(data).Where(FUN(m, m.valid && m.sensor < 4)).Select(&Measurement::value);
+		auto vecQuery = Enumerate(data).Vectorized().Where(FUN(m, m.valid && m.sensor < 4)).Select(&Measurement::value);
+
+		ASSERT_EQ (seqQuery.Count(),	vecQuery.Count());
+		ASSERT_EQ (seqQuery.ToList(),	vecQuery.ToList());
+		ASSERT_EQ (seqQuery.Min().Value(), vecQuery.Min().Value());
+		ASSERT_EQ (seqQuery.Max().Value(), vecQuery.Max().Value());
+		ASSERT	  (std::abs(seqQuery.Sum() - vecQuery.Sum()) < 1e-9);
+		ASSERT	  (std::abs(seqQuery.Avg().Value() - vecQuery.Avg().Value()) < 1e-12);
+		ASSERT	  (vecQuery.Any());
+
+		// rows of contiguous sources are referenced in place
+		ASSERT_TYPE (const double&, vecQuery.AsSequential().First());
+		auto addresses = vecQuery.AsSequential().Addresses().ToList();
+		ASSERT_EQ (seqQuery.Addresses().ToList(), addresses);
+
+		// chained filters, then computed values filtered again
+		auto chained = Enumerate(data).Vectorized()
+									  .Where(FUN(m, m.valid))
+									  .Where(FUN(m, m.sensor % 2 == 0))
+									  .Select(FUN(m, m.sensor * 10 + (m.value > 0 ? 1 : 0)))
+									  .Where(FUN(x, x % 10 == 1));
+
+		auto expected = Enumerate(data).Where(FUN(m, m.valid && m.sensor % 2 == 0))
+									   .Select(FUN(m, m.sensor * 10 + (m.value > 0 ? 1 : 0)))
+									   .Where(FUN(x, x % 10 == 1));
+
+		ASSERT_TYPE (int, chained.AsSequential().First());
+		ASSERT_EQ	(expected.ToList(), chained.ToList());
+		ASSERT_EQ	(expected.Sum(),	chained.Sum());
+		ASSERT_EQ	(expected.ToList(), chained.AsSequential().ToList());
+
+		// usable as a source of further sequential operations
+		ASSERT_EQ (expected.Skip(3).Take(5).ToList(), chained.AsSequential().Skip(3).Take(5).ToList());
+	}
+
+
+
+	static void VectorizedSimplePredicates()
+	{
+		using namespace Enumerables::Predicates;
+
+		const std::vector<Measurement> data = Measurements();
+
+		std::vector<int> ints;
+		for (size_t i = 0; i < VectorizedLength; ++i)
+			ints.push_back(static_cast<int>(i % 97) - 40);
+
+		ASSERT_EQ (Enumerate(ints).Where(FUN(x, x > 0)).ToList(),			 Enumerate(ints).Vectorized().Where(Greater(0)).ToList());
+		ASSERT_EQ (Enumerate(ints).Where(FUN(x, x < -3 || x == 7)).Sum(),	 Enumerate(ints).Vectorized().Where(Less(-3) || Equal(7)).Sum());
+
+		// by data member, then filtered again by the selection
+		auto seqQuery = Enumerate(data).Where(FUN(m, m.sensor >= 2 && m.value > 0.5)).Where(FUN(m, m.valid));
+		auto vecQuery = Enumerate(data).Vectorized().Where(GreaterEqual(&Measurement::sensor, 2) && Greater(&Measurement::value, 0.5))
+													.Where(FUN(m, m.valid));
+
+		ASSERT_EQ (seqQuery.Count(), vecQuery.Count());
+		ASSERT_EQ (seqQuery.Select(&Measurement::sensor).ToList(), vecQuery.Select(&Measurement::sensor).ToList());
+
+		// mask paths on selected rows fall back to per-row evaluation
+		ASSERT_EQ (seqQuery.Select(&Measurement::sensor).Where(FUN(s, s == 3)).Count(),
+				   vecQuery.Select(&Measurement::sensor).Where(Equal(3)).Count());
+	}
+
+
+
+	static void VectorizedSources()
+	{
+		// enumerated into blocks
+		std::list<int> list;
+		for (int i = 0; i < static_cast<int>(VectorizedLength); ++i)
+			list.push_back(i);
+
+		auto fromList = Enumerate(list).Vectorized().Where(FUN(x, x % 3 == 0));
+		ASSERT_EQ (Enumerate(list).Where(FUN(x, x % 3 == 0)).ToList(), fromList.ToList());
+		ASSERT_EQ (Enumerate(list).Where(FUN(x, x % 3 == 0)).Sum(),	fromList.Sum());
+		ASSERT_TYPE (int, fromList.AsSequential().First());
+
+		// computed sources, non-trivial values
+		auto strings = Enumerables::Range<int>(0, 100).Vectorized().Select(FUN(i, std::to_string(i))).Where(FUN(s, s.size() == 1));
+		ASSERT_EQ (10, strings.Count());
+		ASSERT_EQ ("9", strings.ToList().back());
+
+		// empty ones
+		std::vector<Measurement> empty;
+		ASSERT_EQ (0u,  Enumerate(empty).Vectorized().Count());
+		ASSERT_EQ (0.0, Enumerate(empty).Vectorized().Select(&Measurement::value).Sum());
+		ASSERT	  (!Enumerate(empty).Vectorized().Any());
+		ASSERT	  (!Enumerate(empty).Vectorized().Select(&Measurement::value).Avg().HasValue());
+		ASSERT	  (!Enumerate(empty).Vectorized().Select(&Measurement::value).Min().HasValue());
+		ASSERT	  (Enumerate(list).Vectorized().Where(FUN(x, x < 0)).ToList().empty());
+		ASSERT	  (!Enumerate(list).Vectorized().Where(FUN(x, x < 0)).AsSequential().Any());
+	}
+
+
+
+	void TestVectorized()
+	{
+		Greet("Vectorized");
+
+		VectorizedPipelines();
+		VectorizedSimplePredicates();
+		VectorizedSources();
+	}
+
+}	// namespace EnumerableTests